@@ -0,0 +1,69 @@
+#include "BootProfiler.h"
+
+#include <Arduino.h>
+
+/**
+ * Open a phase slot stamped with the current boot-relative time.
+ */
+int8_t BootProfiler::start(const char* name) {
+  if (phaseCount_ >= kMaxPhases) {
+    return -1;
+  }
+  Phase& phase = phases_[phaseCount_];
+  phase.name = name;
+  phase.startMs = millis();
+  phase.endMs = 0;
+  return static_cast<int8_t>(phaseCount_++);
+}
+
+/**
+ * Close a phase slot; invalid slots are ignored.
+ */
+void BootProfiler::finish(int8_t slot) {
+  if (slot < 0 || slot >= static_cast<int8_t>(phaseCount_)) {
+    return;
+  }
+  phases_[slot].endMs = millis();
+}
+
+/**
+ * Stamp first frame time once.
+ */
+void BootProfiler::markFirstFrame() {
+  if (firstFrameMs_ == 0) {
+    firstFrameMs_ = millis();
+  }
+}
+
+/**
+ * Return boot-to-first-frame time in milliseconds.
+ */
+uint32_t BootProfiler::bootToFirstFrameMs() const {
+  return firstFrameMs_;
+}
+
+/**
+ * Print a compact phase table; unfinished phases are flagged as open.
+ */
+void BootProfiler::report() const {
+  Serial.println("[BOOT] ---- Boot Profile ----");
+  for (uint8_t i = 0; i < phaseCount_; ++i) {
+    const Phase& phase = phases_[i];
+    Serial.print("[BOOT] ");
+    Serial.print(phase.name);
+    Serial.print(": start=");
+    Serial.print(phase.startMs);
+    Serial.print("ms");
+    if (phase.endMs == 0) {
+      Serial.println(" (open)");
+      continue;
+    }
+    Serial.print(" dur=");
+    Serial.print(phase.endMs - phase.startMs);
+    Serial.println("ms");
+  }
+  Serial.print("[BOOT] Boot to first frame: ");
+  Serial.print(firstFrameMs_);
+  Serial.println("ms");
+  Serial.println("[BOOT] ----------------------");
+}
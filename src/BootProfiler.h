@@ -0,0 +1,53 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Records named boot phases (which may overlap) and prints their durations.
+ *
+ * Times are millis() since power-on, so the first frame mark is the
+ * boot-to-first-frame metric.
+ */
+class BootProfiler {
+ public:
+  /**
+   * @brief Open a named phase at the current time.
+   * @param name Static phase label (pointer is stored, not copied).
+   * @return Phase slot to pass to finish(), or -1 if the table is full.
+   */
+  int8_t start(const char* name);
+
+  /**
+   * @brief Close a phase previously opened with start().
+   * @param slot Slot returned by start().
+   */
+  void finish(int8_t slot);
+
+  /**
+   * @brief Record the moment the first full weather/clock frame was drawn.
+   */
+  void markFirstFrame();
+
+  /**
+   * @brief Milliseconds from power-on to the first frame (0 if not reached yet).
+   */
+  uint32_t bootToFirstFrameMs() const;
+
+  /**
+   * @brief Print per-phase start offsets and durations to serial.
+   */
+  void report() const;
+
+ private:
+  static constexpr uint8_t kMaxPhases = 12;
+
+  struct Phase {
+    const char* name;
+    uint32_t startMs;
+    uint32_t endMs;
+  };
+
+  Phase phases_[kMaxPhases] = {};
+  uint8_t phaseCount_ = 0;
+  uint32_t firstFrameMs_ = 0;
+};
@@ -0,0 +1,192 @@
+#include "ButtonService.h"
+
+ButtonService* ButtonService::instance_ = nullptr;
+
+/**
+ * Bind the service to an active-low button pin.
+ */
+ButtonService::ButtonService(uint8_t pin) : pin_(pin) {}
+
+/**
+ * Configure pull-up input and attach the CHANGE interrupt.
+ */
+void ButtonService::begin() {
+  pinMode(pin_, INPUT_PULLUP);
+  stableLevel_ = static_cast<uint8_t>(digitalRead(pin_));
+  lastAcceptedUs_ = micros();
+  instance_ = this;
+  attachInterrupt(digitalPinToInterrupt(pin_), onEdgeIsr, CHANGE);
+}
+
+/**
+ * Push one timestamped edge into the ring; drop it if the consumer is behind.
+ */
+void IRAM_ATTR ButtonService::onEdgeIsr() {
+  ButtonService* self = instance_;
+  if (self == nullptr) {
+    return;
+  }
+
+  const uint8_t head = self->head_;
+  const uint8_t next = static_cast<uint8_t>((head + 1) & (kRingSize - 1));
+  if (next == self->tail_) {
+    self->droppedEdges_ = self->droppedEdges_ + 1;
+    return;
+  }
+  self->ring_[head].us = micros();
+  self->ring_[head].level = static_cast<uint8_t>(digitalRead(self->pin_));
+  // Publish the slot only after it is fully written.
+  self->head_ = next;
+}
+
+/**
+ * Debounce one edge and advance the click/double-click/long-press state machine.
+ */
+bool ButtonService::decodeEdge(uint32_t us, uint8_t level, ButtonEvent& event) {
+  if (level == stableLevel_ || us - lastAcceptedUs_ < kDebounceUs) {
+    // Duplicate level or contact bounce inside the debounce window.
+    return false;
+  }
+  stableLevel_ = level;
+  lastAcceptedUs_ = us;
+
+  if (level == LOW) {
+    pressStartUs_ = us;
+    longPressFired_ = false;
+    return false;
+  }
+
+  // Release: a hold that crossed the threshold is a long press, not a click.
+  if (longPressFired_) {
+    return false;
+  }
+  if (us - pressStartUs_ >= kLongPressUs) {
+    longPressFired_ = true;
+    event.gesture = ButtonGesture::LongPress;
+    event.edgeUs = us;
+    return true;
+  }
+
+  // A second release inside the window is a double click. A first release is held
+  // back until the window passes so a double click never also advances a page.
+  if (clickPending_ && us - lastClickUs_ <= kDoubleClickUs) {
+    clickPending_ = false;
+    event.gesture = ButtonGesture::DoubleClick;
+    event.edgeUs = us;
+    return true;
+  }
+  clickPending_ = true;
+  lastClickUs_ = us;
+  return false;
+}
+
+/**
+ * Emit the held click once nothing followed it within the double-click window.
+ */
+bool ButtonService::releaseExpiredClick(uint32_t us, ButtonEvent& event) {
+  if (!clickPending_ || us - lastClickUs_ <= kDoubleClickUs) {
+    return false;
+  }
+  clickPending_ = false;
+  event.gesture = ButtonGesture::Click;
+  event.edgeUs = lastClickUs_;
+  return true;
+}
+
+/**
+ * Drain queued edges until one gesture is decoded, then check hold timing.
+ */
+bool ButtonService::poll(ButtonEvent& event) {
+  event.gesture = ButtonGesture::None;
+  event.edgeUs = 0;
+
+  while (tail_ != head_) {
+    const uint8_t tail = tail_;
+    const uint32_t us = ring_[tail].us;
+    const uint8_t level = ring_[tail].level;
+    // A late queued edge can show the previous click already stood alone; emit it first
+    // and leave this edge queued for the next call.
+    if (releaseExpiredClick(us, event)) {
+      return true;
+    }
+    tail_ = static_cast<uint8_t>((tail + 1) & (kRingSize - 1));
+    if (decodeEdge(us, level, event)) {
+      return true;
+    }
+  }
+
+  const uint32_t nowUs = micros();
+  // Recover if the settling edge of a bounce burst was filtered out.
+  const uint8_t rawLevel = static_cast<uint8_t>(digitalRead(pin_));
+  if (rawLevel != stableLevel_ && nowUs - lastAcceptedUs_ >= kDebounceUs) {
+    if (decodeEdge(nowUs, rawLevel, event)) {
+      return true;
+    }
+  }
+
+  if (releaseExpiredClick(nowUs, event)) {
+    return true;
+  }
+
+  // Long press fires while still held so the user gets feedback without releasing.
+  if (stableLevel_ == LOW && !longPressFired_ && nowUs - pressStartUs_ >= kLongPressUs) {
+    longPressFired_ = true;
+    clickPending_ = false;
+    event.gesture = ButtonGesture::LongPress;
+    event.edgeUs = pressStartUs_ + kLongPressUs;
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Update edge-to-frame latency stats after the gesture's frame is on screen.
+ */
+void ButtonService::recordFrameLatency(uint32_t edgeUs) {
+  const uint32_t latencyUs = micros() - edgeUs;
+  lastLatencyUs_ = latencyUs;
+  if (latencySamples_ == 0 || latencyUs < minLatencyUs_) {
+    minLatencyUs_ = latencyUs;
+  }
+  if (latencyUs > maxLatencyUs_) {
+    maxLatencyUs_ = latencyUs;
+  }
+  ++latencySamples_;
+
+  Serial.print("[UI] Button->frame latency us=");
+  Serial.print(latencyUs);
+  Serial.print(" min=");
+  Serial.print(minLatencyUs_);
+  Serial.print(" max=");
+  Serial.print(maxLatencyUs_);
+  Serial.print(" dropped=");
+  Serial.println(droppedEdges());
+}
+
+/**
+ * Return last edge-to-frame latency.
+ */
+uint32_t ButtonService::lastLatencyUs() const {
+  return lastLatencyUs_;
+}
+
+/**
+ * Return smallest edge-to-frame latency.
+ */
+uint32_t ButtonService::minLatencyUs() const {
+  return minLatencyUs_;
+}
+
+/**
+ * Return largest edge-to-frame latency.
+ */
+uint32_t ButtonService::maxLatencyUs() const {
+  return maxLatencyUs_;
+}
+
+/**
+ * Return number of edges lost to ring overflow.
+ */
+uint32_t ButtonService::droppedEdges() const {
+  return droppedEdges_;
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @brief Gestures decoded from raw button edges.
+ */
+enum class ButtonGesture : uint8_t {
+  None,
+  Click,
+  DoubleClick,
+  LongPress
+};
+
+/**
+ * @brief One decoded gesture plus the edge time that completed it.
+ */
+struct ButtonEvent {
+  /** @brief Decoded gesture type. */
+  ButtonGesture gesture;
+  /** @brief micros() timestamp of the edge (or hold deadline) that produced the gesture. */
+  uint32_t edgeUs;
+};
+
+/**
+ * @brief Interrupt-driven button input with gesture decoding and latency stats.
+ *
+ * A GPIO edge interrupt timestamps every level change into a lock-free
+ * single-producer/single-consumer ring, so presses during blocking work
+ * (sync, boot screens) are kept and decoded later from their real timestamps.
+ */
+class ButtonService {
+ public:
+  /**
+   * @brief Construct a button service for an active-low pin with pull-up.
+   * @param pin GPIO number of the button.
+   */
+  explicit ButtonService(uint8_t pin);
+
+  /**
+   * @brief Configure the pin and attach the edge interrupt.
+   */
+  void begin();
+
+  /**
+   * @brief Decode queued edges into the next gesture, if any.
+   * @param event Output gesture when available.
+   * @return True if a gesture was produced; call again until false.
+   */
+  bool poll(ButtonEvent& event);
+
+  /**
+   * @brief Record that a frame reflecting a gesture has been flushed to the OLED.
+   * @param edgeUs Edge timestamp from the consumed ButtonEvent.
+   */
+  void recordFrameLatency(uint32_t edgeUs);
+
+  /**
+   * @brief Last measured edge-to-frame latency in microseconds.
+   */
+  uint32_t lastLatencyUs() const;
+
+  /**
+   * @brief Smallest measured edge-to-frame latency in microseconds.
+   */
+  uint32_t minLatencyUs() const;
+
+  /**
+   * @brief Largest measured edge-to-frame latency in microseconds.
+   */
+  uint32_t maxLatencyUs() const;
+
+  /**
+   * @brief Number of edges dropped because the ring was full.
+   */
+  uint32_t droppedEdges() const;
+
+ private:
+  static constexpr uint8_t kRingSize = 32;  // Power of two for cheap index wrap.
+  static constexpr uint32_t kDebounceUs = 35000;
+  static constexpr uint32_t kDoubleClickUs = 350000;
+  static constexpr uint32_t kLongPressUs = 800000;
+
+  struct Edge {
+    uint32_t us;
+    uint8_t level;
+  };
+
+  /**
+   * @brief GPIO CHANGE interrupt handler; pushes one timestamped edge.
+   */
+  static void IRAM_ATTR onEdgeIsr();
+
+  /**
+   * @brief Apply one edge to the decoder state machine.
+   * @return True if the edge completed a gesture.
+   */
+  bool decodeEdge(uint32_t us, uint8_t level, ButtonEvent& event);
+
+  /**
+   * @brief Turn a held click into a Click event once the double-click window has passed.
+   * @param us Time of the next edge, or now when the ring is empty.
+   * @return True if the click was emitted.
+   */
+  bool releaseExpiredClick(uint32_t us, ButtonEvent& event);
+
+  static ButtonService* instance_;
+
+  const uint8_t pin_;
+  volatile Edge ring_[kRingSize];
+  volatile uint8_t head_ = 0;
+  volatile uint8_t tail_ = 0;
+  volatile uint32_t droppedEdges_ = 0;
+
+  uint8_t stableLevel_ = HIGH;
+  uint32_t lastAcceptedUs_ = 0;
+  uint32_t pressStartUs_ = 0;
+  bool longPressFired_ = false;
+  bool clickPending_ = false;
+  uint32_t lastClickUs_ = 0;
+
+  uint32_t lastLatencyUs_ = 0;
+  uint32_t minLatencyUs_ = 0;
+  uint32_t maxLatencyUs_ = 0;
+  uint32_t latencySamples_ = 0;
+};
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Proleptic Gregorian calendar date.
+ */
+struct CivilDate {
+  /** @brief Full year (e.g. 2025). */
+  int32_t year;
+  /** @brief Month (1-12). */
+  uint8_t month;
+  /** @brief Day of month (1-31). */
+  uint8_t day;
+};
+
+/**
+ * @brief Local epoch split into a day number and time of day.
+ */
+struct CivilTime {
+  /** @brief Days since 1970-01-01. */
+  int32_t days;
+  /** @brief Hour (0-23). */
+  uint8_t hour;
+  /** @brief Minute (0-59). */
+  uint8_t minute;
+  /** @brief Second (0-59). */
+  uint8_t second;
+};
+
+// Single-expression helpers keep these constexpr under C++11.
+namespace civil_detail {
+constexpr int32_t shiftedYear(int32_t year, uint8_t month) {
+  return year - (month <= 2 ? 1 : 0);
+}
+constexpr int32_t eraOfYear(int32_t y) {
+  return (y >= 0 ? y : y - 399) / 400;
+}
+constexpr uint32_t dayOfShiftedYear(uint8_t month, uint8_t day) {
+  return (153U * (month > 2 ? month - 3U : month + 9U) + 2U) / 5U + day - 1U;
+}
+constexpr uint32_t dayOfEra(uint32_t yoe, uint32_t doy) {
+  return yoe * 365U + yoe / 4U - yoe / 100U + doy;
+}
+constexpr int32_t eraOfDays(int32_t z) {
+  return (z >= 0 ? z : z - 146096) / 146097;
+}
+constexpr uint32_t yearOfEra(uint32_t doe) {
+  return (doe - doe / 1460U + doe / 36524U - doe / 146096U) / 365U;
+}
+constexpr uint32_t monthIndex(uint32_t doy) {
+  return (5U * doy + 2U) / 153U;
+}
+constexpr uint8_t civilMonth(uint32_t mp) {
+  return static_cast<uint8_t>(mp < 10U ? mp + 3U : mp - 9U);
+}
+constexpr CivilDate dateFromParts(int32_t era, uint32_t yoe, uint32_t doy, uint32_t mp) {
+  return CivilDate{static_cast<int32_t>(yoe) + era * 400 + (civilMonth(mp) <= 2 ? 1 : 0), civilMonth(mp),
+                   static_cast<uint8_t>(doy - (153U * mp + 2U) / 5U + 1U)};
+}
+constexpr CivilDate dateFromEra(int32_t era, uint32_t doe, uint32_t yoe) {
+  return dateFromParts(era, yoe, doe - (365U * yoe + yoe / 4U - yoe / 100U),
+                       monthIndex(doe - (365U * yoe + yoe / 4U - yoe / 100U)));
+}
+constexpr CivilDate dateFromShiftedDays(int32_t z, int32_t era) {
+  return dateFromEra(era, static_cast<uint32_t>(z - era * 146097),
+                     yearOfEra(static_cast<uint32_t>(z - era * 146097)));
+}
+constexpr int64_t floorDays(int64_t localEpoch) {
+  return (localEpoch >= 0 ? localEpoch : localEpoch - 86399) / 86400;
+}
+constexpr CivilTime timeFromParts(int64_t days, uint32_t secondOfDay) {
+  return CivilTime{static_cast<int32_t>(days), static_cast<uint8_t>(secondOfDay / 3600U),
+                   static_cast<uint8_t>((secondOfDay / 60U) % 60U), static_cast<uint8_t>(secondOfDay % 60U)};
+}
+}  // namespace civil_detail
+
+/**
+ * @brief Days since 1970-01-01 for a civil date (Howard Hinnant's era-based algorithm).
+ * @param year Full year.
+ * @param month Month (1-12).
+ * @param day Day of month (1-31).
+ */
+constexpr int32_t daysFromCivil(int32_t year, uint8_t month, uint8_t day) {
+  return civil_detail::eraOfYear(civil_detail::shiftedYear(year, month)) * 146097 +
+         static_cast<int32_t>(civil_detail::dayOfEra(
+             static_cast<uint32_t>(civil_detail::shiftedYear(year, month) -
+                                   civil_detail::eraOfYear(civil_detail::shiftedYear(year, month)) * 400),
+             civil_detail::dayOfShiftedYear(month, day))) -
+         719468;
+}
+
+/**
+ * @brief Civil date for a day number (inverse of daysFromCivil).
+ * @param days Days since 1970-01-01.
+ */
+constexpr CivilDate civilFromDays(int32_t days) {
+  return civil_detail::dateFromShiftedDays(days + 719468, civil_detail::eraOfDays(days + 719468));
+}
+
+/**
+ * @brief Day of week for a day number, 0 = Sunday (1970-01-01 was a Thursday).
+ */
+constexpr uint8_t weekdayFromDays(int32_t days) {
+  return static_cast<uint8_t>((days % 7 + 11) % 7);
+}
+
+/**
+ * @brief True for Gregorian leap years.
+ */
+constexpr bool isLeapYear(int32_t year) {
+  return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+/**
+ * @brief Zero-based day of year for a day number (0 = January 1).
+ */
+constexpr uint16_t dayOfYearFromDays(int32_t days) {
+  return static_cast<uint16_t>(days - daysFromCivil(civilFromDays(days).year, 1, 1));
+}
+
+/**
+ * @brief Split a local epoch (UTC epoch plus offset) into day number and time of day.
+ * @param localEpoch Seconds since 1970-01-01 in local time; may be negative.
+ */
+constexpr CivilTime civilTimeFromEpoch(int64_t localEpoch) {
+  return civil_detail::timeFromParts(civil_detail::floorDays(localEpoch),
+                                     static_cast<uint32_t>(localEpoch - civil_detail::floorDays(localEpoch) * 86400));
+}
+
+// Compile-time checks against known dates.
+static_assert(daysFromCivil(1970, 1, 1) == 0, "epoch day");
+static_assert(daysFromCivil(2000, 3, 1) == 11017, "leap century");
+static_assert(civilFromDays(19782).year == 2024 && civilFromDays(19782).month == 2 && civilFromDays(19782).day == 29,
+              "leap day");
+static_assert(weekdayFromDays(0) == 4 && weekdayFromDays(-1) == 3 && weekdayFromDays(20089) == 3, "weekday");
+static_assert(dayOfYearFromDays(daysFromCivil(2024, 12, 31)) == 365, "leap year length");
+static_assert(civilTimeFromEpoch(-1).days == -1 && civilTimeFromEpoch(-1).hour == 23, "negative epoch");
@@ -0,0 +1,14 @@
+#include "Crc32.h"
+
+// Bitwise CRC-32; records are a few hundred bytes so a 1 KB table is not worth the RAM.
+uint32_t crc32Update(uint32_t crc, const void* data, size_t length) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  crc = ~crc;
+  for (size_t i = 0; i < length; ++i) {
+    crc ^= bytes[i];
+    for (uint8_t bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xEDB88320UL & (0U - (crc & 1U)));
+    }
+  }
+  return ~crc;
+}
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Continue a CRC-32 (IEEE 802.3, reflected) over another block of bytes.
+ * @param crc Running CRC; pass 0 for the first block.
+ * @param data Bytes to add.
+ * @param length Number of bytes.
+ * @return Updated CRC.
+ */
+uint32_t crc32Update(uint32_t crc, const void* data, size_t length);
@@ -0,0 +1,278 @@
+#include "DeferredLog.h"
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <string.h>
+
+uint8_t DeferredLog::ring_[DeferredLog::kRingBytes];
+uint32_t DeferredLog::head_ = 0;
+uint32_t DeferredLog::tail_ = 0;
+uint32_t DeferredLog::serialPos_ = 0;
+uint32_t DeferredLog::recordsWritten_ = 0;
+uint32_t DeferredLog::recordsOverwritten_ = 0;
+uint32_t DeferredLog::unreportedOverwrites_ = 0;
+uint32_t DeferredLog::writeCycles_ = 0;
+
+namespace {
+#define WEATHERCLOCK_LOG_FORMAT(id, format) const char kFormat##id[] PROGMEM = format;
+WEATHERCLOCK_LOG_MESSAGES(WEATHERCLOCK_LOG_FORMAT)
+#undef WEATHERCLOCK_LOG_FORMAT
+
+const char* const kFormats[] PROGMEM = {
+#define WEATHERCLOCK_LOG_FORMAT_PTR(id, format) kFormat##id,
+    WEATHERCLOCK_LOG_MESSAGES(WEATHERCLOCK_LOG_FORMAT_PTR)
+#undef WEATHERCLOCK_LOG_FORMAT_PTR
+};
+static_assert(sizeof(kFormats) / sizeof(kFormats[0]) == static_cast<size_t>(LogId::Count), "format table size");
+
+constexpr char kArgSigned = 'i';
+constexpr char kArgUnsigned = 'u';
+constexpr char kArgString = 's';
+constexpr uint8_t kDumpVersion = 1;
+constexpr size_t kLineSize = 160;
+// Wait for this much UART room before printing; longer lines may block briefly.
+constexpr int kMinSerialRoom = 64;
+
+uint32_t readU32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) | (static_cast<uint32_t>(p[2]) << 16) |
+         (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void writeU32(uint8_t* p, uint32_t value) {
+  p[0] = static_cast<uint8_t>(value);
+  p[1] = static_cast<uint8_t>(value >> 8);
+  p[2] = static_cast<uint8_t>(value >> 16);
+  p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+/**
+ * Append text, keeping out NUL-terminated and never past outSize.
+ */
+void appendText(char* out, size_t outSize, size_t& used, const char* text) {
+  while (*text != '\0' && used + 1 < outSize) {
+    out[used++] = *text++;
+  }
+  out[used] = '\0';
+}
+}  // namespace
+
+/**
+ * Read the free-running CPU cycle counter.
+ */
+uint32_t DeferredLog::cycleCount() {
+  return ESP.getCycleCount();
+}
+
+/**
+ * Stamp the fixed header; length is filled in by commit().
+ */
+void DeferredLog::beginRecord(Record& record, LogLevel level, LogId id) {
+  const uint16_t rawId = static_cast<uint16_t>(id);
+  record.bytes[1] = static_cast<uint8_t>(level);
+  record.bytes[2] = static_cast<uint8_t>(rawId);
+  record.bytes[3] = static_cast<uint8_t>(rawId >> 8);
+  writeU32(record.bytes + 4, millis());
+  record.length = kHeaderBytes;
+}
+
+/**
+ * Append a tagged 32-bit value; arguments that do not fit are dropped.
+ */
+void DeferredLog::appendInt(Record& record, bool isSigned, uint32_t bits) {
+  if (record.length + 5 > kMaxRecordBytes) {
+    return;
+  }
+  record.bytes[record.length] = static_cast<uint8_t>(isSigned ? kArgSigned : kArgUnsigned);
+  writeU32(record.bytes + record.length + 1, bits);
+  record.length = static_cast<uint8_t>(record.length + 5);
+}
+
+/**
+ * Append a tagged, length-prefixed copy of a string, truncated to fit.
+ */
+void DeferredLog::appendString(Record& record, const char* text) {
+  if (record.length + 2 > kMaxRecordBytes) {
+    return;
+  }
+  if (text == nullptr) {
+    text = "(null)";
+  }
+  size_t length = strlen(text);
+  const size_t room = kMaxRecordBytes - record.length - 2;
+  if (length > kMaxStringArg) {
+    length = kMaxStringArg;
+  }
+  if (length > room) {
+    length = room;
+  }
+  record.bytes[record.length] = static_cast<uint8_t>(kArgString);
+  record.bytes[record.length + 1] = static_cast<uint8_t>(length);
+  memcpy(record.bytes + record.length + 2, text, length);
+  record.length = static_cast<uint8_t>(record.length + 2 + length);
+}
+
+/**
+ * Copy a finished record into the ring, evicting the oldest records as needed.
+ */
+void DeferredLog::commit(Record& record) {
+  record.bytes[0] = record.length;
+  while (kRingBytes - (head_ - tail_) < record.length) {
+    const uint8_t oldest = ring_[tail_ & (kRingBytes - 1)];
+    if (serialPos_ == tail_) {
+      // The flusher had not reached this record yet.
+      serialPos_ += oldest;
+      ++recordsOverwritten_;
+      ++unreportedOverwrites_;
+    }
+    tail_ += oldest;
+  }
+  for (uint8_t i = 0; i < record.length; ++i) {
+    ring_[(head_ + i) & (kRingBytes - 1)] = record.bytes[i];
+  }
+  head_ += record.length;
+  ++recordsWritten_;
+}
+
+/**
+ * Copy one record out of the ring, undoing the wrap.
+ */
+void DeferredLog::readRecord(uint32_t position, Record& record) {
+  record.length = ring_[position & (kRingBytes - 1)];
+  for (uint8_t i = 0; i < record.length; ++i) {
+    record.bytes[i] = ring_[(position + i) & (kRingBytes - 1)];
+  }
+}
+
+/**
+ * Expand the flash format with the record's arguments, one conversion at a time.
+ */
+size_t DeferredLog::formatRecord(const Record& record, char* out, size_t outSize) {
+  const uint16_t rawId = static_cast<uint16_t>(record.bytes[2] | (record.bytes[3] << 8));
+  size_t used = 0;
+  out[0] = '\0';
+  if (rawId >= static_cast<uint16_t>(LogId::Count)) {
+    snprintf(out, outSize, "[LOG] unknown id %u", static_cast<unsigned>(rawId));
+    return strlen(out);
+  }
+
+  const char* format = static_cast<const char*>(pgm_read_ptr(&kFormats[rawId]));
+  uint8_t argPos = kHeaderBytes;
+  char c = static_cast<char>(pgm_read_byte(format++));
+  while (c != '\0' && used + 1 < outSize) {
+    if (c != '%') {
+      out[used++] = c;
+      out[used] = '\0';
+      c = static_cast<char>(pgm_read_byte(format++));
+      continue;
+    }
+
+    // Copy flags/width, then insert 'l' so 32-bit values print the same on every core.
+    char spec[8] = "%";
+    uint8_t specLength = 1;
+    c = static_cast<char>(pgm_read_byte(format++));
+    while ((c == '0' || c == '-' || (c >= '1' && c <= '9')) && specLength < sizeof(spec) - 3) {
+      spec[specLength++] = c;
+      c = static_cast<char>(pgm_read_byte(format++));
+    }
+    if (c == '%') {
+      appendText(out, outSize, used, "%");
+    } else if (argPos >= record.length) {
+      appendText(out, outSize, used, "?");
+    } else if (record.bytes[argPos] == kArgString) {
+      const uint8_t length = record.bytes[argPos + 1];
+      char text[kMaxStringArg + 1];
+      memcpy(text, record.bytes + argPos + 2, length);
+      text[length] = '\0';
+      appendText(out, outSize, used, text);
+      argPos = static_cast<uint8_t>(argPos + 2 + length);
+    } else {
+      const uint32_t bits = readU32(record.bytes + argPos + 1);
+      const bool isSigned = record.bytes[argPos] == kArgSigned;
+      spec[specLength++] = 'l';
+      spec[specLength++] = (c == 'x') ? 'x' : (c == 'd' || (c != 'u' && isSigned)) ? 'd' : 'u';
+      spec[specLength] = '\0';
+      char number[16];
+      if (spec[specLength - 1] == 'd') {
+        snprintf(number, sizeof(number), spec, static_cast<long>(static_cast<int32_t>(bits)));
+      } else {
+        snprintf(number, sizeof(number), spec, static_cast<unsigned long>(bits));
+      }
+      appendText(out, outSize, used, number);
+      argPos = static_cast<uint8_t>(argPos + 5);
+    }
+    if (c == '\0') {
+      break;
+    }
+    c = static_cast<char>(pgm_read_byte(format++));
+  }
+  return used;
+}
+
+/**
+ * Print a bounded number of queued records without blocking on a full UART.
+ */
+void DeferredLog::drainToSerial(uint8_t maxRecords) {
+  if (unreportedOverwrites_ > 0 && Serial.availableForWrite() >= kMinSerialRoom) {
+    Serial.print("[LOG] Records overwritten before flush: ");
+    Serial.println(unreportedOverwrites_);
+    unreportedOverwrites_ = 0;
+  }
+
+  char line[kLineSize];
+  for (uint8_t i = 0; i < maxRecords && serialPos_ != head_; ++i) {
+    Record record;
+    readRecord(serialPos_, record);
+    const size_t length = formatRecord(record, line, sizeof(line));
+    const int needed = static_cast<int>(length + 2) < kMinSerialRoom ? static_cast<int>(length + 2) : kMinSerialRoom;
+    if (Serial.availableForWrite() < needed) {
+      return;
+    }
+    Serial.println(line);
+    serialPos_ += record.length;
+  }
+}
+
+/**
+ * Stream the dump header, then the retained ring bytes in at most two contiguous slices.
+ */
+size_t DeferredLog::dump(Writer writer, void* context) {
+  // "WCLG", version, level ceiling, 2 reserved, records written, overwritten, millis at dump.
+  uint8_t header[20] = {'W', 'C', 'L', 'G', kDumpVersion, WEATHERCLOCK_LOG_LEVEL, 0, 0};
+  writeU32(header + 8, recordsWritten_);
+  writeU32(header + 12, recordsOverwritten_);
+  writeU32(header + 16, millis());
+  writer(context, reinterpret_cast<const char*>(header), sizeof(header));
+  size_t total = sizeof(header);
+
+  const size_t start = tail_ & (kRingBytes - 1);
+  const size_t retained = head_ - tail_;
+  const size_t firstSlice = retained < kRingBytes - start ? retained : kRingBytes - start;
+  if (firstSlice > 0) {
+    writer(context, reinterpret_cast<const char*>(ring_ + start), firstSlice);
+  }
+  if (retained > firstSlice) {
+    writer(context, reinterpret_cast<const char*>(ring_), retained - firstSlice);
+  }
+  return total + retained;
+}
+
+/**
+ * Return records written since boot.
+ */
+uint32_t DeferredLog::recordsWritten() {
+  return recordsWritten_;
+}
+
+/**
+ * Return records lost before the serial flusher reached them.
+ */
+uint32_t DeferredLog::recordsOverwritten() {
+  return recordsOverwritten_;
+}
+
+/**
+ * Return cycles spent in write().
+ */
+uint32_t DeferredLog::writeCycles() {
+  return writeCycles_;
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <type_traits>
+#include "LogMessages.h"
+
+// Compile-time ceiling: 0=error, 1=warn, 2=info, 3=debug. Calls above it generate no code.
+#ifndef WEATHERCLOCK_LOG_LEVEL
+#define WEATHERCLOCK_LOG_LEVEL 2
+#endif
+
+/**
+ * @brief Severity stored with each record.
+ */
+enum class LogLevel : uint8_t {
+  Error,
+  Warn,
+  Info,
+  Debug
+};
+
+/**
+ * @brief RAM ring of binary log records, formatted later off the hot path.
+ *
+ * write() copies a message id, a millis() stamp and 32-bit/short-string
+ * arguments into the ring; no text is formatted and the UART is not touched.
+ * drainToSerial() formats a few records per loop pass when the UART has room,
+ * and dump() streams the retained records for tools/decode_log.py. When the
+ * ring is full the oldest records are overwritten.
+ */
+class DeferredLog {
+ public:
+  /**
+   * @brief Receives one chunk of the binary dump.
+   * @param context Caller-owned state passed to dump().
+   * @param data Chunk bytes; only valid during the call.
+   * @param length Chunk size.
+   */
+  using Writer = void (*)(void* context, const char* data, size_t length);
+
+  /**
+   * @brief Append one record.
+   * @param level Severity.
+   * @param id Message whose format the arguments fill.
+   * @param args Integers of at most 32 bits and C strings (truncated to kMaxStringArg bytes).
+   */
+  template <typename... Args>
+  static void write(LogLevel level, LogId id, Args... args) {
+    const uint32_t startCycles = cycleCount();
+    Record record;
+    beginRecord(record, level, id);
+    append(record, args...);
+    commit(record);
+    writeCycles_ += cycleCount() - startCycles;
+  }
+
+  /**
+   * @brief Format and print queued records while the UART TX buffer has room.
+   * @param maxRecords Upper bound per call so one loop pass stays short.
+   */
+  static void drainToSerial(uint8_t maxRecords);
+
+  /**
+   * @brief Stream a header plus every retained record, oldest first, without consuming them.
+   * @return Total bytes written.
+   */
+  static size_t dump(Writer writer, void* context);
+
+  /**
+   * @brief Records written since boot.
+   */
+  static uint32_t recordsWritten();
+
+  /**
+   * @brief Records overwritten before the serial flusher printed them.
+   */
+  static uint32_t recordsOverwritten();
+
+  /**
+   * @brief CPU cycles spent inside write() since boot.
+   */
+  static uint32_t writeCycles();
+
+ private:
+  static constexpr size_t kRingBytes = 2048;  // Power of two for cheap index wrap.
+  static constexpr uint8_t kMaxRecordBytes = 96;
+  static constexpr uint8_t kMaxStringArg = 40;
+  static constexpr uint8_t kHeaderBytes = 8;  // length, level, id(2), millis(4)
+
+  struct Record {
+    uint8_t bytes[kMaxRecordBytes];
+    uint8_t length;
+  };
+
+  static uint32_t cycleCount();
+  static void beginRecord(Record& record, LogLevel level, LogId id);
+  static void appendInt(Record& record, bool isSigned, uint32_t bits);
+  static void appendString(Record& record, const char* text);
+  static void commit(Record& record);
+  static void readRecord(uint32_t position, Record& record);
+  static size_t formatRecord(const Record& record, char* out, size_t outSize);
+
+  static void append(Record&) {}
+
+  template <typename T, typename... Rest>
+  static void append(Record& record, T first, Rest... rest) {
+    appendArg(record, first);
+    append(record, rest...);
+  }
+
+  template <typename T>
+  static typename std::enable_if<std::is_integral<T>::value>::type appendArg(Record& record, T value) {
+    static_assert(sizeof(T) <= 4, "log arguments are 32-bit; cast wider values");
+    appendInt(record, std::is_signed<T>::value, static_cast<uint32_t>(value));
+  }
+
+  static void appendArg(Record& record, const char* text) {
+    appendString(record, text);
+  }
+
+  static void appendArg(Record& record, char* text) {
+    appendString(record, text);
+  }
+
+  static uint8_t ring_[kRingBytes];
+  static uint32_t head_;        // Total bytes ever written.
+  static uint32_t tail_;        // Start of the oldest retained record.
+  static uint32_t serialPos_;   // Next record the serial flusher prints.
+  static uint32_t recordsWritten_;
+  static uint32_t recordsOverwritten_;
+  static uint32_t unreportedOverwrites_;
+  static uint32_t writeCycles_;
+};
+
+// Disabled levels still type-check their arguments but generate no code.
+#define WEATHERCLOCK_LOG_DISCARD(level, id, ...)                              \
+  do {                                                                        \
+    if (false) DeferredLog::write(LogLevel::level, LogId::id, ##__VA_ARGS__); \
+  } while (0)
+
+#if WEATHERCLOCK_LOG_LEVEL >= 0
+#define LOG_ERROR(id, ...) DeferredLog::write(LogLevel::Error, LogId::id, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(id, ...) WEATHERCLOCK_LOG_DISCARD(Error, id, ##__VA_ARGS__)
+#endif
+#if WEATHERCLOCK_LOG_LEVEL >= 1
+#define LOG_WARN(id, ...) DeferredLog::write(LogLevel::Warn, LogId::id, ##__VA_ARGS__)
+#else
+#define LOG_WARN(id, ...) WEATHERCLOCK_LOG_DISCARD(Warn, id, ##__VA_ARGS__)
+#endif
+#if WEATHERCLOCK_LOG_LEVEL >= 2
+#define LOG_INFO(id, ...) DeferredLog::write(LogLevel::Info, LogId::id, ##__VA_ARGS__)
+#else
+#define LOG_INFO(id, ...) WEATHERCLOCK_LOG_DISCARD(Info, id, ##__VA_ARGS__)
+#endif
+#if WEATHERCLOCK_LOG_LEVEL >= 3
+#define LOG_DEBUG(id, ...) DeferredLog::write(LogLevel::Debug, LogId::id, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(id, ...) WEATHERCLOCK_LOG_DISCARD(Debug, id, ##__VA_ARGS__)
+#endif
@@ -2,6 +2,9 @@
 
 #include <Adafruit_GFX.h>
 #include <time.h>
+#include "Crc32.h"
+#include "ScreenMirror.h"
+#include "Trace.h"
 #include "WeatherIcons.h"
 
 DisplayService::DisplayService(Adafruit_SSD1306& display) : display_(display) {}
@@ -31,16 +34,9 @@ String DisplayService::formatHourLabel(uint8_t hour24) {
 }
 
 namespace {
-uint8_t currentLocalWday() {
-  time_t now = time(nullptr);
-  tm localNow{};
-  localtime_r(&now, &localNow);
-  return static_cast<uint8_t>(localNow.tm_wday);
-}
-
 // Picks daily slot that matches tomorrow's weekday.
-uint8_t pickDailyStartIndex(const WeatherData& weather) {
-  const uint8_t tomorrowWday = static_cast<uint8_t>((currentLocalWday() + 1) % 7);
+uint8_t pickDailyStartIndex(const WeatherData& weather, uint8_t todayWday) {
+  const uint8_t tomorrowWday = static_cast<uint8_t>((todayWday + 1) % 7);
   for (uint8_t i = 0; i < 4; ++i) {
     if ((weather.dailyDow[i] % 7) == tomorrowWday) {
       return i;
@@ -48,6 +44,16 @@ uint8_t pickDailyStartIndex(const WeatherData& weather) {
   }
   return 0;
 }
+
+// Index of the forecast entry covering the current hour (0 before NTP sync).
+uint8_t currentHourlyIndex(const ForecastStore& forecast) {
+  const time_t now = time(nullptr);
+  if (forecast.hourlyCount == 0 || now < static_cast<time_t>(forecast.hourlyStartEpoch)) {
+    return 0;
+  }
+  const uint32_t hours = static_cast<uint32_t>(now - static_cast<time_t>(forecast.hourlyStartEpoch)) / 3600UL;
+  return hours >= forecast.hourlyCount ? forecast.hourlyCount : static_cast<uint8_t>(hours);
+}
 }  // namespace
 
 void DisplayService::setNetworkActivity(bool active, uint8_t frame) {
@@ -55,6 +61,103 @@ void DisplayService::setNetworkActivity(bool active, uint8_t frame) {
   networkAnimFrame_ = frame;
 }
 
+void DisplayService::setWeatherFreshness(WeatherFreshness freshness, int32_t ageMinutes) {
+  weatherFreshness_ = freshness;
+  weatherAgeMinutes_ = ageMinutes;
+}
+
+bool DisplayService::weatherUsable(const WeatherData& weather) const {
+  return weather.valid && weatherFreshness_ != WeatherFreshness::Expired;
+}
+
+void DisplayService::setNowcast(const NowcastData& nowcast) {
+  nowcast_ = &nowcast;
+}
+
+void DisplayService::setObservationHistory(const ObservationHistory& history) {
+  history_ = &history;
+}
+
+void DisplayService::setHeapMonitor(const HeapMonitor& monitor) {
+  heapMonitor_ = &monitor;
+}
+
+void DisplayService::setScreenMirror(ScreenMirror& mirror) {
+  screenMirror_ = &mirror;
+}
+
+void DisplayService::setInterpolatedTemperature(bool active, int16_t temperatureF) {
+  interpolatedActive_ = active;
+  interpolatedTempF_ = temperatureF;
+}
+
+void DisplayService::setForecastScroll(uint8_t scrollPage) {
+  forecastScroll_ = scrollPage;
+}
+
+void DisplayService::setUtcOffsetSeconds(int32_t offsetSeconds) {
+  utcOffsetSeconds_ = offsetSeconds;
+}
+
+CivilTime DisplayService::localTimeOf(uint32_t utcEpoch) const {
+  return civilTimeFromEpoch(static_cast<int64_t>(utcEpoch) + utcOffsetSeconds_);
+}
+
+uint8_t DisplayService::forecastScrollPages(uint8_t pageIndex, const WeatherData& weather) const {
+  const ForecastStore& forecast = weather.forecast;
+  if (pageIndex == kHourlyPageIndex) {
+    // Each screenful covers kRowsPerPage rows spaced kHourlyRowStepHours apart.
+    const uint8_t first = currentHourlyIndex(forecast);
+    uint8_t pages = 1;
+    while (first + kHourlyRowStepHours * (kRowsPerPage * pages + 1) < forecast.hourlyCount) {
+      ++pages;
+    }
+    return pages;
+  }
+  if (pageIndex == kDiagPageIndex) {
+    // All phases first, then one screen per sync phase.
+    return static_cast<uint8_t>(1 + kHeapPhaseCount);
+  }
+  if (pageIndex == kFourDayPageIndex && forecast.dailyCount > 1) {
+    // Entry 0 is today; the default screen shows days 1..4.
+    return static_cast<uint8_t>((forecast.dailyCount - 1 + kRowsPerPage - 1) / kRowsPerPage);
+  }
+  return 1;
+}
+
+uint32_t DisplayService::framesDrawn() const {
+  return framesDrawn_;
+}
+
+uint32_t DisplayService::framesSkipped() const {
+  return framesSkipped_;
+}
+
+void DisplayService::flush() {
+  TRACE_SCOPE("flush");
+  // Most loop passes redraw an unchanged page; skip the ~25 ms I2C transfer for those.
+  // Hashing per 128-byte SSD1306 page costs the same as one frame CRC and tells the
+  // screen mirror which bands changed.
+  const uint8_t* buffer = display_.getBuffer();
+  bool changed = framesDrawn_ == 0;
+  for (uint8_t page = 0; page < kPageCount; ++page) {
+    const uint32_t crc = crc32Update(0, buffer + page * kScreenWidth, kScreenWidth);
+    if (crc != pageCrc_[page]) {
+      pageCrc_[page] = crc;
+      changed = true;
+    }
+  }
+  if (!changed) {
+    ++framesSkipped_;
+    return;
+  }
+  display_.display();
+  ++framesDrawn_;
+  if (screenMirror_ != nullptr) {
+    screenMirror_->onFrame(buffer, pageCrc_);
+  }
+}
+
 void DisplayService::setLocalIp(const String& ip) {
   localIp_ = ip;
 }
@@ -75,7 +178,7 @@ void DisplayService::drawBootScreen() {
   display_.setTextSize(1);
   display_.setCursor(20, 33);
   display_.print("Starting up...");
-  display_.display();
+  flush();
 }
 
 void DisplayService::drawStatusScreen(const char* title, const String& line1, const String& line2, const String& line3) {
@@ -92,17 +195,18 @@ void DisplayService::drawStatusScreen(const char* title, const String& line1, co
   display_.print(line2);
   display_.setCursor(0, 40);
   display_.print(line3);
-  display_.display();
+  flush();
 }
 
 void DisplayService::drawLayoutFrame(const ClockData& clock, const WeatherData& weather, bool showColon) {
   display_.clearDisplay();
   drawTopBand(clock, showColon);
   drawBottomBand(weather);
-  display_.display();
+  flush();
 }
 
 void DisplayService::drawPage(uint8_t pageIndex, const ClockData& clock, const WeatherData& weather, bool showColon) {
+  TRACE_SCOPE("drawPage");
   if (pageIndex == 0) {
     drawLayoutFrame(clock, weather, showColon);
     return;
@@ -114,14 +218,15 @@ void DisplayService::drawPage(uint8_t pageIndex, const ClockData& clock, const W
   display_.setTextColor(SSD1306_WHITE);
   display_.setTextSize(1);
 
-  if (!weather.valid) {
+  // Diagnostics stay reachable when weather is down; that is when they matter.
+  if (!weatherUsable(weather) && pageIndex != kDiagPageIndex) {
     display_.setCursor(0, 4);
     display_.print("Weather Pages");
     display_.setCursor(0, 28);
     display_.print("API ERROR");
     display_.setCursor(0, 52);
     display_.print(localIp_.length() ? localIp_ : "IP N/A");
-    display_.display();
+    flush();
     return;
   }
 
@@ -134,12 +239,20 @@ void DisplayService::drawPage(uint8_t pageIndex, const ClockData& clock, const W
     case 2:
       display_.setCursor(0, 4);
       display_.print("Hourly");
-      drawHourlyPage(clock, weather);
+      if (forecastScroll_ > 0) {
+        drawHourlyScrolled(weather);
+      } else {
+        drawHourlyPage(clock, weather);
+      }
       break;
     case 3:
       display_.setCursor(0, 4);
       display_.print("4-Day");
-      drawFourDayPage(weather);
+      if (forecastScroll_ > 0) {
+        drawFourDayScrolled(weather);
+      } else {
+        drawFourDayPage(clock, weather);
+      }
       break;
     case 4:
       display_.setCursor(0, 4);
@@ -151,12 +264,27 @@ void DisplayService::drawPage(uint8_t pageIndex, const ClockData& clock, const W
       display_.print("Wind");
       drawWindPage(weather);
       break;
+    case 6:
+      display_.setCursor(0, 4);
+      display_.print("Nowcast");
+      drawNowcastPage();
+      break;
+    case 7:
+      display_.setCursor(0, 4);
+      display_.print("Trend 72h");
+      drawTrendPage();
+      break;
+    case kDiagPageIndex:
+      display_.setCursor(0, 4);
+      display_.print("Diag");
+      drawDiagPage();
+      break;
     default:
       drawLayoutFrame(clock, weather, showColon);
       return;
   }
 
-  display_.display();
+  flush();
 }
 
 void DisplayService::drawNetworkActivityIcon(int16_t x, int16_t y) const {
@@ -175,6 +303,26 @@ void DisplayService::drawNetworkActivityIcon(int16_t x, int16_t y) const {
   }
 }
 
+void DisplayService::drawWeatherAgeBadge(int16_t x, int16_t y) {
+  // Network glyph shares this corner and takes priority while a refresh runs.
+  if (weatherFreshness_ != WeatherFreshness::Stale || networkBusy_) {
+    return;
+  }
+
+  char ageBuf[8];
+  if (weatherAgeMinutes_ < 0) {
+    snprintf(ageBuf, sizeof(ageBuf), "cache");
+  } else if (weatherAgeMinutes_ < 60) {
+    snprintf(ageBuf, sizeof(ageBuf), "%ldm", static_cast<long>(weatherAgeMinutes_));
+  } else {
+    snprintf(ageBuf, sizeof(ageBuf), "%ldh", static_cast<long>(weatherAgeMinutes_ / 60));
+  }
+  display_.setTextColor(SSD1306_WHITE);
+  display_.setTextSize(1);
+  display_.setCursor(x, y);
+  display_.print(ageBuf);
+}
+
 void DisplayService::drawTopBand(const ClockData& clock, bool showColon) {
   display_.fillRect(0, 0, kScreenWidth, kTopBandHeight, SSD1306_BLACK);
   display_.drawLine(0, kTopBandHeight, kScreenWidth, kTopBandHeight, SSD1306_WHITE);
@@ -183,7 +331,8 @@ void DisplayService::drawTopBand(const ClockData& clock, bool showColon) {
     display_.setTextColor(SSD1306_WHITE);
     display_.setTextSize(1);
     display_.setCursor(30, 4);
-    display_.print("NTP ERROR");
+    // While a sync is running, missing time is expected rather than an error.
+    display_.print(networkBusy_ ? "SYNCING" : "NTP ERROR");
     return;
   }
 
@@ -228,7 +377,7 @@ void DisplayService::drawBottomBand(const WeatherData& weather) {
     return x;
   };
 
-  if (!weather.valid) {
+  if (!weatherUsable(weather)) {
     drawNetworkActivityIcon(12, y0 + 34);
     display_.setTextColor(SSD1306_WHITE);
     display_.setTextSize(1);
@@ -241,9 +390,10 @@ void DisplayService::drawBottomBand(const WeatherData& weather) {
 
   drawWeatherIcon(display_, weather.type, 2, y0 + 2);
   drawNetworkActivityIcon(12, y0 + 34);
+  drawWeatherAgeBadge(6, y0 + 36);
 
   char tempBuf[12];
-  snprintf(tempBuf, sizeof(tempBuf), "%dF", weather.temperatureF);
+  snprintf(tempBuf, sizeof(tempBuf), "%dF", interpolatedActive_ ? interpolatedTempF_ : weather.temperatureF);
   const char* conditionText = weatherTypeLabel(weather.type);
   char rainBuf[16];
   snprintf(rainBuf, sizeof(rainBuf), "Rain %u%%", weather.rainChancePct);
@@ -314,11 +464,11 @@ void DisplayService::drawHourlyPage(const ClockData& clock, const WeatherData& w
   }
 }
 
-void DisplayService::drawFourDayPage(const WeatherData& weather) {
+void DisplayService::drawFourDayPage(const ClockData& clock, const WeatherData& weather) {
   display_.setTextSize(1);
   // Rows represent tomorrow through +3 days.
-  const uint8_t start = pickDailyStartIndex(weather);
-  const uint8_t baseWday = static_cast<uint8_t>((currentLocalWday() + 1) % 7);
+  const uint8_t start = pickDailyStartIndex(weather, clock.weekday);
+  const uint8_t baseWday = static_cast<uint8_t>((clock.weekday + 1) % 7);
   for (int i = 0; i < 4; ++i) {
     const uint8_t idx = static_cast<uint8_t>((start + i) % 4);
     const int16_t y = 20 + i * 11;
@@ -337,10 +487,93 @@ void DisplayService::drawFourDayPage(const WeatherData& weather) {
   }
 }
 
+void DisplayService::drawScrollIndicator(uint8_t position, uint8_t total) {
+  display_.setCursor(104, 4);
+  display_.print(position);
+  display_.print("/");
+  display_.print(total);
+}
+
+void DisplayService::drawHourlyScrolled(const WeatherData& weather) {
+  const ForecastStore& forecast = weather.forecast;
+  drawScrollIndicator(static_cast<uint8_t>(forecastScroll_ + 1), forecastScrollPages(kHourlyPageIndex, weather));
+  display_.setTextSize(1);
+  // Continue the default +2h..+8h cadence: screen n shows +(8n+2)h..+(8n+8)h.
+  const uint8_t first = currentHourlyIndex(forecast);
+  for (uint8_t row = 0; row < kRowsPerPage; ++row) {
+    const uint16_t idx = first + kHourlyRowStepHours * (kRowsPerPage * forecastScroll_ + row + 1);
+    if (idx >= forecast.hourlyCount) {
+      break;
+    }
+    const CivilTime local = localTimeOf(forecast.hourlyEpoch(static_cast<uint8_t>(idx)));
+    const int16_t y = 20 + row * 11;
+    display_.setCursor(0, y);
+    display_.print(formatHourLabel(local.hour));
+    display_.setCursor(34, y);
+    display_.print(forecast.hourlyTempF(static_cast<uint8_t>(idx)));
+    display_.print("F");
+    display_.setCursor(62, y);
+    display_.print(shortWeatherLabel(forecast.hourlyType(static_cast<uint8_t>(idx))));
+    display_.setCursor(104, y);
+    display_.print(forecast.hourlyPopPct[idx]);
+    display_.print("%");
+  }
+}
+
+void DisplayService::drawFourDayScrolled(const WeatherData& weather) {
+  const ForecastStore& forecast = weather.forecast;
+  drawScrollIndicator(static_cast<uint8_t>(forecastScroll_ + 1), forecastScrollPages(kFourDayPageIndex, weather));
+  display_.setTextSize(1);
+  for (uint8_t row = 0; row < kRowsPerPage; ++row) {
+    const uint16_t idx = 1 + kRowsPerPage * forecastScroll_ + row;
+    if (idx >= forecast.dailyCount) {
+      break;
+    }
+    const CivilTime local = localTimeOf(forecast.dailyEpoch(static_cast<uint8_t>(idx)));
+    const int16_t y = 20 + row * 11;
+    display_.setCursor(0, y);
+    display_.print(shortDayName(weekdayFromDays(local.days)));
+    display_.setCursor(30, y);
+    display_.print(forecast.dailyHighF(static_cast<uint8_t>(idx)));
+    display_.print("/");
+    display_.print(forecast.dailyLowF(static_cast<uint8_t>(idx)));
+    display_.setCursor(66, y);
+    display_.print(shortWeatherLabel(forecast.dailyType(static_cast<uint8_t>(idx))));
+    display_.setCursor(104, y);
+    display_.print(forecast.dailyPopPct[idx]);
+    display_.print("%");
+  }
+}
+
 void DisplayService::drawAdvisoriesPage(const WeatherData& weather) {
   display_.setTextSize(1);
+  if (weather.alertCount == 0) {
+    display_.setCursor(0, 20);
+    display_.print(weather.advisory);
+    return;
+  }
+
+  // Rotate through alerts; expired entries are already pruned by the caller.
+  const uint8_t count = weather.alertCount > kMaxWeatherAlerts ? kMaxWeatherAlerts : weather.alertCount;
+  const uint8_t idx = static_cast<uint8_t>((millis() / kAdvisoryScrollMs) % count);
+  const WeatherAlert& alert = weather.alerts[idx];
+  if (count > 1) {
+    drawScrollIndicator(static_cast<uint8_t>(idx + 1), count);
+  }
+
   display_.setCursor(0, 20);
-  display_.print(weather.advisory);
+  display_.print(alert.event);
+
+  // Upcoming alerts show when they begin; active ones show when they end.
+  const time_t now = time(nullptr);
+  const bool upcoming = static_cast<time_t>(alert.startEpoch) > now;
+  const CivilTime local = localTimeOf(upcoming ? alert.startEpoch : alert.endEpoch);
+  char line[22];
+  const uint8_t h12 = (local.hour % 12 == 0) ? 12 : static_cast<uint8_t>(local.hour % 12);
+  snprintf(line, sizeof(line), "%s %s %u:%02u%c", upcoming ? "From" : "Until", shortDayName(weekdayFromDays(local.days)),
+           h12, static_cast<unsigned>(local.minute), local.hour >= 12 ? 'p' : 'a');
+  display_.setCursor(0, 44);
+  display_.print(line);
 }
 
 void DisplayService::drawWindPage(const WeatherData& weather) {
@@ -385,3 +618,165 @@ void DisplayService::drawWindPage(const WeatherData& weather) {
   display_.setCursor(labelX, 44);
   display_.print(dirLabel);
 }
+
+void DisplayService::drawNowcastPage() {
+  display_.setTextSize(1);
+  const time_t now = time(nullptr);
+  // Skip minutes that have already passed so the graph always starts at "now".
+  uint8_t first = 0;
+  if (nowcast_ != nullptr && nowcast_->count > 0 && now > static_cast<time_t>(nowcast_->startEpoch)) {
+    const uint32_t elapsed = static_cast<uint32_t>(now - static_cast<time_t>(nowcast_->startEpoch)) / 60UL;
+    first = elapsed >= nowcast_->count ? nowcast_->count : static_cast<uint8_t>(elapsed);
+  }
+  if (nowcast_ == nullptr || first >= nowcast_->count) {
+    display_.setCursor(0, 28);
+    display_.print("No minutely data");
+    display_.setCursor(0, 40);
+    display_.print("(fetched when rainy)");
+    return;
+  }
+
+  uint8_t peak = 0;
+  int16_t firstWetMinute = -1;
+  for (uint8_t i = first; i < nowcast_->count; ++i) {
+    if (nowcast_->intensity[i] > peak) {
+      peak = nowcast_->intensity[i];
+    }
+    if (firstWetMinute < 0 && nowcast_->intensity[i] > 0) {
+      firstWetMinute = static_cast<int16_t>(i - first);
+    }
+  }
+
+  display_.setCursor(62, 4);
+  if (firstWetMinute < 0) {
+    display_.print("dry 60m");
+  } else if (firstWetMinute == 0) {
+    display_.print("wet now");
+  } else {
+    display_.print("in ");
+    display_.print(firstWetMinute);
+    display_.print("m");
+  }
+
+  // Two pixels per minute; bars scale to the hour's peak with a light-rain floor.
+  constexpr int16_t kGraphTop = 20;
+  constexpr int16_t kGraphBottom = 55;
+  constexpr uint8_t kScaleFloor = 20;  // 1 mm/h at 0.05 mm/h per step.
+  const uint8_t scale = peak > kScaleFloor ? peak : kScaleFloor;
+  display_.drawLine(0, kGraphBottom, kScreenWidth - 1, kGraphBottom, SSD1306_WHITE);
+  for (uint8_t i = first; i < nowcast_->count; ++i) {
+    const uint8_t q = nowcast_->intensity[i];
+    if (q == 0) {
+      continue;
+    }
+    const int16_t height =
+        static_cast<int16_t>(1 + (static_cast<int32_t>(q) * (kGraphBottom - kGraphTop - 1)) / scale);
+    const int16_t x = static_cast<int16_t>((i - first) * 2);
+    display_.fillRect(x, kGraphBottom - height, 2, height, SSD1306_WHITE);
+  }
+  // Ticks every 15 minutes.
+  for (uint8_t minute = 15; minute < kNowcastSamples; minute += 15) {
+    display_.drawPixel(minute * 2, kGraphBottom + 1, SSD1306_WHITE);
+  }
+  display_.setCursor(0, 57);
+  display_.print("now");
+  display_.setCursor(104, 57);
+  display_.print("+60");
+}
+
+void DisplayService::drawTrendPage() {
+  display_.setTextSize(1);
+  if (history_ == nullptr || history_->count() < 2) {
+    display_.setCursor(0, 28);
+    display_.print("Collecting history");
+    return;
+  }
+
+  const int16_t minTemp = history_->minTemperatureF();
+  const int16_t maxTemp = history_->maxTemperatureF();
+  display_.setCursor(62, 4);
+  display_.print(minTemp);
+  display_.print("-");
+  display_.print(maxTemp);
+  display_.print("F");
+
+  // Temperature line above, wind bars with gust dots below; newest sample on the right edge.
+  constexpr int16_t kTempTop = 19;
+  constexpr int16_t kTempBottom = 45;
+  constexpr int16_t kWindTop = 49;
+  constexpr int16_t kWindBottom = 63;
+  const int16_t tempSpan = (maxTemp - minTemp) > 0 ? (maxTemp - minTemp) : 1;
+  const uint8_t windSpan = history_->maxWindMph() > 0 ? history_->maxWindMph() : 1;
+  const uint8_t slotOffset = static_cast<uint8_t>(ObservationHistory::kCapacity - history_->count());
+
+  ObservationHistory::Reader reader;
+  history_->startRead(reader);
+  int16_t prevX = -1;
+  int16_t prevY = 0;
+  while (history_->read(reader)) {
+    const ObservationSample& sample = reader.sample;
+    const int16_t x = static_cast<int16_t>(
+        (static_cast<int32_t>(slotOffset + reader.position - 1) * (kScreenWidth - 1)) /
+        (ObservationHistory::kCapacity - 1));
+    const int16_t y = static_cast<int16_t>(
+        kTempBottom - (static_cast<int32_t>(sample.temperatureF - minTemp) * (kTempBottom - kTempTop)) / tempSpan);
+    if (prevX >= 0) {
+      display_.drawLine(prevX, prevY, x, y, SSD1306_WHITE);
+    }
+    prevX = x;
+    prevY = y;
+
+    const int16_t windHeight =
+        static_cast<int16_t>((static_cast<int32_t>(sample.windMph) * (kWindBottom - kWindTop)) / windSpan);
+    if (windHeight > 0) {
+      display_.drawFastVLine(x, kWindBottom - windHeight, windHeight, SSD1306_WHITE);
+    }
+    const int16_t gustY = static_cast<int16_t>(
+        kWindBottom - (static_cast<int32_t>(sample.gustMph) * (kWindBottom - kWindTop)) / windSpan);
+    display_.drawPixel(x, gustY, SSD1306_WHITE);
+  }
+}
+
+void DisplayService::drawDiagPage() {
+  display_.setTextSize(1);
+  drawScrollIndicator(static_cast<uint8_t>(forecastScroll_ + 1), static_cast<uint8_t>(1 + kHeapPhaseCount));
+  display_.setCursor(30, 4);
+  if (forecastScroll_ == 0) {
+    display_.print("all");
+  } else {
+    display_.print(HeapMonitor::phaseName(static_cast<HeapPhase>(forecastScroll_ - 1)));
+  }
+
+  if (heapMonitor_ == nullptr) {
+    display_.setCursor(0, 28);
+    display_.print("No heap monitor");
+    return;
+  }
+  const HeapPhaseStats& stats = forecastScroll_ == 0
+                                    ? heapMonitor_->overall()
+                                    : heapMonitor_->stats(static_cast<HeapPhase>(forecastScroll_ - 1));
+  if (stats.samples == 0) {
+    display_.setCursor(0, 28);
+    display_.print("No sync sampled yet");
+    return;
+  }
+
+  // Last sample on the left, worst case on the right: low free/block/stack, high fragmentation.
+  char line[22];
+  snprintf(line, sizeof(line), "Free %6lu lo %6lu", static_cast<unsigned long>(stats.freeBytes.last),
+           static_cast<unsigned long>(stats.freeBytes.min));
+  display_.setCursor(0, 20);
+  display_.print(line);
+  snprintf(line, sizeof(line), "Blk  %6lu lo %6lu", static_cast<unsigned long>(stats.largestBlock.last),
+           static_cast<unsigned long>(stats.largestBlock.min));
+  display_.setCursor(0, 31);
+  display_.print(line);
+  snprintf(line, sizeof(line), "Frag %5lu%% hi %5lu%%", static_cast<unsigned long>(stats.fragmentationPct.last),
+           static_cast<unsigned long>(stats.fragmentationPct.max));
+  display_.setCursor(0, 42);
+  display_.print(line);
+  snprintf(line, sizeof(line), "Stk  %6lu lo %6lu", static_cast<unsigned long>(stats.stackFree.last),
+           static_cast<unsigned long>(stats.stackFree.min));
+  display_.setCursor(0, 53);
+  display_.print(line);
+}
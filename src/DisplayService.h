@@ -2,7 +2,13 @@
 
 #include <Arduino.h>
 #include <Adafruit_SSD1306.h>
+#include "CivilCalendar.h"
+#include "HeapMonitor.h"
 #include "Models.h"
+#include "ObservationHistory.h"
+#include "WeatherCache.h"
+
+class ScreenMirror;
 
 /**
  * @brief Encapsulates all OLED drawing/layout logic.
@@ -24,6 +30,74 @@ class DisplayService {
    */
   void setNetworkActivity(bool active, uint8_t frame);
 
+  /**
+   * @brief Set freshness tier of the weather being rendered.
+   * @param freshness Stale shows an age badge; Expired shows the error screen.
+   * @param ageMinutes Minutes since fetch, or -1 when unknown.
+   */
+  void setWeatherFreshness(WeatherFreshness freshness, int32_t ageMinutes);
+
+  /**
+   * @brief Provide the minutely nowcast rendered on the Nowcast page.
+   * @param nowcast Caller-owned data; must outlive the display service.
+   */
+  void setNowcast(const NowcastData& nowcast);
+
+  /**
+   * @brief Provide the observation history rendered on the Trend page.
+   * @param history Caller-owned history; must outlive the display service.
+   */
+  void setObservationHistory(const ObservationHistory& history);
+
+  /**
+   * @brief Provide the heap statistics rendered on the Diag page.
+   * @param monitor Caller-owned monitor; must outlive the display service.
+   */
+  void setHeapMonitor(const HeapMonitor& monitor);
+
+  /**
+   * @brief Report every frame pushed to the panel to the /screen mirror.
+   * @param mirror Caller-owned mirror; must outlive the display service.
+   */
+  void setScreenMirror(ScreenMirror& mirror);
+
+  /**
+   * @brief Override the home-page temperature with an interpolated value.
+   * @param active False to show the last observed temperature.
+   * @param temperatureF Interpolated temperature in Fahrenheit.
+   */
+  void setInterpolatedTemperature(bool active, int16_t temperatureF);
+
+  /**
+   * @brief Select which screenful of the extended forecast the Hourly/4-Day pages show.
+   * @param scrollPage 0 shows the default rows; higher values step further ahead.
+   */
+  void setForecastScroll(uint8_t scrollPage);
+
+  /**
+   * @brief Set the location's UTC offset used to label forecast and alert times.
+   * @param offsetSeconds Seconds east of UTC from the weather API.
+   */
+  void setUtcOffsetSeconds(int32_t offsetSeconds);
+
+  /**
+   * @brief Number of scroll positions available on a page.
+   * @param pageIndex UI page index.
+   * @param weather Weather values whose forecast store bounds the range.
+   * @return 1 for pages that do not scroll.
+   */
+  uint8_t forecastScrollPages(uint8_t pageIndex, const WeatherData& weather) const;
+
+  /**
+   * @brief Frames pushed to the OLED since boot.
+   */
+  uint32_t framesDrawn() const;
+
+  /**
+   * @brief Frames not pushed because the buffer matched the last flush.
+   */
+  uint32_t framesSkipped() const;
+
   /**
    * @brief Set local IP text used on error screens.
    * @param ip Local IP string (e.g. 192.168.1.42).
@@ -64,6 +138,12 @@ class DisplayService {
  private:
   static constexpr uint8_t kScreenWidth = 128;
   static constexpr uint8_t kTopBandHeight = 16;
+  static constexpr uint8_t kPageCount = 64 / 8;
+
+  /**
+   * @brief Push the framebuffer to the panel unless every page matches the last flushed frame.
+   */
+  void flush();
 
   /**
    * @brief Return compact weather label fallback.
@@ -90,6 +170,16 @@ class DisplayService {
    */
   void drawNetworkActivityIcon(int16_t x, int16_t y) const;
 
+  /**
+   * @brief True when weather is valid and not expired.
+   */
+  bool weatherUsable(const WeatherData& weather) const;
+
+  /**
+   * @brief Draw compact age badge for stale weather.
+   */
+  void drawWeatherAgeBadge(int16_t x, int16_t y);
+
   /**
    * @brief Draw top clock/date band.
    */
@@ -113,10 +203,30 @@ class DisplayService {
   /**
    * @brief Draw "4-Day" detail page.
    */
-  void drawFourDayPage(const WeatherData& weather);
+  void drawFourDayPage(const ClockData& clock, const WeatherData& weather);
+
+  /**
+   * @brief Local calendar time of a UTC epoch at the weather location.
+   */
+  CivilTime localTimeOf(uint32_t utcEpoch) const;
+
+  /**
+   * @brief Draw hourly rows further ahead from the forecast store.
+   */
+  void drawHourlyScrolled(const WeatherData& weather);
 
   /**
-   * @brief Draw advisories detail page.
+   * @brief Draw daily rows beyond the first four from the forecast store.
+   */
+  void drawFourDayScrolled(const WeatherData& weather);
+
+  /**
+   * @brief Draw "n/N" scroll position in the title band.
+   */
+  void drawScrollIndicator(uint8_t position, uint8_t total);
+
+  /**
+   * @brief Draw advisories detail page, cycling through active alerts.
    */
   void drawAdvisoriesPage(const WeatherData& weather);
 
@@ -125,8 +235,43 @@ class DisplayService {
    */
   void drawWindPage(const WeatherData& weather);
 
+  /**
+   * @brief Draw next-hour precipitation sparkline page.
+   */
+  void drawNowcastPage();
+
+  /**
+   * @brief Draw 72 h temperature and wind sparklines in one pass over the history ring.
+   */
+  void drawTrendPage();
+
+  /**
+   * @brief Draw heap/fragmentation/stack min-max-last for all phases or one scrolled-to phase.
+   */
+  void drawDiagPage();
+
+  static constexpr unsigned long kAdvisoryScrollMs = 4000;
+  static constexpr uint8_t kHourlyPageIndex = 2;
+  static constexpr uint8_t kFourDayPageIndex = 3;
+  static constexpr uint8_t kDiagPageIndex = 8;
+  static constexpr uint8_t kRowsPerPage = 4;
+  static constexpr uint8_t kHourlyRowStepHours = 2;
+
   Adafruit_SSD1306& display_;
   bool networkBusy_ = false;
   uint8_t networkAnimFrame_ = 0;
+  WeatherFreshness weatherFreshness_ = WeatherFreshness::Fresh;
+  int32_t weatherAgeMinutes_ = -1;
+  uint8_t forecastScroll_ = 0;
+  int32_t utcOffsetSeconds_ = 0;
+  bool interpolatedActive_ = false;
+  int16_t interpolatedTempF_ = 0;
+  const NowcastData* nowcast_ = nullptr;
+  const ObservationHistory* history_ = nullptr;
+  const HeapMonitor* heapMonitor_ = nullptr;
+  ScreenMirror* screenMirror_ = nullptr;
+  uint32_t pageCrc_[kPageCount] = {};
+  uint32_t framesDrawn_ = 0;
+  uint32_t framesSkipped_ = 0;
   String localIp_;
 };
@@ -0,0 +1,194 @@
+#include "FixedPoint.h"
+
+#include <Arduino.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+namespace {
+// Mantissa digits kept exactly; later digits can only matter for rounding ties.
+constexpr uint8_t kMaxMantissaDigits = 18;
+
+const int64_t kPow10[] = {1LL,
+                          10LL,
+                          100LL,
+                          1000LL,
+                          10000LL,
+                          100000LL,
+                          1000000LL,
+                          10000000LL,
+                          100000000LL,
+                          1000000000LL,
+                          10000000000LL,
+                          100000000000LL,
+                          1000000000000LL,
+                          10000000000000LL,
+                          100000000000000LL,
+                          1000000000000000LL,
+                          10000000000000000LL,
+                          100000000000000000LL,
+                          1000000000000000000LL};
+constexpr int kMaxPow10 = 18;
+
+bool isDigit(char c) {
+  return c >= '0' && c <= '9';
+}
+}  // namespace
+
+bool parseScaledInt(const char* text, uint8_t decimals, int32_t& out, const char** end) {
+  if (text == nullptr) {
+    return false;
+  }
+  const char* p = text;
+  while (*p == ' ' || *p == '\t' || *p == '\r' || *p == '\n') {
+    ++p;
+  }
+  bool negative = false;
+  if (*p == '-' || *p == '+') {
+    negative = *p == '-';
+    ++p;
+  }
+
+  // value = mantissa * 10^exponent10, built from at most kMaxMantissaDigits digits.
+  int64_t mantissa = 0;
+  int32_t exponent10 = 0;
+  uint8_t mantissaDigits = 0;
+  bool anyDigit = false;
+  for (; isDigit(*p); ++p) {
+    anyDigit = true;
+    if (mantissaDigits < kMaxMantissaDigits) {
+      mantissa = mantissa * 10 + (*p - '0');
+      if (mantissa != 0) {
+        ++mantissaDigits;
+      }
+    } else {
+      ++exponent10;
+    }
+  }
+  if (*p == '.') {
+    ++p;
+    for (; isDigit(*p); ++p) {
+      anyDigit = true;
+      if (mantissaDigits < kMaxMantissaDigits) {
+        mantissa = mantissa * 10 + (*p - '0');
+        if (mantissa != 0) {
+          ++mantissaDigits;
+        }
+        --exponent10;
+      }
+    }
+  }
+  if (!anyDigit) {
+    return false;
+  }
+  if (*p == 'e' || *p == 'E') {
+    const char* expStart = p + 1;
+    bool expNegative = false;
+    if (*expStart == '-' || *expStart == '+') {
+      expNegative = *expStart == '-';
+      ++expStart;
+    }
+    if (isDigit(*expStart)) {
+      int32_t exp = 0;
+      for (p = expStart; isDigit(*p); ++p) {
+        if (exp < 1000) {
+          exp = exp * 10 + (*p - '0');
+        }
+      }
+      exponent10 += expNegative ? -exp : exp;
+    }
+  }
+  if (end != nullptr) {
+    *end = p;
+  }
+
+  int32_t shift = exponent10 + decimals;
+  int64_t scaled = mantissa;
+  if (mantissa == 0) {
+    scaled = 0;
+  } else if (shift >= 0) {
+    if (mantissaDigits + shift > 10) {
+      // At least 11 integer digits: cannot fit int32.
+      return false;
+    }
+    scaled = mantissa * kPow10[shift];
+  } else if (-shift > kMaxPow10) {
+    scaled = 0;
+  } else {
+    // Half away from zero: the sign is applied after rounding the magnitude.
+    const int64_t divisor = kPow10[-shift];
+    scaled = mantissa / divisor;
+    if ((mantissa % divisor) * 2 >= divisor) {
+      ++scaled;
+    }
+  }
+  if (scaled > INT32_MAX) {
+    return false;
+  }
+  out = static_cast<int32_t>(negative ? -scaled : scaled);
+  return true;
+}
+
+int32_t roundScaled(int32_t value, int32_t divisor) {
+  if (divisor <= 1) {
+    return value;
+  }
+  const int32_t half = divisor / 2;
+  return value >= 0 ? (value + half) / divisor : -((-value + half) / divisor);
+}
+
+size_t formatScaled(int32_t value, uint8_t decimals, char* out, size_t outSize) {
+  if (out == nullptr || outSize == 0) {
+    return 0;
+  }
+  const int64_t magnitude = value < 0 ? -static_cast<int64_t>(value) : value;
+  if (decimals == 0 || decimals > 9) {
+    const int written = snprintf(out, outSize, "%ld", static_cast<long>(value));
+    return written > 0 ? static_cast<size_t>(written) : 0;
+  }
+  const int64_t scale = kPow10[decimals];
+  const int written = snprintf(out, outSize, "%s%ld.%0*ld", value < 0 ? "-" : "", static_cast<long>(magnitude / scale),
+                               static_cast<int>(decimals), static_cast<long>(magnitude % scale));
+  return written > 0 ? static_cast<size_t>(written) : 0;
+}
+
+#if WEATHERCLOCK_BENCH
+// Bench builds only: strtod here would otherwise pull soft-float parsing back into the firmware.
+void logFixedPointBenchmark() {
+  // Representative OneCall fields: temperatures, wind, pop, coordinates.
+  static const char* const kSamples[] = {"72.45", "-3.18", "101.6", "12.35", "27.8", "0.87", "40.712776", "-74.005974"};
+  static const uint8_t kDecimals[] = {kFixedWhole, kFixedWhole,   kFixedWhole, kFixedWhole,
+                                      kFixedWhole, kFixedPercent, kFixedMicro, kFixedMicro};
+  constexpr uint8_t kSampleCount = sizeof(kSamples) / sizeof(kSamples[0]);
+  constexpr uint8_t kRounds = 16;
+
+  volatile int32_t sink = 0;
+  const uint32_t fixedStart = ESP.getCycleCount();
+  for (uint8_t round = 0; round < kRounds; ++round) {
+    for (uint8_t i = 0; i < kSampleCount; ++i) {
+      int32_t value = 0;
+      parseScaledInt(kSamples[i], kDecimals[i], value);
+      sink = sink + value;
+    }
+  }
+  const uint32_t fixedCycles = ESP.getCycleCount() - fixedStart;
+
+  // Previous path: text to double, then soft-float rounding to an integer.
+  const uint32_t floatStart = ESP.getCycleCount();
+  for (uint8_t round = 0; round < kRounds; ++round) {
+    for (uint8_t i = 0; i < kSampleCount; ++i) {
+      const double value = strtod(kSamples[i], nullptr);
+      sink = sink + static_cast<int32_t>(value + (value >= 0 ? 0.5 : -0.5));
+    }
+  }
+  const uint32_t floatCycles = ESP.getCycleCount() - floatStart;
+  (void)sink;
+
+  const uint32_t samples = static_cast<uint32_t>(kSampleCount) * kRounds;
+  Serial.print("[FIXP] Parse cycles/number fixed=");
+  Serial.print(fixedCycles / samples);
+  Serial.print(" float=");
+  Serial.print(floatCycles / samples);
+  Serial.print(" samples=");
+  Serial.println(samples);
+}
+#endif
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Whole units (temperatures in F, wind in mph), rounded once from the full text. */
+constexpr uint8_t kFixedWhole = 0;
+/** @brief Decimal places for tenths. */
+constexpr uint8_t kFixedTenths = 1;
+/** @brief Decimal places for hundredths. */
+constexpr uint8_t kFixedCenti = 2;
+/** @brief Hundredths of a 0..1 probability, i.e. percent. */
+constexpr uint8_t kFixedPercent = kFixedCenti;
+/** @brief Decimal places for thousandths. */
+constexpr uint8_t kFixedMilli = 3;
+/** @brief Decimal places for millionths (coordinates in microdegrees, precipitation in um/h). */
+constexpr uint8_t kFixedMicro = 6;
+
+/**
+ * @brief Parse a JSON number into a scaled integer without touching floating point.
+ *
+ * Accepts an optional sign, digits, a fraction and an exponent. Digits past the
+ * requested precision round half away from zero, like the previous
+ * double-based rounding.
+ * @param text Number text; leading whitespace is skipped.
+ * @param decimals Fractional digits kept; the result is value * 10^decimals.
+ * @param out Scaled result.
+ * @param end Optional output: first character after the number.
+ * @return False when there are no digits or the result does not fit int32.
+ */
+bool parseScaledInt(const char* text, uint8_t decimals, int32_t& out, const char** end = nullptr);
+
+/**
+ * @brief Divide a scaled value and round half away from zero.
+ * @param value Scaled value, e.g. tenths.
+ * @param divisor Scale to remove, e.g. 10 for tenths to units.
+ */
+int32_t roundScaled(int32_t value, int32_t divisor);
+
+/**
+ * @brief Format a scaled integer as decimal text (e.g. -73987654, 6 -> "-73.987654").
+ * @return Characters written, excluding the terminator.
+ */
+size_t formatScaled(int32_t value, uint8_t decimals, char* out, size_t outSize);
+
+#if WEATHERCLOCK_BENCH
+/**
+ * @brief Time parseScaledInt against strtod + rounding on sample payload numbers and log cycles.
+ */
+void logFixedPointBenchmark();
+#endif
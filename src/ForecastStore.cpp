@@ -0,0 +1,138 @@
+#include "ForecastStore.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+namespace {
+// What the forecast would look like as straightforward arrays of structs.
+struct NaiveHourlyEntry {
+  uint32_t epoch;
+  int16_t tempF;
+  WeatherType type;
+  uint8_t popPct;
+};
+
+struct NaiveDailyEntry {
+  uint32_t epoch;
+  int16_t highF;
+  int16_t lowF;
+  WeatherType type;
+  uint8_t popPct;
+};
+
+int8_t clampDelta(int value) {
+  if (value < -128) {
+    return -128;
+  }
+  if (value > 127) {
+    return 127;
+  }
+  return static_cast<int8_t>(value);
+}
+
+void putNibble(uint8_t* packed, uint8_t index, WeatherType type) {
+  const uint8_t shift = (index & 1U) ? 4 : 0;
+  uint8_t& cell = packed[index / 2];
+  cell = static_cast<uint8_t>((cell & ~(0x0FU << shift)) | ((static_cast<uint8_t>(type) & 0x0FU) << shift));
+}
+
+WeatherType getNibble(const uint8_t* packed, uint8_t index) {
+  const uint8_t raw = static_cast<uint8_t>((packed[index / 2] >> ((index & 1U) ? 4 : 0)) & 0x0FU);
+  return raw < static_cast<uint8_t>(WeatherType::Count) ? static_cast<WeatherType>(raw) : WeatherType::Cloudy;
+}
+}  // namespace
+
+void ForecastStore::clearHourly() {
+  hourlyStartEpoch = 0;
+  hourlyBaseF = 0;
+  hourlyCount = 0;
+  memset(hourlyTypes, 0, sizeof(hourlyTypes));
+}
+
+void ForecastStore::clearDaily() {
+  dailyStartEpoch = 0;
+  dailyBaseF = 0;
+  dailyCount = 0;
+  memset(dailyTypes, 0, sizeof(dailyTypes));
+}
+
+bool ForecastStore::appendHourly(uint32_t epoch, int16_t tempF, WeatherType type, uint8_t popPct) {
+  if (hourlyCount >= kHourlyCapacity) {
+    return false;
+  }
+  if (hourlyCount == 0) {
+    hourlyStartEpoch = epoch;
+    hourlyBaseF = tempF;
+  } else if (epoch != hourlyEpoch(hourlyCount)) {
+    // Times are implicit, so the series must stay gap-free.
+    return false;
+  }
+  hourlyTempDelta[hourlyCount] = clampDelta(tempF - hourlyBaseF);
+  putNibble(hourlyTypes, hourlyCount, type);
+  hourlyPopPct[hourlyCount] = popPct > 100 ? 100 : popPct;
+  ++hourlyCount;
+  return true;
+}
+
+bool ForecastStore::appendDaily(uint32_t epoch, int16_t highF, int16_t lowF, WeatherType type, uint8_t popPct) {
+  if (dailyCount >= kDailyCapacity) {
+    return false;
+  }
+  if (dailyCount == 0) {
+    // Daily stamps drift by an hour across DST; only the day matters for display.
+    dailyStartEpoch = epoch;
+    dailyBaseF = highF;
+  }
+  dailyHighDelta[dailyCount] = clampDelta(highF - dailyBaseF);
+  dailyLowDelta[dailyCount] = clampDelta(lowF - dailyBaseF);
+  putNibble(dailyTypes, dailyCount, type);
+  dailyPopPct[dailyCount] = popPct > 100 ? 100 : popPct;
+  ++dailyCount;
+  return true;
+}
+
+uint32_t ForecastStore::hourlyEpoch(uint8_t i) const {
+  return hourlyStartEpoch + static_cast<uint32_t>(i) * 3600UL;
+}
+
+int16_t ForecastStore::hourlyTempF(uint8_t i) const {
+  return static_cast<int16_t>(hourlyBaseF + hourlyTempDelta[i]);
+}
+
+WeatherType ForecastStore::hourlyType(uint8_t i) const {
+  return getNibble(hourlyTypes, i);
+}
+
+uint32_t ForecastStore::dailyEpoch(uint8_t i) const {
+  return dailyStartEpoch + static_cast<uint32_t>(i) * 86400UL;
+}
+
+int16_t ForecastStore::dailyHighF(uint8_t i) const {
+  return static_cast<int16_t>(dailyBaseF + dailyHighDelta[i]);
+}
+
+int16_t ForecastStore::dailyLowF(uint8_t i) const {
+  return static_cast<int16_t>(dailyBaseF + dailyLowDelta[i]);
+}
+
+WeatherType ForecastStore::dailyType(uint8_t i) const {
+  return getNibble(dailyTypes, i);
+}
+
+size_t ForecastStore::naiveFootprintBytes() {
+  return sizeof(NaiveHourlyEntry) * kHourlyCapacity + sizeof(NaiveDailyEntry) * kDailyCapacity;
+}
+
+#if WEATHERCLOCK_BENCH
+void ForecastStore::logFootprint() {
+  Serial.print("[FCST] Footprint SoA=");
+  Serial.print(sizeof(ForecastStore));
+  Serial.print("B naive AoS=");
+  Serial.print(naiveFootprintBytes());
+  Serial.print("B (");
+  Serial.print(kHourlyCapacity);
+  Serial.print("h + ");
+  Serial.print(kDailyCapacity);
+  Serial.println("d)");
+}
+#endif
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "WeatherIcons.h"
+
+/**
+ * @brief Full 48 h hourly / 8 day daily forecast in a quantized structure-of-arrays layout.
+ *
+ * Entry times are implicit: entry i is start + i hours (hourly) or days (daily).
+ * Temperatures are int8 deltas from a per-series base, weather types are packed
+ * two per byte, and precipitation chance is a uint8 percent. The store is plain
+ * data; a zero-initialized instance is empty.
+ */
+struct ForecastStore {
+  /** @brief Hourly entries kept (OneCall returns 48). */
+  static constexpr uint8_t kHourlyCapacity = 48;
+  /** @brief Daily entries kept (OneCall returns 8, today first). */
+  static constexpr uint8_t kDailyCapacity = 8;
+
+  /** @brief UTC epoch of hourly entry 0. */
+  uint32_t hourlyStartEpoch;
+  /** @brief Reference temperature for hourly deltas. */
+  int16_t hourlyBaseF;
+  /** @brief Number of valid hourly entries. */
+  uint8_t hourlyCount;
+  /** @brief Hourly temperature minus hourlyBaseF, clamped to int8. */
+  int8_t hourlyTempDelta[kHourlyCapacity];
+  /** @brief Hourly WeatherType values, low nibble = even index. */
+  uint8_t hourlyTypes[kHourlyCapacity / 2];
+  /** @brief Hourly precipitation probability percent. */
+  uint8_t hourlyPopPct[kHourlyCapacity];
+
+  /** @brief UTC epoch of daily entry 0 (the provider's midday timestamp). */
+  uint32_t dailyStartEpoch;
+  /** @brief Reference temperature for daily deltas. */
+  int16_t dailyBaseF;
+  /** @brief Number of valid daily entries. */
+  uint8_t dailyCount;
+  /** @brief Daily high minus dailyBaseF. */
+  int8_t dailyHighDelta[kDailyCapacity];
+  /** @brief Daily low minus dailyBaseF. */
+  int8_t dailyLowDelta[kDailyCapacity];
+  /** @brief Daily WeatherType values, low nibble = even index. */
+  uint8_t dailyTypes[kDailyCapacity / 2];
+  /** @brief Daily precipitation probability percent. */
+  uint8_t dailyPopPct[kDailyCapacity];
+
+  /**
+   * @brief Drop all hourly entries.
+   */
+  void clearHourly();
+
+  /**
+   * @brief Drop all daily entries.
+   */
+  void clearDaily();
+
+  /**
+   * @brief Append the next hourly entry; the first one sets the series start and base.
+   * @return False when full or when epoch is not exactly one hour after the previous entry.
+   */
+  bool appendHourly(uint32_t epoch, int16_t tempF, WeatherType type, uint8_t popPct);
+
+  /**
+   * @brief Append the next daily entry; the first one sets the series start and base.
+   * @return False when full.
+   */
+  bool appendDaily(uint32_t epoch, int16_t highF, int16_t lowF, WeatherType type, uint8_t popPct);
+
+  /** @brief UTC epoch of hourly entry i. */
+  uint32_t hourlyEpoch(uint8_t i) const;
+  /** @brief Temperature of hourly entry i in Fahrenheit. */
+  int16_t hourlyTempF(uint8_t i) const;
+  /** @brief Weather type of hourly entry i. */
+  WeatherType hourlyType(uint8_t i) const;
+
+  /** @brief Approximate UTC epoch of daily entry i (exact to within a DST hour). */
+  uint32_t dailyEpoch(uint8_t i) const;
+  /** @brief High temperature of daily entry i in Fahrenheit. */
+  int16_t dailyHighF(uint8_t i) const;
+  /** @brief Low temperature of daily entry i in Fahrenheit. */
+  int16_t dailyLowF(uint8_t i) const;
+  /** @brief Weather type of daily entry i. */
+  WeatherType dailyType(uint8_t i) const;
+
+  /**
+   * @brief Bytes the same data would take as an array of naive per-entry structs.
+   */
+  static size_t naiveFootprintBytes();
+
+#if WEATHERCLOCK_BENCH
+  /**
+   * @brief Print SoA vs array-of-structs footprint to Serial.
+   */
+  static void logFootprint();
+#endif
+};
@@ -0,0 +1,138 @@
+#include "HeapMonitor.h"
+
+#include <Arduino.h>
+#if defined(ARDUINO_ARCH_ESP32)
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+#include "DeferredLog.h"
+
+/**
+ * Read heap and stack figures from the core.
+ */
+HeapSample HeapMonitor::sample() {
+  HeapSample s{};
+  s.freeBytes = ESP.getFreeHeap();
+#if defined(ARDUINO_ARCH_ESP8266)
+  s.largestBlock = ESP.getMaxFreeBlockSize();
+  s.fragmentationPct = ESP.getHeapFragmentation();
+  // Free bytes below the deepest stack use so far (the cont stack is pattern-painted).
+  s.stackFree = ESP.getFreeContStack();
+#else
+  s.largestBlock = ESP.getMaxAllocHeap();
+  s.fragmentationPct =
+      s.freeBytes == 0 ? 0 : static_cast<uint8_t>(100 - (static_cast<uint64_t>(s.largestBlock) * 100) / s.freeBytes);
+  // ESP-IDF reports the loop task's high-water mark in bytes.
+  s.stackFree = uxTaskGetStackHighWaterMark(nullptr);
+#endif
+  return s;
+}
+
+/**
+ * Record the pre-phase sample.
+ */
+void HeapMonitor::begin(HeapPhase phase) {
+  const uint8_t idx = static_cast<uint8_t>(phase);
+  before_[idx] = sample();
+  fold(phases_[idx], before_[idx]);
+  fold(overall_, before_[idx]);
+}
+
+/**
+ * Record the post-phase sample and log the delta.
+ */
+void HeapMonitor::end(HeapPhase phase) {
+  const uint8_t idx = static_cast<uint8_t>(phase);
+  const HeapSample after = sample();
+  fold(phases_[idx], after);
+  fold(overall_, after);
+
+  const HeapSample& before = before_[idx];
+  LOG_INFO(HeapPhase, phaseName(phase), before.freeBytes, after.freeBytes, before.largestBlock, after.largestBlock,
+           before.fragmentationPct, after.fragmentationPct, after.stackFree, phases_[idx].largestBlock.min);
+}
+
+/**
+ * Fold the post-sync largest block and log its drift from the first sync.
+ */
+void HeapMonitor::endSync() {
+  const HeapSample after = sample();
+  foldMetric(syncBlock_, after.largestBlock, syncs_ == 0);
+  if (syncs_ == 0) {
+    firstSyncBlock_ = after.largestBlock;
+  }
+  ++syncs_;
+
+  LOG_INFO(HeapSync, syncs_, after.largestBlock, firstSyncBlock_, syncBlock_.min,
+           static_cast<int32_t>(after.largestBlock - firstSyncBlock_));
+}
+
+/**
+ * Return the post-sync largest-block trend.
+ */
+const HeapMetric& HeapMonitor::syncLargestBlock() const {
+  return syncBlock_;
+}
+
+/**
+ * Return how many syncs endSync() has seen.
+ */
+uint32_t HeapMonitor::syncCount() const {
+  return syncs_;
+}
+
+/**
+ * Return stats for one phase.
+ */
+const HeapPhaseStats& HeapMonitor::stats(HeapPhase phase) const {
+  return phases_[static_cast<uint8_t>(phase)];
+}
+
+/**
+ * Return stats across all phases.
+ */
+const HeapPhaseStats& HeapMonitor::overall() const {
+  return overall_;
+}
+
+/**
+ * Map a phase to its log/page label.
+ */
+const char* HeapMonitor::phaseName(HeapPhase phase) {
+  switch (phase) {
+    case HeapPhase::Geocode:
+      return "geocode";
+    case HeapPhase::OneCallRead:
+      return "read";
+    case HeapPhase::Parse:
+      return "parse";
+  }
+  return "?";
+}
+
+/**
+ * Fold one sample into a stats block.
+ */
+void HeapMonitor::fold(HeapPhaseStats& stats, const HeapSample& sample) {
+  const bool first = stats.samples == 0;
+  foldMetric(stats.freeBytes, sample.freeBytes, first);
+  foldMetric(stats.largestBlock, sample.largestBlock, first);
+  foldMetric(stats.fragmentationPct, sample.fragmentationPct, first);
+  foldMetric(stats.stackFree, sample.stackFree, first);
+  if (stats.samples < UINT16_MAX) {
+    ++stats.samples;
+  }
+}
+
+/**
+ * Update min/max/last for one metric.
+ */
+void HeapMonitor::foldMetric(HeapMetric& metric, uint32_t value, bool first) {
+  if (first || value < metric.min) {
+    metric.min = value;
+  }
+  if (first || value > metric.max) {
+    metric.max = value;
+  }
+  metric.last = value;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Sync phases bracketed by heap samples.
+ */
+enum class HeapPhase : uint8_t {
+  Geocode,
+  OneCallRead,
+  Parse
+};
+
+/** @brief Number of HeapPhase values. */
+constexpr uint8_t kHeapPhaseCount = 3;
+
+/**
+ * @brief One heap/stack snapshot.
+ */
+struct HeapSample {
+  /** @brief Total free heap bytes. */
+  uint32_t freeBytes;
+  /** @brief Largest single allocatable block. */
+  uint32_t largestBlock;
+  /** @brief 100 - largest * 100 / free; 0 means one contiguous region. */
+  uint8_t fragmentationPct;
+  /** @brief Lowest free stack seen so far for the loop task (high-water mark). */
+  uint32_t stackFree;
+};
+
+/**
+ * @brief Min/max/last of one metric.
+ */
+struct HeapMetric {
+  uint32_t min;
+  uint32_t max;
+  uint32_t last;
+};
+
+/**
+ * @brief Accumulated samples for one phase (before and after samples both count).
+ */
+struct HeapPhaseStats {
+  HeapMetric freeBytes;
+  HeapMetric largestBlock;
+  HeapMetric fragmentationPct;
+  HeapMetric stackFree;
+  /** @brief Samples folded in; 0 means the metrics are unset. */
+  uint16_t samples;
+};
+
+/**
+ * @brief Samples free heap, largest block, fragmentation and stack around sync phases.
+ *
+ * Each begin()/end() pair records a sample before and after the phase and
+ * logs the change, so slow fragmentation shows up as a falling largest-block
+ * minimum long before an allocation fails.
+ */
+class HeapMonitor {
+ public:
+  /**
+   * @brief Take a snapshot of the current heap and stack.
+   */
+  static HeapSample sample();
+
+  /**
+   * @brief Sample before a phase starts.
+   */
+  void begin(HeapPhase phase);
+
+  /**
+   * @brief Sample after a phase ends and log the before/after change.
+   */
+  void end(HeapPhase phase);
+
+  /**
+   * @brief Sample once a whole sync has finished and log the largest block against the first sync.
+   *
+   * Request objects are idle by then, so a value that keeps falling from one
+   * sync to the next is fragmentation rather than a request in flight.
+   */
+  void endSync();
+
+  /**
+   * @brief Largest block seen by endSync(); last is the most recent sync.
+   */
+  const HeapMetric& syncLargestBlock() const;
+
+  /**
+   * @brief Syncs folded into syncLargestBlock().
+   */
+  uint32_t syncCount() const;
+
+  /**
+   * @brief Stats for one phase.
+   */
+  const HeapPhaseStats& stats(HeapPhase phase) const;
+
+  /**
+   * @brief Stats across all phases.
+   */
+  const HeapPhaseStats& overall() const;
+
+  /**
+   * @brief Short lowercase phase label.
+   */
+  static const char* phaseName(HeapPhase phase);
+
+ private:
+  static void fold(HeapPhaseStats& stats, const HeapSample& sample);
+  static void foldMetric(HeapMetric& metric, uint32_t value, bool first);
+
+  HeapPhaseStats phases_[kHeapPhaseCount] = {};
+  HeapPhaseStats overall_ = {};
+  HeapSample before_[kHeapPhaseCount] = {};
+  HeapMetric syncBlock_ = {};
+  uint32_t firstSyncBlock_ = 0;
+  uint32_t syncs_ = 0;
+};
@@ -0,0 +1,217 @@
+#include "JsonStreamScanner.h"
+
+#include <string.h>
+
+/**
+ * Bind the scanner to its event sink.
+ */
+JsonStreamScanner::JsonStreamScanner(Callback callback, void* context) : callback_(callback), context_(context) {
+  reset();
+}
+
+/**
+ * Clear all tokenizer state for a new document.
+ */
+void JsonStreamScanner::reset() {
+  key_[0] = '\0';
+  value_[0] = '\0';
+  valueLength_ = 0;
+  objectMask_ = 0;
+  depth_ = 0;
+  unicodeSkip_ = 0;
+  inString_ = false;
+  escape_ = false;
+  inLiteral_ = false;
+  expectKey_ = false;
+  stringIsKey_ = false;
+  failed_ = false;
+}
+
+/**
+ * Feed a chunk byte by byte.
+ */
+void JsonStreamScanner::feed(const char* data, size_t length) {
+  for (size_t i = 0; i < length && !failed_; ++i) {
+    feed(data[i]);
+  }
+}
+
+/**
+ * Advance the tokenizer by one byte, emitting events as tokens complete.
+ */
+void JsonStreamScanner::feed(char c) {
+  if (failed_) {
+    return;
+  }
+
+  if (inString_) {
+    if (unicodeSkip_ > 0) {
+      --unicodeSkip_;
+      return;
+    }
+    if (escape_) {
+      escape_ = false;
+      switch (c) {
+        case 'n':
+        case 'r':
+        case 't':
+          appendValue(' ');
+          break;
+        case 'u':
+          // The OLED font is ASCII only; one placeholder per escaped code unit.
+          appendValue('?');
+          unicodeSkip_ = 4;
+          break;
+        case 'b':
+        case 'f':
+          break;
+        default:
+          appendValue(c);
+          break;
+      }
+      return;
+    }
+    if (c == '\\') {
+      escape_ = true;
+      return;
+    }
+    if (c == '"') {
+      inString_ = false;
+      if (stringIsKey_) {
+        strncpy(key_, value_, kKeySize - 1);
+        key_[kKeySize - 1] = '\0';
+        expectKey_ = false;
+      } else {
+        emit(Event::Value);
+      }
+      return;
+    }
+    appendValue(c);
+    return;
+  }
+
+  if (inLiteral_) {
+    const bool delimiter = c == ',' || c == '}' || c == ']' || c == ' ' || c == '\n' || c == '\r' || c == '\t';
+    if (!delimiter) {
+      appendValue(c);
+      return;
+    }
+    // The delimiter still has structural meaning; fall through and handle it.
+    finishLiteral();
+  }
+
+  switch (c) {
+    case ' ':
+    case '\n':
+    case '\r':
+    case '\t':
+    case ':':
+      return;
+    case '"':
+      inString_ = true;
+      stringIsKey_ = inObject() && expectKey_;
+      valueLength_ = 0;
+      value_[0] = '\0';
+      return;
+    case '{':
+    case '[':
+      if (depth_ >= kMaxDepth) {
+        failed_ = true;
+        return;
+      }
+      ++depth_;
+      if (c == '{') {
+        objectMask_ = static_cast<uint16_t>(objectMask_ | (1U << (depth_ - 1)));
+      } else {
+        objectMask_ = static_cast<uint16_t>(objectMask_ & ~(1U << (depth_ - 1)));
+      }
+      emit(c == '{' ? Event::ObjectStart : Event::ArrayStart);
+      expectKey_ = (c == '{');
+      return;
+    case '}':
+    case ']':
+      if (depth_ == 0 || inObject() != (c == '}')) {
+        failed_ = true;
+        return;
+      }
+      emit(c == '}' ? Event::ObjectEnd : Event::ArrayEnd);
+      --depth_;
+      expectKey_ = false;
+      return;
+    case ',':
+      expectKey_ = inObject();
+      return;
+    default:
+      inLiteral_ = true;
+      valueLength_ = 0;
+      value_[0] = '\0';
+      appendValue(c);
+      return;
+  }
+}
+
+/**
+ * Deliver one event, then drop the key so it never leaks onto the next token.
+ */
+void JsonStreamScanner::emit(Event event) {
+  if (event == Event::ObjectEnd || event == Event::ArrayEnd) {
+    key_[0] = '\0';
+  }
+  if (callback_ != nullptr) {
+    callback_(context_, event, *this);
+  }
+  key_[0] = '\0';
+}
+
+/**
+ * Append to the value buffer, silently truncating long text.
+ */
+void JsonStreamScanner::appendValue(char c) {
+  if (valueLength_ + 1 < kValueSize) {
+    value_[valueLength_++] = c;
+    value_[valueLength_] = '\0';
+  }
+}
+
+/**
+ * Close a bare number/true/false/null token.
+ */
+void JsonStreamScanner::finishLiteral() {
+  inLiteral_ = false;
+  emit(Event::Value);
+}
+
+/**
+ * True when the innermost open container is an object.
+ */
+bool JsonStreamScanner::inObject() const {
+  return depth_ > 0 && ((objectMask_ >> (depth_ - 1)) & 1U) != 0;
+}
+
+/**
+ * Return current member key.
+ */
+const char* JsonStreamScanner::key() const {
+  return key_;
+}
+
+/**
+ * Return current scalar text.
+ */
+const char* JsonStreamScanner::value() const {
+  return value_;
+}
+
+/**
+ * Return current nesting depth.
+ */
+uint8_t JsonStreamScanner::depth() const {
+  return depth_;
+}
+
+/**
+ * Return true after a structural error.
+ */
+bool JsonStreamScanner::failed() const {
+  return failed_;
+}
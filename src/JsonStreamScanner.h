@@ -0,0 +1,99 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Incremental JSON tokenizer that works one byte at a time.
+ *
+ * The scanner never holds the document. It reports container boundaries and
+ * scalar values through a callback, together with the member key and the
+ * nesting depth. This lets HTTP bodies be parsed straight off the socket.
+ * Keys and values longer than the internal buffers are truncated, not rejected.
+ */
+class JsonStreamScanner {
+ public:
+  /**
+   * @brief Token reported to the callback.
+   */
+  enum class Event : uint8_t {
+    ObjectStart,
+    ObjectEnd,
+    ArrayStart,
+    ArrayEnd,
+    Value
+  };
+
+  /**
+   * @brief Receives scanner events.
+   * @param context Caller-owned state passed to the constructor.
+   * @param event Token kind.
+   * @param scanner Scanner; read key(), value() and depth() during the call.
+   */
+  using Callback = void (*)(void* context, Event event, const JsonStreamScanner& scanner);
+
+  /**
+   * @brief Construct a scanner bound to one callback.
+   */
+  JsonStreamScanner(Callback callback, void* context);
+
+  /**
+   * @brief Feed a block of bytes.
+   */
+  void feed(const char* data, size_t length);
+
+  /**
+   * @brief Feed one byte.
+   */
+  void feed(char c);
+
+  /**
+   * @brief Reset to the start-of-document state.
+   */
+  void reset();
+
+  /**
+   * @brief Member key of the current token, or "" for array elements and container ends.
+   */
+  const char* key() const;
+
+  /**
+   * @brief Text of the current Value token (string contents or literal such as 123, true, null).
+   */
+  const char* value() const;
+
+  /**
+   * @brief Open containers, counting the one a Start/End event refers to.
+   */
+  uint8_t depth() const;
+
+  /**
+   * @brief True once the input broke JSON structure; later bytes are ignored.
+   */
+  bool failed() const;
+
+ private:
+  static constexpr uint8_t kMaxDepth = 16;
+  static constexpr size_t kKeySize = 16;
+  static constexpr size_t kValueSize = 40;
+
+  void emit(Event event);
+  void appendValue(char c);
+  void finishLiteral();
+  bool inObject() const;
+
+  Callback callback_;
+  void* context_;
+  char key_[kKeySize];
+  char value_[kValueSize];
+  size_t valueLength_ = 0;
+  uint16_t objectMask_ = 0;  // Bit n set when container at depth n+1 is an object.
+  uint8_t depth_ = 0;
+  uint8_t unicodeSkip_ = 0;
+  bool inString_ = false;
+  bool escape_ = false;
+  bool inLiteral_ = false;
+  bool expectKey_ = false;
+  bool stringIsKey_ = false;
+  bool failed_ = false;
+};
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Every deferred log message: X(id, format).
+ *
+ * Records carry only the id and binary arguments; the format text lives in
+ * flash and is applied by the serial flusher or by tools/decode_log.py, which
+ * parses this table. Append new entries at the end so ids in saved dumps stay
+ * valid. Conversions: %d (signed), %u (unsigned), %x, %s, with optional
+ * 0-flag and width; every numeric argument is 32-bit.
+ */
+#define WEATHERCLOCK_LOG_MESSAGES(X)                                                                  \
+  X(OwmGeocodeRequest, "[OWM] Geocode request: zip=%s")                                               \
+  X(OwmGeocodeBeginFailed, "[OWM] Geocode begin() failed")                                            \
+  X(OwmGeocodeHttpError, "[OWM] Geocode HTTP error: %d")                                              \
+  X(OwmGeocodeResponse, "[OWM] Geocode response: %s")                                                 \
+  X(OwmGeocodeParseFailed, "[OWM] Failed to parse lat/lon from geocode payload: %s")                  \
+  X(OwmGeocodeSuccess, "[OWM] Geocode success lat/lon: %s, %s")                                       \
+  X(OwmGivingUp, "[OWM] %s giving up this sync, next attempt in ms=%u")                               \
+  X(OwmRequest, "[OWM] %s request (attempt %u): lat=%s lon=%s exclude=%s")                            \
+  X(OwmBeginFailed, "[OWM] %s begin() failed")                                                        \
+  X(OwmHttpError, "[OWM] %s HTTP error: %d")                                                          \
+  X(OwmHttpErrorBody, "[OWM] %s response: %s")                                                        \
+  X(OwmResponseHeaders, "[OWM] %s Content-Length: %s Content-Encoding: %s Transfer-Encoding: %s")     \
+  X(OwmPayloadLength, "[OWM] %s payload length=%u")                                                   \
+  X(OwmPartialPayload, "[OWM] %s partial payload: got %u expected %d")                                \
+  X(OwmTimezone, "[OWM] Timezone from API: iana='%s' offsetSec=%d")                                   \
+  X(OwmCurrentParseFailed, "[OWM] Failed to parse current temp/weather id, currentStart=%d")          \
+  X(OwmPayloadHead, "[OWM] payload head: %s")                                                         \
+  X(OwmHourlyStored, "[OWM] Hourly entries stored=%u")                                                \
+  X(OwmDailyInsufficient, "[OWM] Insufficient daily JSON entries. parsedDailyCount=%d")               \
+  X(OwmDailyRowsFailed, "[OWM] Failed to populate 4-day rows from JSON. filled=%d")                   \
+  X(OwmDailyTierFailed, "[OWM] Daily tier failed; keeping previous daily rows")                       \
+  X(OwmDailyTierSkipped, "[OWM] Daily tier fresh; skipped")                                           \
+  X(OwmWeatherSuccess, "[OWM] Weather success: tempF=%d type=%u rain=%u%% wind=%u gust=%u")           \
+  X(OwmTierBytes, "[OWM] Tier bytes: sync=%u core=%u daily=%u avg=%u")                                \
+  X(OwmTierBytesSaved, "[OWM] Tier bytes: sync=%u core=%u daily=%u avg=%u untiered~%u saved=%u%%")    \
+  X(OwmMissingConfig, "[OWM] Missing config or WiFi down. zip='%s' apiKeyLen=%u wifi=%d")             \
+  X(OwmSkippingRefresh, "[OWM] Skipping refresh: backoff/breaker, next attempt in ms=%u")             \
+  X(OwmSkippingSection, "[OWM] Skipping %s: backoff/breaker, next attempt in ms=%u")                  \
+  X(OwmStreamRequest, "[OWM] %s request: lat=%s lon=%s exclude=%s")                                   \
+  X(OwmStreamIncomplete, "[OWM] %s payload incomplete/malformed, bytes=%u")                           \
+  X(OwmAlerts, "[OWM] Alerts: bytes=%u received=%u kept=%u")                                          \
+  X(OwmAlert, "[OWM] Alert %u: '%s' start=%u end=%u")                                                 \
+  X(OwmNowcastEmpty, "[OWM] Nowcast payload had no minutely entries")                                 \
+  X(OwmNowcast, "[OWM] Nowcast: bytes=%u samples=%u peakQ=%u")                                        \
+  X(OwmParsedCurrent, "[OWM] Current: temp=%dF feels=%dF rain=%u%% wind=%umph gust=%umph deg=%u")     \
+  X(OwmParsedToday, "[OWM] Today: high=%d low=%d sunrise=%u:%02u sunset=%u:%02u")                     \
+  X(OwmParsedHourly, "[OWM] Hourly[%u]: h=%u temp=%d main=%s type=%u")                                \
+  X(OwmParsedDaily, "[OWM] Daily[%u]: dow=%u high=%d low=%d main=%s type=%u")                         \
+  X(OwmParsedAdvisory, "[OWM] Advisory: %s")                                                          \
+  X(OwmUrlTooLong, "[OWM] %s URL exceeds %u bytes")                                                  \
+  X(OwmMflnSelected, "[OWM] TLS MFLN %u accepted by %s: rx=%u tx=%u, %u bytes less per connection")   \
+  X(OwmMflnUnsupported, "[OWM] TLS MFLN not accepted by %s, keeping rx=%u tx=%u")                     \
+  X(OwmTlsBuffers, "[OWM] TLS connect rx=%u tx=%u saved=%u freeHeap=%u")                             \
+  X(HeapPhase, "[HEAP] %s free=%u->%u block=%u->%u frag=%u->%u%% stack=%u minBlock=%u")              \
+  X(HeapSync, "[HEAP] sync #%u block=%u first=%u min=%u drift=%d")                                    \
+  X(PlanNext, "[PLAN] calls today=%u/%u interval=%us offset=%us next in %us")                         \
+  X(SyncPlannedDue, "[SYNC] Planned sync due, syncing")                                               \
+  X(SyncRetryDue, "[SYNC] Retry sync: time=%s weather=%s")                                            \
+  X(SyncRevalidate, "[SYNC] Weather not fresh, running revalidation sync")                            \
+  X(SyncStarting, "[SYNC] Starting hourly sync")                                                      \
+  X(SyncClockFailed, "[SYNC] Clock refresh failed")                                                   \
+  X(SyncRelayCovers, "[SYNC] Relay leader active with fresh data, skipping own weather fetch")        \
+  X(SyncWeatherFailed, "[SYNC] Weather refresh failed, keeping cached data")                          \
+  X(SyncApplyOffset, "[SYNC] Applying API timezone offset: %d")                                       \
+  X(SyncCompleted, "[SYNC] Completed. time=%s weather=%s")                                            \
+  X(SyncNowcastDue, "[SYNC] Nowcast due, pop=%u")                                                     \
+  X(SyncNowcastSkipped, "[SYNC] Nowcast skipped, no spare calls in today's budget")                   \
+  X(AlertRefreshSkipped, "[ALERT] Refresh skipped, no spare calls in today's budget")                 \
+  X(CacheCounts, "[CACHE] Syncs on hit=%u stale=%u expired=%u")                                       \
+  X(SunApiDelta, "[SUN] Local vs API delta sunrise=%dmin sunset=%dmin")                               \
+  X(SunToday, "[SUN] Local sunrise/sunset today %u:%02u / %u:%02u valid=%s")                          \
+  X(TimeOffsetSet, "[TIME] UTC offset set to seconds: %d")                                            \
+  X(TimeNtpSkipped, "[TIME] NTP sync skipped by backoff/breaker")                                     \
+  X(TimeNtpStarting, "[TIME] Starting NTP sync (attempt 1)")                                          \
+  X(TimeNtpFirstOk, "[TIME] NTP sync succeeded on attempt 1 after ms: %u")                            \
+  X(TimeNtpSecondTry, "[TIME] NTP sync attempt 1 failed, trying attempt 2")                           \
+  X(TimeNtpSecondResult, "[TIME] NTP sync attempt 2 result: %s")                                      \
+  X(TimeClockInvalid, "[TIME] refreshClockData failed: system time not valid yet")                    \
+  X(InterpError, "[INTERP] Error tenthsF interp=%u held=%u | mean interp=%u held=%u max=%u n=%u")     \
+  X(SnapMountFailed, "[SNAP] LittleFS mount failed")                                                  \
+  X(SnapVersionMismatch, "[SNAP] Snapshot missing or from another layout version")                    \
+  X(SnapLengthMismatch, "[SNAP] Snapshot length mismatch")                                            \
+  X(SnapCrcMismatch, "[SNAP] Snapshot CRC mismatch")                                                  \
+  X(SnapDecodeFailed, "[SNAP] Snapshot payload decode failed")                                        \
+  X(SnapLoaded, "[SNAP] Loaded snapshot bytes=%u fetchedAt=%u")                                       \
+  X(SnapEncodeFailed, "[SNAP] Snapshot encode failed")                                                \
+  X(SnapUnchanged, "[SNAP] Snapshot unchanged, skipping write")                                       \
+  X(SnapRateLimited, "[SNAP] Snapshot write deferred by rate limit")                                  \
+  X(SnapOpenFailed, "[SNAP] Failed to open snapshot for write")                                       \
+  X(SnapWriteShort, "[SNAP] Snapshot write short")                                                    \
+  X(SnapWritten, "[SNAP] Snapshot written bytes=%u writes=%u")                                        \
+  X(JsonOverflow, "[JSON] Weather snapshot exceeded buffer")                                          \
+  X(JsonBuilt, "[JSON] Weather snapshot generation=%u bytes=%u us=%u")                                \
+  X(HistMountFailed, "[HIST] LittleFS mount failed")                                                  \
+  X(HistLoaded, "[HIST] Loaded log records=%u rejected=%u hours=%u")                                  \
+  X(HistAppendOpenFailed, "[HIST] Failed to open log for append")                                     \
+  X(HistAppendShort, "[HIST] Log append short")                                                       \
+  X(HistCompactOpenFailed, "[HIST] Failed to open compaction file")                                   \
+  X(HistCompactShort, "[HIST] Compaction write short")                                                \
+  X(HistCompactRenameFailed, "[HIST] Compaction rename failed")                                       \
+  X(HistCompacted, "[HIST] Log compacted records=%u compactions=%u")                                  \
+  X(RetryHalfOpen, "[RETRY] %s breaker half-open, allowing probe")                                    \
+  X(RetryClosed, "[RETRY] %s breaker closed")                                                         \
+  X(RetryFailure, "[RETRY] %s failure #%u next attempt in ms=%u retryAfterMs=%u breaker=%s")
+
+/**
+ * @brief Message ids in table order.
+ */
+enum class LogId : uint16_t {
+#define WEATHERCLOCK_LOG_ID(id, format) id,
+  WEATHERCLOCK_LOG_MESSAGES(WEATHERCLOCK_LOG_ID)
+#undef WEATHERCLOCK_LOG_ID
+  Count
+};
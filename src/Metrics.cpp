@@ -0,0 +1,332 @@
+#include "Metrics.h"
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <stdio.h>
+
+namespace {
+// Geocode and parse finish in tens of ms; a OneCall read over TLS can take seconds.
+const uint32_t kPhaseMsBounds[] = {50, 100, 250, 500, 1000, 2500, 5000, 10000, 20000};
+// Streamed sections are a few hundred bytes; core/daily bodies run to ~30 KB.
+const uint32_t kPayloadBytesBounds[] = {512, 1024, 2048, 4096, 8192, 16384, 24576, 32768};
+// An idle loop is well under 1 ms; a full frame flush over I2C is ~25 ms.
+const uint32_t kLoopUsBounds[] = {500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000, 1000000};
+
+constexpr size_t kChunkSize = 512;
+
+/**
+ * Decimal text of a 64-bit value; printf's %llu is not reliable on every core.
+ */
+const char* u64Text(uint64_t value, char (&buf)[21]) {
+  char* p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  do {
+    *--p = static_cast<char>('0' + value % 10);
+    value /= 10;
+  } while (value != 0);
+  return p;
+}
+}  // namespace
+
+/**
+ * Fixed-buffer line writer that hands full chunks to the caller.
+ */
+class Metrics::Formatter {
+ public:
+  Formatter(Writer writer, void* context) : writer_(writer), context_(context) {}
+
+  /**
+   * Append one formatted line, flushing first if it would not fit.
+   */
+  void line(const char* format, ...) {
+    for (uint8_t attempt = 0; attempt < 2; ++attempt) {
+      va_list args;
+      va_start(args, format);
+      const int n = vsnprintf(buf_ + used_, kChunkSize - used_, format, args);
+      va_end(args);
+      if (n < 0) {
+        return;
+      }
+      if (static_cast<size_t>(n) < kChunkSize - used_) {
+        used_ += static_cast<size_t>(n);
+        return;
+      }
+      if (used_ == 0) {
+        // Longer than a whole chunk; cannot happen with the fixed metric names.
+        return;
+      }
+      flush();
+    }
+  }
+
+  /**
+   * Hand any buffered text to the writer.
+   */
+  void flush() {
+    if (used_ > 0) {
+      writer_(context_, buf_, used_);
+      total_ += used_;
+      used_ = 0;
+    }
+  }
+
+  size_t total() const {
+    return total_;
+  }
+
+ private:
+  Writer writer_;
+  void* context_;
+  char buf_[kChunkSize];
+  size_t used_ = 0;
+  size_t total_ = 0;
+};
+
+/**
+ * Point every histogram at its bound table.
+ */
+Metrics::Metrics() {
+  for (uint8_t i = 0; i < kHeapPhaseCount; ++i) {
+    phaseMs_[i].bounds = kPhaseMsBounds;
+    phaseMs_[i].boundCount = sizeof(kPhaseMsBounds) / sizeof(kPhaseMsBounds[0]);
+  }
+  payloadBytes_.bounds = kPayloadBytesBounds;
+  payloadBytes_.boundCount = sizeof(kPayloadBytesBounds) / sizeof(kPayloadBytesBounds[0]);
+  loopUs_.bounds = kLoopUsBounds;
+  loopUs_.boundCount = sizeof(kLoopUsBounds) / sizeof(kLoopUsBounds[0]);
+  static_assert(sizeof(kPhaseMsBounds) / sizeof(kPhaseMsBounds[0]) <= kMaxBounds, "too many phase buckets");
+  static_assert(sizeof(kPayloadBytesBounds) / sizeof(kPayloadBytesBounds[0]) <= kMaxBounds, "too many payload buckets");
+  static_assert(sizeof(kLoopUsBounds) / sizeof(kLoopUsBounds[0]) <= kMaxBounds, "too many loop buckets");
+}
+
+/**
+ * Remember when a phase started.
+ */
+void Metrics::beginPhase(HeapPhase phase) {
+  phaseStartMs_[static_cast<uint8_t>(phase)] = millis();
+}
+
+/**
+ * Add the elapsed phase time to its histogram.
+ */
+void Metrics::endPhase(HeapPhase phase) {
+  const uint8_t idx = static_cast<uint8_t>(phase);
+  observe(phaseMs_[idx], millis() - phaseStartMs_[idx]);
+}
+
+/**
+ * Record one response body size.
+ */
+void Metrics::observePayloadBytes(uint32_t bytes) {
+  observe(payloadBytes_, bytes);
+}
+
+/**
+ * Bump the counter for one status code; codes beyond the table share one bucket.
+ */
+void Metrics::recordHttpFailure(int code) {
+  for (uint8_t i = 0; i < failureCodeCount_; ++i) {
+    if (failures_[i].code == code) {
+      ++failures_[i].count;
+      return;
+    }
+  }
+  if (failureCodeCount_ < kMaxFailureCodes) {
+    failures_[failureCodeCount_].code = static_cast<int16_t>(code);
+    failures_[failureCodeCount_].count = 1;
+    ++failureCodeCount_;
+    return;
+  }
+  ++otherFailures_;
+}
+
+/**
+ * Count one in-sync retry.
+ */
+void Metrics::recordRetry() {
+  ++retries_;
+}
+
+/**
+ * Count one finished sync by outcome.
+ */
+void Metrics::recordSync(bool ok) {
+  if (ok) {
+    ++syncsOk_;
+  } else {
+    ++syncsFailed_;
+  }
+}
+
+/**
+ * Record loop time; loop() runs far more often than millis() wraps, so this also catches the wrap.
+ */
+void Metrics::observeLoop(uint32_t loopUs) {
+  observe(loopUs_, loopUs);
+  const uint32_t nowMs = millis();
+  if (nowMs < lastLoopMillis_) {
+    ++millisWraps_;
+  }
+  lastLoopMillis_ = nowMs;
+}
+
+/**
+ * Return seconds since boot including millis() wraps.
+ */
+uint32_t Metrics::uptimeSeconds() const {
+  const uint64_t ms = (static_cast<uint64_t>(millisWraps_) << 32) | millis();
+  return static_cast<uint32_t>(ms / 1000ULL);
+}
+
+/**
+ * Add one observation to the first bucket whose bound it does not exceed.
+ */
+void Metrics::observe(Histogram& histogram, uint32_t value) {
+  uint8_t bucket = 0;
+  while (bucket < histogram.boundCount && value > histogram.bounds[bucket]) {
+    ++bucket;
+  }
+  ++histogram.buckets[bucket];
+  ++histogram.count;
+  histogram.sum += value;
+}
+
+/**
+ * Emit cumulative _bucket lines plus _sum and _count.
+ */
+void Metrics::renderHistogram(Formatter& out, const char* name, const char* labels, const Histogram& histogram) {
+  const char* sep = labels[0] != '\0' ? "," : "";
+  uint32_t cumulative = 0;
+  for (uint8_t i = 0; i < histogram.boundCount; ++i) {
+    cumulative += histogram.buckets[i];
+    out.line("%s_bucket{%s%sle=\"%lu\"} %lu\n", name, labels, sep, static_cast<unsigned long>(histogram.bounds[i]),
+             static_cast<unsigned long>(cumulative));
+  }
+  out.line("%s_bucket{%s%sle=\"+Inf\"} %lu\n", name, labels, sep, static_cast<unsigned long>(histogram.count));
+  char sumText[21];
+  if (labels[0] != '\0') {
+    out.line("%s_sum{%s} %s\n", name, labels, u64Text(histogram.sum, sumText));
+    out.line("%s_count{%s} %lu\n", name, labels, static_cast<unsigned long>(histogram.count));
+  } else {
+    out.line("%s_sum %s\n", name, u64Text(histogram.sum, sumText));
+    out.line("%s_count %lu\n", name, static_cast<unsigned long>(histogram.count));
+  }
+}
+
+/**
+ * Format every metric family into fixed-size chunks.
+ */
+size_t Metrics::render(const MetricsGauges& gauges, Writer writer, void* context) const {
+  Formatter out(writer, context);
+  char labels[24];
+
+  out.line("# HELP weatherclock_sync_phase_duration_ms Wall time of each sync phase.\n");
+  out.line("# TYPE weatherclock_sync_phase_duration_ms histogram\n");
+  for (uint8_t i = 0; i < kHeapPhaseCount; ++i) {
+    snprintf(labels, sizeof(labels), "phase=\"%s\"", HeapMonitor::phaseName(static_cast<HeapPhase>(i)));
+    renderHistogram(out, "weatherclock_sync_phase_duration_ms", labels, phaseMs_[i]);
+  }
+
+  out.line("# HELP weatherclock_payload_bytes Body size of completed OpenWeather responses.\n");
+  out.line("# TYPE weatherclock_payload_bytes histogram\n");
+  renderHistogram(out, "weatherclock_payload_bytes", "", payloadBytes_);
+
+  out.line("# HELP weatherclock_loop_duration_us Duration of one loop() iteration.\n");
+  out.line("# TYPE weatherclock_loop_duration_us histogram\n");
+  renderHistogram(out, "weatherclock_loop_duration_us", "", loopUs_);
+
+  out.line("# HELP weatherclock_http_failures_total Failed OpenWeather requests by status code.\n");
+  out.line("# TYPE weatherclock_http_failures_total counter\n");
+  for (uint8_t i = 0; i < failureCodeCount_; ++i) {
+    const int16_t code = failures_[i].code;
+    const unsigned long count = static_cast<unsigned long>(failures_[i].count);
+    if (code == kCodeBeginFailed) {
+      out.line("weatherclock_http_failures_total{code=\"begin\"} %lu\n", count);
+    } else if (code == kCodeIncomplete) {
+      out.line("weatherclock_http_failures_total{code=\"incomplete\"} %lu\n", count);
+    } else {
+      out.line("weatherclock_http_failures_total{code=\"%d\"} %lu\n", static_cast<int>(code), count);
+    }
+  }
+  if (otherFailures_ > 0) {
+    out.line("weatherclock_http_failures_total{code=\"other\"} %lu\n", static_cast<unsigned long>(otherFailures_));
+  }
+
+  out.line("# HELP weatherclock_http_retries_total In-sync retries of failed OneCall requests.\n");
+  out.line("# TYPE weatherclock_http_retries_total counter\n");
+  out.line("weatherclock_http_retries_total %lu\n", static_cast<unsigned long>(retries_));
+
+  out.line("# HELP weatherclock_api_calls_total OpenWeather HTTP requests issued.\n");
+  out.line("# TYPE weatherclock_api_calls_total counter\n");
+  out.line("weatherclock_api_calls_total %lu\n", static_cast<unsigned long>(gauges.apiCalls));
+
+  out.line("# HELP weatherclock_syncs_total Finished weather syncs by outcome.\n");
+  out.line("# TYPE weatherclock_syncs_total counter\n");
+  out.line("weatherclock_syncs_total{result=\"ok\"} %lu\n", static_cast<unsigned long>(syncsOk_));
+  out.line("weatherclock_syncs_total{result=\"error\"} %lu\n", static_cast<unsigned long>(syncsFailed_));
+
+  out.line("# HELP weatherclock_frames_total OLED frames by whether they were flushed.\n");
+  out.line("# TYPE weatherclock_frames_total counter\n");
+  out.line("weatherclock_frames_total{result=\"drawn\"} %lu\n", static_cast<unsigned long>(gauges.framesDrawn));
+  out.line("weatherclock_frames_total{result=\"skipped\"} %lu\n", static_cast<unsigned long>(gauges.framesSkipped));
+
+  out.line("# HELP weatherclock_log_records_total Deferred log records by fate.\n");
+  out.line("# TYPE weatherclock_log_records_total counter\n");
+  out.line("weatherclock_log_records_total{result=\"written\"} %lu\n", static_cast<unsigned long>(gauges.logRecords));
+  out.line("weatherclock_log_records_total{result=\"overwritten\"} %lu\n",
+           static_cast<unsigned long>(gauges.logOverwritten));
+  out.line("# HELP weatherclock_log_write_cycles_total CPU cycles spent queueing log records.\n");
+  out.line("# TYPE weatherclock_log_write_cycles_total counter\n");
+  out.line("weatherclock_log_write_cycles_total %lu\n", static_cast<unsigned long>(gauges.logWriteCycles));
+
+  out.line("# HELP weatherclock_config_writes_total Config record writes to flash.\n");
+  out.line("# TYPE weatherclock_config_writes_total counter\n");
+  out.line("weatherclock_config_writes_total %lu\n", static_cast<unsigned long>(gauges.configWrites));
+  out.line("# HELP weatherclock_config_load_us Boot-time config load duration.\n");
+  out.line("# TYPE weatherclock_config_load_us gauge\n");
+  out.line("weatherclock_config_load_us %lu\n", static_cast<unsigned long>(gauges.configLoadUs));
+
+  out.line("# HELP weatherclock_relay_packets_total LAN relay packets by outcome.\n");
+  out.line("# TYPE weatherclock_relay_packets_total counter\n");
+  out.line("weatherclock_relay_packets_total{result=\"sent\"} %lu\n", static_cast<unsigned long>(gauges.relaySent));
+  out.line("weatherclock_relay_packets_total{result=\"accepted\"} %lu\n",
+           static_cast<unsigned long>(gauges.relayAccepted));
+  out.line("weatherclock_relay_packets_total{result=\"rejected\"} %lu\n",
+           static_cast<unsigned long>(gauges.relayRejected));
+
+  out.line("# HELP weatherclock_json_serializations_total /weather.json bodies built.\n");
+  out.line("# TYPE weatherclock_json_serializations_total counter\n");
+  out.line("weatherclock_json_serializations_total %lu\n", static_cast<unsigned long>(gauges.jsonSerializations));
+  out.line("# HELP weatherclock_json_not_modified_total /weather.json requests answered 304.\n");
+  out.line("# TYPE weatherclock_json_not_modified_total counter\n");
+  out.line("weatherclock_json_not_modified_total %lu\n", static_cast<unsigned long>(gauges.jsonNotModified));
+  out.line("# HELP weatherclock_json_serialize_us Duration of the last /weather.json rebuild.\n");
+  out.line("# TYPE weatherclock_json_serialize_us gauge\n");
+  out.line("weatherclock_json_serialize_us %lu\n", static_cast<unsigned long>(gauges.jsonSerializeUs));
+
+  out.line("# HELP weatherclock_screen_viewers Browsers streaming /screen.\n");
+  out.line("# TYPE weatherclock_screen_viewers gauge\n");
+  out.line("weatherclock_screen_viewers %lu\n", static_cast<unsigned long>(gauges.screenViewers));
+  out.line("# HELP weatherclock_screen_pages_total SSD1306 page updates sent to /screen viewers.\n");
+  out.line("# TYPE weatherclock_screen_pages_total counter\n");
+  out.line("weatherclock_screen_pages_total %lu\n", static_cast<unsigned long>(gauges.screenPagesSent));
+  out.line("# HELP weatherclock_screen_pass_us Duration of a /screen send pass.\n");
+  out.line("# TYPE weatherclock_screen_pass_us gauge\n");
+  out.line("weatherclock_screen_pass_us{stat=\"last\"} %lu\n", static_cast<unsigned long>(gauges.screenPassUs));
+  out.line("weatherclock_screen_pass_us{stat=\"max\"} %lu\n", static_cast<unsigned long>(gauges.screenPassMaxUs));
+
+  out.line("# HELP weatherclock_free_heap_bytes Free heap.\n");
+  out.line("# TYPE weatherclock_free_heap_bytes gauge\n");
+  out.line("weatherclock_free_heap_bytes %lu\n", static_cast<unsigned long>(gauges.freeHeapBytes));
+
+  out.line("# HELP weatherclock_largest_free_block_bytes Largest allocatable heap block.\n");
+  out.line("# TYPE weatherclock_largest_free_block_bytes gauge\n");
+  out.line("weatherclock_largest_free_block_bytes %lu\n", static_cast<unsigned long>(gauges.largestBlockBytes));
+
+  out.line("# HELP weatherclock_uptime_seconds Seconds since boot.\n");
+  out.line("# TYPE weatherclock_uptime_seconds counter\n");
+  out.line("weatherclock_uptime_seconds %lu\n", static_cast<unsigned long>(uptimeSeconds()));
+
+  out.flush();
+  return out.total();
+}
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "HeapMonitor.h"
+
+/**
+ * @brief Values owned by other services, sampled when the metrics page is rendered.
+ */
+struct MetricsGauges {
+  /** @brief Total free heap bytes. */
+  uint32_t freeHeapBytes;
+  /** @brief Largest single allocatable block. */
+  uint32_t largestBlockBytes;
+  /** @brief Frames pushed to the OLED. */
+  uint32_t framesDrawn;
+  /** @brief Frames whose buffer matched the last flush and were not sent. */
+  uint32_t framesSkipped;
+  /** @brief OpenWeather HTTP requests issued since boot. */
+  uint32_t apiCalls;
+  /** @brief Deferred log records written. */
+  uint32_t logRecords;
+  /** @brief Deferred log records overwritten before reaching the serial port. */
+  uint32_t logOverwritten;
+  /** @brief CPU cycles spent queueing deferred log records. */
+  uint32_t logWriteCycles;
+  /** @brief Config record writes to flash since boot. */
+  uint32_t configWrites;
+  /** @brief Microseconds the boot-time config load took. */
+  uint32_t configLoadUs;
+  /** @brief LAN relay data packets sent (leader). */
+  uint32_t relaySent;
+  /** @brief LAN relay packets decoded into new weather (follower). */
+  uint32_t relayAccepted;
+  /** @brief LAN relay packets dropped as malformed or stale. */
+  uint32_t relayRejected;
+  /** @brief /weather.json bodies built since boot. */
+  uint32_t jsonSerializations;
+  /** @brief /weather.json requests answered 304 from a matching ETag. */
+  uint32_t jsonNotModified;
+  /** @brief Microseconds the last /weather.json rebuild took. */
+  uint32_t jsonSerializeUs;
+  /** @brief Browsers connected to /screen. */
+  uint32_t screenViewers;
+  /** @brief /screen page events sent since boot. */
+  uint32_t screenPagesSent;
+  /** @brief Microseconds the last /screen send pass took. */
+  uint32_t screenPassUs;
+  /** @brief Longest /screen send pass since boot. */
+  uint32_t screenPassMaxUs;
+};
+
+/**
+ * @brief Counters and fixed-bucket histograms exported in Prometheus text format.
+ *
+ * Everything is preallocated: observing a value is a bucket scan and two adds,
+ * and render() formats into a small stack buffer that is handed to the caller
+ * in chunks, so scraping never builds a String or touches the heap.
+ */
+class Metrics {
+ public:
+  /**
+   * @brief Receives one chunk of rendered text.
+   * @param context Caller-owned state passed to render().
+   * @param data Chunk bytes; not NUL-terminated and only valid during the call.
+   * @param length Chunk size.
+   */
+  using Writer = void (*)(void* context, const char* data, size_t length);
+
+  /** @brief Pseudo status code for requests whose begin() failed before any HTTP exchange. */
+  static constexpr int16_t kCodeBeginFailed = 0;
+  /** @brief Pseudo status code for 200 responses with a partial, empty or malformed body. */
+  static constexpr int16_t kCodeIncomplete = 1;
+
+  /**
+   * @brief Bind each histogram to its bucket bounds.
+   */
+  Metrics();
+
+  /**
+   * @brief Start timing a sync phase.
+   */
+  void beginPhase(HeapPhase phase);
+
+  /**
+   * @brief Stop timing a sync phase and add its duration to the phase histogram.
+   */
+  void endPhase(HeapPhase phase);
+
+  /**
+   * @brief Record the body size of one completed API response.
+   */
+  void observePayloadBytes(uint32_t bytes);
+
+  /**
+   * @brief Count one failed API request.
+   * @param code HTTP status, negative HTTPClient transport error, or one of the kCode* pseudo codes.
+   */
+  void recordHttpFailure(int code);
+
+  /**
+   * @brief Count one in-sync retry of a failed request.
+   */
+  void recordRetry();
+
+  /**
+   * @brief Count one finished sync.
+   * @param ok True if weather was refreshed.
+   */
+  void recordSync(bool ok);
+
+  /**
+   * @brief Add one loop() iteration to the loop-time histogram and track uptime.
+   * @param loopUs Iteration duration in microseconds.
+   */
+  void observeLoop(uint32_t loopUs);
+
+  /**
+   * @brief Seconds since boot, kept past the 49-day millis() wrap.
+   */
+  uint32_t uptimeSeconds() const;
+
+  /**
+   * @brief Format all metrics in Prometheus text exposition format.
+   * @param gauges Externally owned values to include.
+   * @param writer Called once per filled chunk.
+   * @param context Passed through to writer.
+   * @return Total bytes written.
+   */
+  size_t render(const MetricsGauges& gauges, Writer writer, void* context) const;
+
+ private:
+  static constexpr uint8_t kMaxBounds = 10;
+  static constexpr uint8_t kMaxFailureCodes = 8;
+
+  /**
+   * @brief Histogram whose bucket bounds live in flash-resident tables.
+   */
+  struct Histogram {
+    const uint32_t* bounds;
+    uint8_t boundCount;
+    uint32_t buckets[kMaxBounds + 1];  // Per-bucket counts; the last one is +Inf.
+    uint32_t count;
+    uint64_t sum;
+  };
+
+  struct FailureCount {
+    int16_t code;
+    uint32_t count;
+  };
+
+  class Formatter;
+
+  static void observe(Histogram& histogram, uint32_t value);
+  static void renderHistogram(Formatter& out, const char* name, const char* labels, const Histogram& histogram);
+
+  Histogram phaseMs_[kHeapPhaseCount] = {};
+  Histogram payloadBytes_ = {};
+  Histogram loopUs_ = {};
+  uint32_t phaseStartMs_[kHeapPhaseCount] = {};
+  FailureCount failures_[kMaxFailureCodes] = {};
+  uint8_t failureCodeCount_ = 0;
+  uint32_t otherFailures_ = 0;
+  uint32_t retries_ = 0;
+  uint32_t syncsOk_ = 0;
+  uint32_t syncsFailed_ = 0;
+  uint32_t lastLoopMillis_ = 0;
+  uint32_t millisWraps_ = 0;
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <stdint.h>
+#include "ForecastStore.h"
+#include "SunCalc.h"
 #include "WeatherIcons.h"
 
 /**
@@ -15,10 +17,53 @@ struct ClockData {
   uint8_t month;
   /** @brief Day of month (1-31). */
   uint8_t day;
+  /** @brief Day of week (0 = Sunday). */
+  uint8_t weekday;
   /** @brief True when clock data was successfully refreshed. */
   bool valid;
 };
 
+/**
+ * @brief Minutes covered by the precipitation nowcast.
+ */
+constexpr uint8_t kNowcastSamples = 60;
+
+/**
+ * @brief Precipitation represented by one nowcast quantization step (mm/h).
+ */
+constexpr float kNowcastStepMmPerHour = 0.05f;
+
+/**
+ * @brief Next-hour precipitation nowcast, one quantized sample per minute.
+ */
+struct NowcastData {
+  /** @brief UTC epoch of sample 0; sample i covers startEpoch + 60*i. */
+  uint32_t startEpoch;
+  /** @brief UTC epoch when the samples were fetched (0 if never). */
+  uint32_t fetchedAtEpoch;
+  /** @brief Number of valid samples. */
+  uint8_t count;
+  /** @brief Precipitation intensity in kNowcastStepMmPerHour steps (255 = saturated). */
+  uint8_t intensity[kNowcastSamples];
+};
+
+/**
+ * @brief Capacity of the advisory list carried in WeatherData.
+ */
+constexpr uint8_t kMaxWeatherAlerts = 4;
+
+/**
+ * @brief One government weather alert with its validity window.
+ */
+struct WeatherAlert {
+  /** @brief Alert event name ("Winter Storm Warning", etc.), truncated to fit. */
+  char event[24];
+  /** @brief UTC epoch when the alert takes effect. */
+  uint32_t startEpoch;
+  /** @brief UTC epoch when the alert expires. */
+  uint32_t endEpoch;
+};
+
 /**
  * @brief Consolidated weather view model consumed by display pages.
  */
@@ -53,8 +98,12 @@ struct WeatherData {
   uint8_t gustMph;
   /** @brief Wind direction in degrees from north (0-359). */
   uint16_t windDeg;
-  /** @brief Advisory text line for advisories page. */
+  /** @brief Summary advisory line: first active alert, wind fallback, or "NO ADVISORIES". */
   char advisory[32];
+  /** @brief Active alerts ordered as received; expired entries are pruned locally. */
+  WeatherAlert alerts[kMaxWeatherAlerts];
+  /** @brief Number of entries used in alerts. */
+  uint8_t alertCount;
 
   /** @brief Hour labels (24-hour values) for 4 hourly rows. */
   uint8_t hourlyHour24[4];
@@ -76,6 +125,19 @@ struct WeatherData {
   /** @brief Daily condition text ("Rain", "Clouds", etc.) for 4 rows. */
   char dailyMain[4][12];
 
+  /** @brief Full hourly/daily series behind the 4-row pages, for offline scrolling. */
+  ForecastStore forecast;
+
+  /** @brief UTC epoch when this data was fetched (0 if the clock was not synced). */
+  uint32_t fetchedAtEpoch;
+  /** @brief UTC epoch when the daily rows were last fetched (0 forces a daily refetch). */
+  uint32_t dailyFetchedAtEpoch;
+  /** @brief UTC epoch when alerts were last fetched (0 if never). */
+  uint32_t alertsFetchedAtEpoch;
+  /** @brief Latitude of the fetched location in microdegrees; drives local sunrise/sunset. */
+  int32_t latMicrodeg;
+  /** @brief Longitude of the fetched location in microdegrees. */
+  int32_t lonMicrodeg;
   /** @brief True when weather payload was successfully parsed. */
   bool valid;
 };
@@ -0,0 +1,320 @@
+#include "ObservationHistory.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include "DeferredLog.h"
+#include "TimeService.h"
+
+namespace {
+int8_t clampDelta(int value) {
+  if (value < -128) {
+    return -128;
+  }
+  if (value > 127) {
+    return 127;
+  }
+  return static_cast<int8_t>(value);
+}
+
+void putRecord(uint8_t* out, uint32_t utcEpoch, const ObservationSample& sample) {
+  out[0] = static_cast<uint8_t>(utcEpoch);
+  out[1] = static_cast<uint8_t>(utcEpoch >> 8);
+  out[2] = static_cast<uint8_t>(utcEpoch >> 16);
+  out[3] = static_cast<uint8_t>(utcEpoch >> 24);
+  out[4] = static_cast<uint8_t>(static_cast<uint16_t>(sample.temperatureF));
+  out[5] = static_cast<uint8_t>(static_cast<uint16_t>(sample.temperatureF) >> 8);
+  out[6] = sample.windMph;
+  out[7] = sample.gustMph;
+}
+
+uint32_t getRecord(const uint8_t* in, ObservationSample& sample) {
+  sample.temperatureF = static_cast<int16_t>(in[4] | (in[5] << 8));
+  sample.windMph = in[6];
+  sample.gustMph = in[7];
+  return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+         (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+}  // namespace
+
+/**
+ * Ensure LittleFS is mounted once before file operations.
+ */
+bool ObservationHistory::ensureFsMounted() {
+  if (fsMounted_) {
+    return true;
+  }
+  fsMounted_ = LittleFS.begin(true);
+  if (!fsMounted_) {
+    LOG_ERROR(HistMountFailed);
+  }
+  return fsMounted_;
+}
+
+/**
+ * Rebuild the ring by replaying every record in the append log.
+ */
+bool ObservationHistory::load() {
+  if (!ensureFsMounted()) {
+    return false;
+  }
+  if (!LittleFS.exists(kLogFile) && LittleFS.exists(kCompactTempFile)) {
+    // Power was lost between removing the old log and renaming the compacted one.
+    LittleFS.rename(kCompactTempFile, kLogFile);
+  }
+  if (!LittleFS.exists(kLogFile)) {
+    return false;
+  }
+  File file = LittleFS.open(kLogFile, "r");
+  if (!file) {
+    return false;
+  }
+
+  replaying_ = true;
+  uint8_t raw[kRecordSize];
+  uint16_t rejected = 0;
+  // A torn final append leaves a short record, which read() reports and we drop.
+  while (static_cast<size_t>(file.read(raw, sizeof(raw))) == sizeof(raw)) {
+    ObservationSample sample{};
+    const uint32_t utcEpoch = getRecord(raw, sample);
+    ++logRecords_;
+    if (!TimeService::isClockSet(static_cast<time_t>(utcEpoch))) {
+      ++rejected;
+      continue;
+    }
+    record(utcEpoch, sample);
+  }
+  file.close();
+  replaying_ = false;
+
+  LOG_INFO(HistLoaded, logRecords_, rejected, count_);
+  if (logRecords_ >= kCompactAtRecords) {
+    compactLog();
+  }
+  return count_ > 0;
+}
+
+/**
+ * Fold the sample into the ring and persist it unless replaying the log.
+ */
+void ObservationHistory::record(uint32_t utcEpoch, const ObservationSample& sample) {
+  const uint32_t hour = utcEpoch / 3600UL;
+  if (count_ > 0 && hour < newestHour_) {
+    // Clock stepped backwards; keep the ring monotonic.
+    return;
+  }
+  push(hour, sample);
+  newestEpoch_ = utcEpoch > newestEpoch_ ? utcEpoch : newestEpoch_;
+  recomputeRange();
+  if (!replaying_) {
+    appendToLog(utcEpoch, sample);
+  }
+}
+
+/**
+ * Insert one hourly value, filling skipped hours and evicting the oldest when full.
+ */
+void ObservationHistory::push(uint32_t hour, const ObservationSample& sample) {
+  if (count_ == 0 || hour - newestHour_ >= kCapacity) {
+    // Empty, or everything held is older than the window: restart from this sample.
+    head_ = 0;
+    count_ = 1;
+    tempDelta_[0] = 0;
+    windDelta_[0] = 0;
+    gustDelta_[0] = 0;
+    oldest_ = sample;
+    newest_ = sample;
+    newestHour_ = hour;
+    return;
+  }
+
+  if (hour == newestHour_) {
+    // Same hour: re-encode the newest slot against its predecessor.
+    if (count_ == 1) {
+      oldest_ = sample;
+      newest_ = sample;
+      return;
+    }
+    const uint8_t s = slot(static_cast<uint8_t>(count_ - 1));
+    const int prevTemp = newest_.temperatureF - tempDelta_[s];
+    const int prevWind = newest_.windMph - windDelta_[s];
+    const int prevGust = newest_.gustMph - gustDelta_[s];
+    tempDelta_[s] = clampDelta(sample.temperatureF - prevTemp);
+    windDelta_[s] = clampDelta(sample.windMph - prevWind);
+    gustDelta_[s] = clampDelta(sample.gustMph - prevGust);
+    newest_.temperatureF = static_cast<int16_t>(prevTemp + tempDelta_[s]);
+    newest_.windMph = static_cast<uint8_t>(prevWind + windDelta_[s]);
+    newest_.gustMph = static_cast<uint8_t>(prevGust + gustDelta_[s]);
+    return;
+  }
+
+  while (newestHour_ < hour) {
+    if (count_ == kCapacity) {
+      // Evict: the second-oldest sample becomes the absolute base.
+      const uint8_t next = slot(1);
+      oldest_.temperatureF = static_cast<int16_t>(oldest_.temperatureF + tempDelta_[next]);
+      oldest_.windMph = static_cast<uint8_t>(oldest_.windMph + windDelta_[next]);
+      oldest_.gustMph = static_cast<uint8_t>(oldest_.gustMph + gustDelta_[next]);
+      head_ = next;
+      --count_;
+    }
+    ++newestHour_;
+    // Skipped hours repeat the last value (delta 0); the final hour takes the new sample.
+    const ObservationSample& target = (newestHour_ == hour) ? sample : newest_;
+    const uint8_t s = slot(count_);
+    tempDelta_[s] = clampDelta(target.temperatureF - newest_.temperatureF);
+    windDelta_[s] = clampDelta(target.windMph - newest_.windMph);
+    gustDelta_[s] = clampDelta(target.gustMph - newest_.gustMph);
+    newest_.temperatureF = static_cast<int16_t>(newest_.temperatureF + tempDelta_[s]);
+    newest_.windMph = static_cast<uint8_t>(newest_.windMph + windDelta_[s]);
+    newest_.gustMph = static_cast<uint8_t>(newest_.gustMph + gustDelta_[s]);
+    ++count_;
+  }
+}
+
+/**
+ * Append one fixed-size record; compact once the log holds two rings' worth.
+ */
+void ObservationHistory::appendToLog(uint32_t utcEpoch, const ObservationSample& sample) {
+  if (!ensureFsMounted()) {
+    return;
+  }
+  File file = LittleFS.open(kLogFile, "a");
+  if (!file) {
+    LOG_ERROR(HistAppendOpenFailed);
+    return;
+  }
+  uint8_t record[kRecordSize];
+  putRecord(record, utcEpoch, sample);
+  const size_t written = file.write(record, sizeof(record));
+  file.close();
+  if (written != sizeof(record)) {
+    LOG_ERROR(HistAppendShort);
+    return;
+  }
+  ++logRecords_;
+  ++appendCount_;
+  if (logRecords_ >= kCompactAtRecords) {
+    compactLog();
+  }
+}
+
+/**
+ * Rewrite the log as one record per held hour via a temp file and rename.
+ */
+void ObservationHistory::compactLog() {
+  File file = LittleFS.open(kCompactTempFile, "w");
+  if (!file) {
+    LOG_ERROR(HistCompactOpenFailed);
+    return;
+  }
+  Reader reader;
+  startRead(reader);
+  uint8_t record[kRecordSize];
+  bool ok = true;
+  while (ok && read(reader)) {
+    const uint32_t hour = newestHour_ - (count_ - reader.position);
+    putRecord(record, hour * 3600UL, reader.sample);
+    ok = file.write(record, sizeof(record)) == sizeof(record);
+  }
+  file.close();
+  if (!ok) {
+    LOG_ERROR(HistCompactShort);
+    LittleFS.remove(kCompactTempFile);
+    return;
+  }
+  LittleFS.remove(kLogFile);
+  if (!LittleFS.rename(kCompactTempFile, kLogFile)) {
+    LOG_ERROR(HistCompactRenameFailed);
+    return;
+  }
+  logRecords_ = count_;
+  ++compactionCount_;
+  LOG_INFO(HistCompacted, logRecords_, compactionCount_);
+}
+
+/**
+ * Refresh cached min/max so the trend page can scale in its single drawing pass.
+ */
+void ObservationHistory::recomputeRange() {
+  Reader reader;
+  startRead(reader);
+  bool first = true;
+  while (read(reader)) {
+    const ObservationSample& s = reader.sample;
+    if (first || s.temperatureF < minTempF_) {
+      minTempF_ = s.temperatureF;
+    }
+    if (first || s.temperatureF > maxTempF_) {
+      maxTempF_ = s.temperatureF;
+    }
+    const uint8_t wind = s.gustMph > s.windMph ? s.gustMph : s.windMph;
+    if (first || wind > maxWindMph_) {
+      maxWindMph_ = wind;
+    }
+    first = false;
+  }
+}
+
+/**
+ * Map a position (0 = oldest) to its ring slot.
+ */
+uint8_t ObservationHistory::slot(uint8_t position) const {
+  return static_cast<uint8_t>((head_ + position) % kCapacity);
+}
+
+uint8_t ObservationHistory::count() const {
+  return count_;
+}
+
+uint32_t ObservationHistory::newestHour() const {
+  return newestHour_;
+}
+
+uint32_t ObservationHistory::newestEpoch() const {
+  return count_ == 0 ? 0 : newestEpoch_;
+}
+
+int16_t ObservationHistory::minTemperatureF() const {
+  return minTempF_;
+}
+
+int16_t ObservationHistory::maxTemperatureF() const {
+  return maxTempF_;
+}
+
+uint8_t ObservationHistory::maxWindMph() const {
+  return maxWindMph_;
+}
+
+/**
+ * Position a reader before the oldest sample.
+ */
+void ObservationHistory::startRead(Reader& reader) const {
+  reader.position = 0;
+  reader.sample = oldest_;
+}
+
+/**
+ * Accumulate deltas forward from the oldest absolute sample.
+ */
+bool ObservationHistory::read(Reader& reader) const {
+  if (reader.position >= count_) {
+    return false;
+  }
+  if (reader.position > 0) {
+    const uint8_t s = slot(reader.position);
+    reader.sample.temperatureF = static_cast<int16_t>(reader.sample.temperatureF + tempDelta_[s]);
+    reader.sample.windMph = static_cast<uint8_t>(reader.sample.windMph + windDelta_[s]);
+    reader.sample.gustMph = static_cast<uint8_t>(reader.sample.gustMph + gustDelta_[s]);
+  }
+  ++reader.position;
+  return true;
+}
+
+uint32_t ObservationHistory::appendCount() const {
+  return appendCount_;
+}
+
+uint32_t ObservationHistory::compactionCount() const {
+  return compactionCount_;
+}
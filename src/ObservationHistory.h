@@ -0,0 +1,139 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief One observed current-conditions sample.
+ */
+struct ObservationSample {
+  /** @brief Observed temperature in Fahrenheit. */
+  int16_t temperatureF;
+  /** @brief Sustained wind in mph. */
+  uint8_t windMph;
+  /** @brief Wind gust in mph. */
+  uint8_t gustMph;
+};
+
+/**
+ * @brief 72-hour ring of hourly observations, delta-encoded and persisted to LittleFS.
+ *
+ * Only the oldest and newest samples are stored absolutely; every other slot
+ * holds int8 deltas from its predecessor. Each new hour is appended to a
+ * small log file, and the log is compacted once it holds two rings' worth of
+ * records, so flash sees a few bytes per hour instead of a full rewrite.
+ */
+class ObservationHistory {
+ public:
+  /** @brief Hourly slots retained. */
+  static constexpr uint8_t kCapacity = 72;
+
+  /**
+   * @brief Read position for a single oldest-to-newest pass without allocation.
+   */
+  struct Reader {
+    /** @brief Samples already returned. */
+    uint8_t position;
+    /** @brief Sample produced by the last successful read(). */
+    ObservationSample sample;
+  };
+
+  /**
+   * @brief Replay the persisted log into the ring.
+   * @return True if at least one sample was restored.
+   */
+  bool load();
+
+  /**
+   * @brief Record an observation for the hour containing utcEpoch and append it to flash.
+   *
+   * A second sample in the same hour replaces that hour's value. Skipped hours
+   * (device off, failed syncs) carry the previous value forward.
+   * @param utcEpoch Observation time (must be a synced clock).
+   * @param sample Observed values.
+   */
+  void record(uint32_t utcEpoch, const ObservationSample& sample);
+
+  /**
+   * @brief Number of hourly samples currently held.
+   */
+  uint8_t count() const;
+
+  /**
+   * @brief UTC hour index (epoch / 3600) of the newest sample.
+   */
+  uint32_t newestHour() const;
+
+  /**
+   * @brief Observation time of the newest recorded sample, or 0 when empty.
+   */
+  uint32_t newestEpoch() const;
+
+  /**
+   * @brief Smallest temperature in the ring.
+   */
+  int16_t minTemperatureF() const;
+
+  /**
+   * @brief Largest temperature in the ring.
+   */
+  int16_t maxTemperatureF() const;
+
+  /**
+   * @brief Largest gust (or wind, if higher) in the ring.
+   */
+  uint8_t maxWindMph() const;
+
+  /**
+   * @brief Start an oldest-to-newest pass.
+   */
+  void startRead(Reader& reader) const;
+
+  /**
+   * @brief Decode the next sample into reader.sample.
+   * @return False once every sample has been returned.
+   */
+  bool read(Reader& reader) const;
+
+  /**
+   * @brief Flash appends since boot.
+   */
+  uint32_t appendCount() const;
+
+  /**
+   * @brief Log compactions since boot.
+   */
+  uint32_t compactionCount() const;
+
+ private:
+  static constexpr const char* kLogFile = "/history.log";
+  static constexpr const char* kCompactTempFile = "/history.tmp";
+  static constexpr size_t kRecordSize = 8;  // epoch(4) tempF(2) wind(1) gust(1)
+  static constexpr uint16_t kCompactAtRecords = 2 * kCapacity;
+
+  bool ensureFsMounted();
+  void push(uint32_t hour, const ObservationSample& sample);
+  void appendToLog(uint32_t utcEpoch, const ObservationSample& sample);
+  void compactLog();
+  void recomputeRange();
+  uint8_t slot(uint8_t position) const;
+
+  int8_t tempDelta_[kCapacity] = {0};
+  int8_t windDelta_[kCapacity] = {0};
+  int8_t gustDelta_[kCapacity] = {0};
+  ObservationSample oldest_{};
+  ObservationSample newest_{};
+  uint32_t newestHour_ = 0;
+  uint32_t newestEpoch_ = 0;
+  uint8_t head_ = 0;  // Slot of the oldest sample.
+  uint8_t count_ = 0;
+  int16_t minTempF_ = 0;
+  int16_t maxTempF_ = 0;
+  uint8_t maxWindMph_ = 0;
+
+  bool fsMounted_ = false;
+  bool replaying_ = false;
+  uint16_t logRecords_ = 0;
+  uint32_t appendCount_ = 0;
+  uint32_t compactionCount_ = 0;
+};
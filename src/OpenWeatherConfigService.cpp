@@ -2,6 +2,21 @@
 
 #include <Arduino.h>
 #include <string.h>
+#include "Crc32.h"
+
+namespace {
+void putU32(uint8_t* out, uint32_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+  out[2] = static_cast<uint8_t>(value >> 16);
+  out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t getU32(const uint8_t* in) {
+  return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+         (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+}  // namespace
 
 /**
  * Construct persistent ZIP/API-key config service and bind parameter buffers.
@@ -31,9 +46,9 @@ bool OpenWeatherConfigService::ensureFsMounted() {
 }
 
 /**
- * Load a trimmed text value from LittleFS into fixed-size output buffer.
+ * Load a trimmed text value from a legacy LittleFS file into fixed-size output buffer.
  */
-bool OpenWeatherConfigService::loadFromFs(const char* filePath, char* output, size_t outputSize) {
+bool OpenWeatherConfigService::loadLegacyFile(const char* filePath, char* output, size_t outputSize) {
   if (!ensureFsMounted() || filePath == nullptr || output == nullptr || outputSize == 0 || !LittleFS.exists(filePath)) {
     return false;
   }
@@ -52,35 +67,145 @@ bool OpenWeatherConfigService::loadFromFs(const char* filePath, char* output, si
 }
 
 /**
- * Persist a text value to LittleFS.
+ * Copy the current values into a zero-padded payload so unused bytes never change the CRC.
  */
-void OpenWeatherConfigService::saveToFs(const char* filePath, const char* value) {
-  if (!ensureFsMounted() || filePath == nullptr || value == nullptr) {
-    return;
+void OpenWeatherConfigService::encodePayload(uint8_t* payload) const {
+  memset(payload, 0, kPayloadSize);
+  memcpy(payload, zipCodeValue_, strnlen(zipCodeValue_, kZipCodeSize - 1));
+  memcpy(payload + kZipCodeSize, apiKeyValue_, strnlen(apiKeyValue_, kApiKeySize - 1));
+}
+
+/**
+ * Read and validate header and CRC in a single file read.
+ */
+bool OpenWeatherConfigService::loadRecord() {
+  if (!ensureFsMounted()) {
+    return false;
+  }
+  // Power loss between remove and rename leaves only the temp file, which is complete by then.
+  if (!LittleFS.exists(kConfigFile) && LittleFS.exists(kConfigTempFile)) {
+    LittleFS.rename(kConfigTempFile, kConfigFile);
+  }
+  if (!LittleFS.exists(kConfigFile)) {
+    return false;
   }
 
-  File file = LittleFS.open(filePath, "w");
+  File file = LittleFS.open(kConfigFile, "r");
   if (!file) {
-    Serial.print("[CFG] Failed to open file for write: ");
-    Serial.println(filePath);
-    return;
+    return false;
+  }
+  uint8_t record[kRecordSize];
+  const size_t got = file.read(record, sizeof(record));
+  file.close();
+
+  // Header: magic(4) format(1) reserved(1) payloadLen(2) crc(4).
+  if (got != kRecordSize || getU32(record) != kMagic || record[4] != kFormatVersion ||
+      static_cast<size_t>(record[6] | (record[7] << 8)) != kPayloadSize) {
+    Serial.println("[CFG] Config record truncated or from another version");
+    return false;
+  }
+  const uint8_t* payload = record + kHeaderSize;
+  const uint32_t crc = crc32Update(0, payload, kPayloadSize);
+  if (crc != getU32(record + 8)) {
+    Serial.println("[CFG] Config record CRC mismatch");
+    return false;
+  }
+
+  memcpy(zipCodeValue_, payload, kZipCodeSize);
+  zipCodeValue_[kZipCodeSize - 1] = '\0';
+  memcpy(apiKeyValue_, payload + kZipCodeSize, kApiKeySize);
+  apiKeyValue_[kApiKeySize - 1] = '\0';
+  storedCrc_ = crc;
+  hasStoredCrc_ = true;
+  return true;
+}
+
+/**
+ * Encode, compare against the record on flash, and replace it via temp file + rename.
+ */
+bool OpenWeatherConfigService::saveRecord() {
+  uint8_t record[kRecordSize];
+  uint8_t* payload = record + kHeaderSize;
+  encodePayload(payload);
+  const uint32_t crc = crc32Update(0, payload, kPayloadSize);
+  if (hasStoredCrc_ && crc == storedCrc_) {
+    Serial.println("[CFG] Config unchanged, skipping write");
+    return false;
   }
-  file.print(value);
-  file.flush();
+  if (!ensureFsMounted()) {
+    return false;
+  }
+
+  putU32(record, kMagic);
+  record[4] = kFormatVersion;
+  record[5] = 0;
+  record[6] = static_cast<uint8_t>(kPayloadSize);
+  record[7] = static_cast<uint8_t>(kPayloadSize >> 8);
+  putU32(record + 8, crc);
+
+  File file = LittleFS.open(kConfigTempFile, "w");
+  if (!file) {
+    Serial.println("[CFG] Failed to open config temp file for write");
+    return false;
+  }
+  const size_t written = file.write(record, kRecordSize);
   file.close();
+  if (written != kRecordSize) {
+    Serial.println("[CFG] Config write short");
+    LittleFS.remove(kConfigTempFile);
+    return false;
+  }
+  // LittleFS renames over an existing file atomically; remove first only if that is refused.
+  if (!LittleFS.rename(kConfigTempFile, kConfigFile)) {
+    LittleFS.remove(kConfigFile);
+    if (!LittleFS.rename(kConfigTempFile, kConfigFile)) {
+      Serial.println("[CFG] Config rename failed");
+      return false;
+    }
+  }
+
+  storedCrc_ = crc;
+  hasStoredCrc_ = true;
+  ++writeCount_;
+  Serial.print("[CFG] Config written bytes=");
+  Serial.print(static_cast<unsigned>(kRecordSize));
+  Serial.print(" writes=");
+  Serial.println(writeCount_);
+  return true;
 }
 
 /**
- * Load ZIP/API-key settings from filesystem and mirror into portal fields.
+ * Import ZIP/API key from the pre-record text files, then delete them once the record is on flash.
+ */
+void OpenWeatherConfigService::migrateLegacyFiles() {
+  const bool hasZip = loadLegacyFile(kLegacyZipCodeFile, zipCodeValue_, sizeof(zipCodeValue_));
+  const bool hasKey = loadLegacyFile(kLegacyApiKeyFile, apiKeyValue_, sizeof(apiKeyValue_));
+  if (!hasZip && !hasKey) {
+    return;
+  }
+  Serial.println("[CFG] Migrating legacy text config to record");
+  if (saveRecord()) {
+    LittleFS.remove(kLegacyZipCodeFile);
+    LittleFS.remove(kLegacyApiKeyFile);
+  }
+}
+
+/**
+ * Load ZIP/API-key settings from the record (or legacy files) and mirror into portal fields.
  */
 void OpenWeatherConfigService::load() {
-  if (!loadFromFs(kZipCodeFile, zipCodeValue_, sizeof(zipCodeValue_))) {
+  const uint32_t startUs = micros();
+  if (!loadRecord()) {
     zipCodeValue_[0] = '\0';
-  }
-  if (!loadFromFs(kApiKeyFile, apiKeyValue_, sizeof(apiKeyValue_))) {
     apiKeyValue_[0] = '\0';
+    migrateLegacyFiles();
   }
+  loadMicros_ = micros() - startUs;
   syncPortalValues();
+  Serial.print("[CFG] Config loaded us=");
+  Serial.print(loadMicros_);
+  Serial.print(" writes=");
+  Serial.println(writeCount_);
 }
 
 /**
@@ -94,7 +219,7 @@ void OpenWeatherConfigService::configurePortal(WiFiManager& manager) {
 }
 
 /**
- * Apply submitted WiFiManager values into memory and persist them.
+ * Apply submitted WiFiManager values into memory; the record is rewritten only if they changed.
  */
 void OpenWeatherConfigService::applyFromConfig() {
   const char* zipParam = zipCodeParam_.getValue();
@@ -109,8 +234,7 @@ void OpenWeatherConfigService::applyFromConfig() {
     apiKeyValue_[sizeof(apiKeyValue_) - 1] = '\0';
   }
 
-  saveToFs(kZipCodeFile, zipCodeValue_);
-  saveToFs(kApiKeyFile, apiKeyValue_);
+  saveRecord();
   syncPortalValues();
 }
 
@@ -124,12 +248,13 @@ void OpenWeatherConfigService::clearSaved() {
     return;
   }
 
-  if (LittleFS.exists(kZipCodeFile)) {
-    LittleFS.remove(kZipCodeFile);
-  }
-  if (LittleFS.exists(kApiKeyFile)) {
-    LittleFS.remove(kApiKeyFile);
+  const char* const files[] = {kConfigFile, kConfigTempFile, kLegacyZipCodeFile, kLegacyApiKeyFile};
+  for (const char* path : files) {
+    if (LittleFS.exists(path)) {
+      LittleFS.remove(path);
+    }
   }
+  hasStoredCrc_ = false;
 }
 
 /**
@@ -146,6 +271,20 @@ const char* OpenWeatherConfigService::apiKey() const {
   return apiKeyValue_;
 }
 
+/**
+ * Return config record writes since boot.
+ */
+uint32_t OpenWeatherConfigService::writeCount() const {
+  return writeCount_;
+}
+
+/**
+ * Return duration of the last load().
+ */
+uint32_t OpenWeatherConfigService::loadMicros() const {
+  return loadMicros_;
+}
+
 /**
  * Push current in-memory values into WiFiManager field defaults.
  */
@@ -1,11 +1,16 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdint.h>
 #include <LittleFS.h>
 #include <WiFiManager.h>
 
 /**
  * @brief Persists ZIP/API key config and exposes corresponding WiFiManager params.
+ *
+ * Settings live in one versioned, CRC-protected binary record that is read in
+ * a single call and rewritten (temp file + rename) only when its contents
+ * change. Legacy per-setting text files are migrated on first load.
  */
 class OpenWeatherConfigService {
  public:
@@ -15,7 +20,7 @@ class OpenWeatherConfigService {
   OpenWeatherConfigService();
 
   /**
-   * @brief Load ZIP/API key from LittleFS.
+   * @brief Load ZIP/API key from the config record, migrating legacy text files if needed.
    */
   void load();
 
@@ -25,7 +30,7 @@ class OpenWeatherConfigService {
   void configurePortal(WiFiManager& manager);
 
   /**
-   * @brief Apply values currently submitted in WiFiManager fields and persist them.
+   * @brief Apply values currently submitted in WiFiManager fields; persist only if they changed.
    */
   void applyFromConfig();
 
@@ -49,9 +54,30 @@ class OpenWeatherConfigService {
    */
   const char* apiKey() const;
 
+  /**
+   * @brief Config record writes since boot.
+   */
+  uint32_t writeCount() const;
+
+  /**
+   * @brief Microseconds the last load() took, including any migration.
+   */
+  uint32_t loadMicros() const;
+
  private:
-  static constexpr const char* kZipCodeFile = "/zipcode.txt";
-  static constexpr const char* kApiKeyFile = "/openweather_api_key.txt";
+  static constexpr const char* kConfigFile = "/config.bin";
+  static constexpr const char* kConfigTempFile = "/config.tmp";
+  static constexpr const char* kLegacyZipCodeFile = "/zipcode.txt";
+  static constexpr const char* kLegacyApiKeyFile = "/openweather_api_key.txt";
+  static constexpr uint32_t kMagic = 0x31434357UL;  // "WCC1" little-endian.
+  static constexpr uint8_t kFormatVersion = 1;
+  static constexpr size_t kHeaderSize = 12;
+  static constexpr size_t kZipCodeSize = 16;
+  static constexpr size_t kApiKeySize = 65;
+  // Zeroed space for later settings (units, refresh policy) without a size change.
+  static constexpr size_t kReservedSize = 15;
+  static constexpr size_t kPayloadSize = kZipCodeSize + kApiKeySize + kReservedSize;
+  static constexpr size_t kRecordSize = kHeaderSize + kPayloadSize;
 
   /**
    * @brief Ensure LittleFS is mounted.
@@ -60,19 +86,40 @@ class OpenWeatherConfigService {
   bool ensureFsMounted();
 
   /**
-   * @brief Load a single line value from a filesystem file.
+   * @brief Read and validate the config record in one file read.
+   * @return True if an intact record was loaded into the value buffers.
+   */
+  bool loadRecord();
+
+  /**
+   * @brief Write the config record via temp file + rename when contents differ from flash.
+   * @return True if the record was written.
+   */
+  bool saveRecord();
+
+  /**
+   * @brief Load a single line value from a legacy text file.
    * @return True if non-empty value was loaded.
    */
-  bool loadFromFs(const char* filePath, char* output, size_t outputSize);
+  bool loadLegacyFile(const char* filePath, char* output, size_t outputSize);
+
+  /**
+   * @brief Import the legacy text files into the record and delete them.
+   */
+  void migrateLegacyFiles();
 
   /**
-   * @brief Save a value to a filesystem file.
+   * @brief Fill a record payload from the current values (zero-padded).
    */
-  void saveToFs(const char* filePath, const char* value);
+  void encodePayload(uint8_t* payload) const;
 
   bool fsMounted_ = false;
-  char zipCodeValue_[16];
-  char apiKeyValue_[65];
+  bool hasStoredCrc_ = false;
+  uint32_t storedCrc_ = 0;
+  uint32_t writeCount_ = 0;
+  uint32_t loadMicros_ = 0;
+  char zipCodeValue_[kZipCodeSize];
+  char apiKeyValue_[kApiKeySize];
   WiFiManagerParameter zipCodeParam_;
   WiFiManagerParameter apiKeyParam_;
 };
@@ -1,5 +1,8 @@
 #include "OpenWeatherService.h"
 
+#include "CivilCalendar.h"
+#include "FixedPoint.h"
+
 #include <Arduino.h>
 #if defined(ARDUINO_ARCH_ESP8266)
 #include <ESP8266HTTPClient.h>
@@ -14,19 +17,277 @@ using SecureClient = WiFiClientSecure;
 #else
 #error Unsupported architecture: expected ESP8266 or ESP32
 #endif
+#include <stdarg.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
+#include "DeferredLog.h"
+#include "JsonStreamScanner.h"
+#include "TimeService.h"
+#include "Trace.h"
+#include "WeatherAlerts.h"
+
+// Override with -D OWM_API_BASE_URL=\"https://host:port\" to point at a local stand-in server.
+#ifndef OWM_API_BASE_URL
+#define OWM_API_BASE_URL "https://api.openweathermap.org"
+#endif
 
 namespace {
-// Converts probability [0..1] into integer percent [0..100].
-int clampToPercent(double pop) {
-  if (pop < 0) {
-    pop = 0;
+// Geocode and OneCall share one backoff/breaker: they hit the same host with the same key.
+constexpr RetryPolicy::Config kOwmRetryConfig = {
+    2000,                   // baseDelayMs
+    15UL * 60UL * 1000UL,   // maxDelayMs
+    4,                      // failureThreshold
+    30UL * 60UL * 1000UL};  // openCooldownMs
+// Longest backoff we are willing to sleep through inside one sync.
+constexpr uint32_t kMaxInlineRetryWaitMs = 5000;
+constexpr int kMaxOneCallAttempts = 3;
+// Daily section refresh tier; it is also refetched when the local date rolls over.
+constexpr time_t kDailyTierSeconds = 6 * 3600;
+// Longest request URL; the API key alone is 32 characters.
+constexpr size_t kUrlBytes = 256;
+constexpr char kOneCallUrlFormat[] = OWM_API_BASE_URL "/data/3.0/onecall?lat=%s&lon=%s&units=imperial&exclude=%s&appid=%s";
+constexpr char kGeocodeUrlFormat[] = OWM_API_BASE_URL "/geo/1.0/zip?zip=%s&appid=%s";
+
+// One TLS client, one HTTP client and one URL buffer serve every request, so
+// a sync no longer constructs and destroys them per attempt.
+struct RequestArena {
+  SecureClient client;
+  HTTPClient http;
+#if defined(ARDUINO_ARCH_ESP8266)
+  // Lets later handshakes resume instead of repeating the full key exchange.
+  BearSSL::Session session;
+#endif
+  char url[kUrlBytes];
+#if defined(ARDUINO_ARCH_ESP8266)
+  uint16_t rxBufferBytes;
+  uint16_t txBufferBytes;
+#endif
+  bool configured;
+};
+
+// Constructed on first request, after WiFi is up, then kept for the life of the device.
+RequestArena& requestArena() {
+  static RequestArena arena;
+  return arena;
+}
+
+// Union of the headers any request reads; one list keeps collectHeaders() allocations the same size.
+const char* kCollectedHeaders[] = {"Content-Type", "Content-Encoding", "Transfer-Encoding", "Content-Length",
+                                   "Retry-After"};
+
+/**
+ * Format a request URL into the arena buffer; false when it would not fit.
+ */
+bool formatRequestUrl(RequestArena& arena, const char* tag, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+bool formatRequestUrl(RequestArena& arena, const char* tag, const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  const int length = vsnprintf(arena.url, sizeof(arena.url), format, args);
+  va_end(args);
+  if (length < 0 || static_cast<size_t>(length) >= sizeof(arena.url)) {
+    LOG_ERROR(OwmUrlTooLong, tag, static_cast<uint32_t>(sizeof(arena.url)));
+    return false;
+  }
+  return true;
+}
+
+#if defined(ARDUINO_ARCH_ESP8266)
+// Without a negotiated Max Fragment Length the server may send 16 KB records;
+// these sizes are the long-standing setting that has held up against the API.
+constexpr uint16_t kFallbackRxBytes = 4096;
+constexpr uint16_t kFallbackTxBytes = 1024;
+// Requests are one short GET, so the TX side never needs more than this.
+constexpr uint16_t kMflnTxBytes = 512;
+// RFC 6066 lengths, smallest first.
+constexpr uint16_t kMflnSizes[] = {512, 1024, 2048, 4096};
+
+/**
+ * Split "https://host[:port]/..." into host and port.
+ */
+bool parseBaseHost(const char* base, char* host, size_t hostSize, uint16_t& port) {
+  port = 443;
+  if (strncmp(base, "https://", 8) == 0) {
+    base += 8;
+  } else if (strncmp(base, "http://", 7) == 0) {
+    base += 7;
+    port = 80;
+  }
+  size_t length = 0;
+  while (base[length] != '\0' && base[length] != ':' && base[length] != '/') {
+    ++length;
+  }
+  if (length == 0 || length >= hostSize) {
+    return false;
+  }
+  memcpy(host, base, length);
+  host[length] = '\0';
+  if (base[length] == ':') {
+    port = static_cast<uint16_t>(strtoul(base + length + 1, nullptr, 10));
+  }
+  return port != 0;
+}
+
+/**
+ * Probe the API host once per boot for the smallest fragment length it
+ * accepts and size the BearSSL buffers to it; keep the fallback otherwise.
+ */
+void selectTlsBuffers(RequestArena& arena) {
+  arena.rxBufferBytes = kFallbackRxBytes;
+  arena.txBufferBytes = kFallbackTxBytes;
+  char host[64];
+  uint16_t port = 0;
+  if (!parseBaseHost(OWM_API_BASE_URL, host, sizeof(host), port)) {
+    return;
+  }
+  for (size_t i = 0; i < sizeof(kMflnSizes) / sizeof(kMflnSizes[0]); ++i) {
+    if (BearSSL::WiFiClientSecure::probeMaxFragmentLength(host, port, kMflnSizes[i])) {
+      // With MFLN agreed the server never sends a record larger than the RX buffer.
+      arena.rxBufferBytes = kMflnSizes[i];
+      arena.txBufferBytes = kMflnTxBytes < kMflnSizes[i] ? kMflnTxBytes : kMflnSizes[i];
+      const uint32_t saved =
+          (kFallbackRxBytes + kFallbackTxBytes) - (arena.rxBufferBytes + arena.txBufferBytes);
+      LOG_INFO(OwmMflnSelected, kMflnSizes[i], host, arena.rxBufferBytes, arena.txBufferBytes, saved);
+      return;
+    }
+  }
+  LOG_WARN(OwmMflnUnsupported, host, arena.rxBufferBytes, arena.txBufferBytes);
+}
+#endif
+
+/**
+ * Open the arena URL on the shared clients; TLS settings are applied once.
+ */
+bool beginRequest(RequestArena& arena, uint16_t timeoutMs) {
+  if (!arena.configured) {
+    arena.client.setInsecure();
+#if defined(ARDUINO_ARCH_ESP8266)
+    selectTlsBuffers(arena);
+    arena.client.setBufferSizes(arena.rxBufferBytes, arena.txBufferBytes);
+    arena.client.setSession(&arena.session);
+#endif
+    arena.configured = true;
+  }
+#if defined(ARDUINO_ARCH_ESP8266)
+  LOG_DEBUG(OwmTlsBuffers, arena.rxBufferBytes, arena.txBufferBytes,
+            static_cast<uint32_t>((kFallbackRxBytes + kFallbackTxBytes) - (arena.rxBufferBytes + arena.txBufferBytes)),
+            ESP.getFreeHeap());
+#endif
+  // begin() resets headers from the previous request; the per-request options are reapplied below.
+  if (!arena.http.begin(arena.client, arena.url)) {
+    return false;
   }
-  if (pop > 1) {
-    pop = 1;
+  arena.http.collectHeaders(kCollectedHeaders, sizeof(kCollectedHeaders) / sizeof(kCollectedHeaders[0]));
+  arena.http.useHTTP10(true);
+  arena.http.addHeader("Accept-Encoding", "identity");
+  arena.http.setTimeout(timeoutMs);
+  return true;
+}
+
+// Collects alert entries from a streamed OneCall alerts payload.
+struct AlertParseState {
+  uint32_t utcNow;
+  WeatherAlert parsed[kMaxWeatherAlerts];
+  WeatherAlert current;
+  uint8_t count;
+  uint8_t received;
+  bool inAlerts;
+  bool inEntry;
+};
+
+// Scanner callback: root{ alerts[ {event,start,end,...} ] } sits at depth 3.
+void onAlertToken(void* context, JsonStreamScanner::Event event, const JsonStreamScanner& scanner) {
+  AlertParseState& state = *static_cast<AlertParseState*>(context);
+  switch (event) {
+    case JsonStreamScanner::Event::ArrayStart:
+      if (scanner.depth() == 2 && strcmp(scanner.key(), "alerts") == 0) {
+        state.inAlerts = true;
+      }
+      break;
+    case JsonStreamScanner::Event::ArrayEnd:
+      if (scanner.depth() == 2) {
+        state.inAlerts = false;
+      }
+      break;
+    case JsonStreamScanner::Event::ObjectStart:
+      if (state.inAlerts && scanner.depth() == 3) {
+        memset(&state.current, 0, sizeof(state.current));
+        state.inEntry = true;
+      }
+      break;
+    case JsonStreamScanner::Event::Value:
+      if (!state.inEntry || scanner.depth() != 3) {
+        break;
+      }
+      if (strcmp(scanner.key(), "event") == 0) {
+        strncpy(state.current.event, scanner.value(), sizeof(state.current.event) - 1);
+        state.current.event[sizeof(state.current.event) - 1] = '\0';
+      } else if (strcmp(scanner.key(), "start") == 0) {
+        state.current.startEpoch = static_cast<uint32_t>(strtoul(scanner.value(), nullptr, 10));
+      } else if (strcmp(scanner.key(), "end") == 0) {
+        state.current.endEpoch = static_cast<uint32_t>(strtoul(scanner.value(), nullptr, 10));
+      }
+      break;
+    case JsonStreamScanner::Event::ObjectEnd:
+      if (state.inEntry && scanner.depth() == 3) {
+        state.inEntry = false;
+        ++state.received;
+        // Skip alerts that already ended; keep the first ones in provider order.
+        if (state.count < kMaxWeatherAlerts && state.current.event[0] != '\0' &&
+            state.current.endEpoch > state.utcNow) {
+          state.parsed[state.count++] = state.current;
+        }
+      }
+      break;
+  }
+}
+
+// Collects minutely precipitation from a streamed OneCall minutely payload.
+struct NowcastParseState {
+  NowcastData parsed;
+  bool inMinutely;
+};
+
+// Scanner callback: root{ minutely[ {dt,precipitation} ] } entries sit at depth 3.
+void onNowcastToken(void* context, JsonStreamScanner::Event event, const JsonStreamScanner& scanner) {
+  NowcastParseState& state = *static_cast<NowcastParseState*>(context);
+  if (event == JsonStreamScanner::Event::ArrayStart && scanner.depth() == 2) {
+    state.inMinutely = strcmp(scanner.key(), "minutely") == 0;
+    return;
+  }
+  if (event == JsonStreamScanner::Event::ArrayEnd && scanner.depth() == 2) {
+    state.inMinutely = false;
+    return;
+  }
+  if (event != JsonStreamScanner::Event::Value || !state.inMinutely || scanner.depth() != 3) {
+    return;
+  }
+  NowcastData& nowcast = state.parsed;
+  if (strcmp(scanner.key(), "dt") == 0) {
+    if (nowcast.count == 0) {
+      nowcast.startEpoch = static_cast<uint32_t>(strtoul(scanner.value(), nullptr, 10));
+    }
+  } else if (strcmp(scanner.key(), "precipitation") == 0 && nowcast.count < kNowcastSamples) {
+    // Quantize mm/h to kNowcastStepMmPerHour steps, saturating at 255.
+    // Micro-mm/h keeps every digit OpenWeather sends, so the step division is the only rounding.
+    constexpr int32_t kStepMicro = static_cast<int32_t>(kNowcastStepMmPerHour * 1000000.0f + 0.5f);
+    int32_t microMmPerHour = 0;
+    parseScaledInt(scanner.value(), kFixedMicro, microMmPerHour);
+    const int32_t steps = roundScaled(microMmPerHour, kStepMicro);
+    nowcast.intensity[nowcast.count++] = steps <= 0 ? 0 : (steps >= 255 ? 255 : static_cast<uint8_t>(steps));
+  }
+}
+
+// Clamps a probability already parsed as percent into [0..100].
+int clampToPercent(int32_t popPct) {
+  if (popPct < 0) {
+    popPct = 0;
   }
-  return static_cast<int>(pop * 100.0 + 0.5);
+  if (popPct > 100) {
+    popPct = 100;
+  }
+  return popPct;
 }
 
 // Finds the matching closing brace index for an object starting at openPos.
@@ -69,8 +330,8 @@ int findMatchingBracket(const String& text, int openPos) {
   return -1;
 }
 
-// Reads a numeric field allowing optional whitespace after ':'.
-bool parseFieldNumberFlexible(const String& json, const char* fieldName, double& outValue) {
+// Reads a scaled numeric field allowing optional whitespace after ':'.
+bool parseFieldNumberFlexible(const String& json, const char* fieldName, uint8_t decimals, int32_t& outValue) {
   if (fieldName == nullptr) {
     return false;
   }
@@ -85,117 +346,48 @@ bool parseFieldNumberFlexible(const String& json, const char* fieldName, double&
     return false;
   }
 
-  int valueStart = colonPos + 1;
-  while (valueStart < static_cast<int>(json.length()) &&
-         (json[valueStart] == ' ' || json[valueStart] == '\t' || json[valueStart] == '\r' ||
-          json[valueStart] == '\n')) {
-    ++valueStart;
-  }
-
-  int valueEnd = valueStart;
-  while (valueEnd < static_cast<int>(json.length())) {
-    const char c = json[valueEnd];
-    const bool numericChar = (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
-    if (!numericChar) {
-      break;
-    }
-    ++valueEnd;
-  }
-
-  if (valueEnd <= valueStart) {
-    return false;
-  }
-
-  outValue = json.substring(valueStart, valueEnd).toFloat();
-  return true;
+  return parseScaledInt(json.c_str() + colonPos + 1, decimals, outValue);
 }
 
-// Emits a normalized summary of parsed weather fields for serial debugging.
+// Queues a normalized summary of parsed weather fields; per-row detail is debug level.
 void logParsedWeather(const WeatherData& weather) {
-  Serial.println("[OWM] ---- Parsed Weather ----");
-  Serial.print("[OWM] Current: temp=");
-  Serial.print(weather.temperatureF);
-  Serial.print("F feels=");
-  Serial.print(weather.feelsLikeF);
-  Serial.print("F rain=");
-  Serial.print(weather.rainChancePct);
-  Serial.print("% wind=");
-  Serial.print(weather.windMph);
-  Serial.print("mph gust=");
-  Serial.print(weather.gustMph);
-  Serial.print("mph deg=");
-  Serial.println(weather.windDeg);
-
-  Serial.print("[OWM] Today: high=");
-  Serial.print(weather.todayHighF);
-  Serial.print(" low=");
-  Serial.print(weather.todayLowF);
-  Serial.print(" sunrise=");
-  Serial.print(weather.sunriseHour);
-  Serial.print(":");
-  if (weather.sunriseMinute < 10) Serial.print("0");
-  Serial.print(weather.sunriseMinute);
-  Serial.print(" sunset=");
-  Serial.print(weather.sunsetHour);
-  Serial.print(":");
-  if (weather.sunsetMinute < 10) Serial.print("0");
-  Serial.println(weather.sunsetMinute);
-
-  for (int i = 0; i < 4; ++i) {
-    Serial.print("[OWM] Hourly[");
-    Serial.print(i);
-    Serial.print("]: h=");
-    Serial.print(weather.hourlyHour24[i]);
-    Serial.print(" temp=");
-    Serial.print(weather.hourlyTempF[i]);
-    Serial.print(" main=");
-    Serial.print(weather.hourlyMain[i]);
-    Serial.print(" type=");
-    Serial.println(static_cast<int>(weather.hourlyType[i]));
+  LOG_INFO(OwmParsedCurrent, weather.temperatureF, weather.feelsLikeF, weather.rainChancePct, weather.windMph,
+           weather.gustMph, weather.windDeg);
+  LOG_INFO(OwmParsedToday, weather.todayHighF, weather.todayLowF, weather.sunriseHour, weather.sunriseMinute,
+           weather.sunsetHour, weather.sunsetMinute);
+  for (uint8_t i = 0; i < 4; ++i) {
+    LOG_DEBUG(OwmParsedHourly, i, weather.hourlyHour24[i], weather.hourlyTempF[i], weather.hourlyMain[i],
+              static_cast<uint8_t>(weather.hourlyType[i]));
   }
-
-  for (int i = 0; i < 4; ++i) {
-    Serial.print("[OWM] Daily[");
-    Serial.print(i);
-    Serial.print("]: dow=");
-    Serial.print(weather.dailyDow[i]);
-    Serial.print(" high=");
-    Serial.print(weather.dailyHighF[i]);
-    Serial.print(" low=");
-    Serial.print(weather.dailyLowF[i]);
-    Serial.print(" main=");
-    Serial.print(weather.dailyMain[i]);
-    Serial.print(" type=");
-    Serial.println(static_cast<int>(weather.dailyType[i]));
+  for (uint8_t i = 0; i < 4; ++i) {
+    LOG_DEBUG(OwmParsedDaily, i, weather.dailyDow[i], weather.dailyHighF[i], weather.dailyLowF[i],
+              weather.dailyMain[i], static_cast<uint8_t>(weather.dailyType[i]));
   }
-
-  Serial.print("[OWM] Advisory: ");
-  Serial.println(weather.advisory);
-  Serial.println("[OWM] -----------------------");
+  LOG_INFO(OwmParsedAdvisory, weather.advisory);
 }
 
 }  // namespace
 
 // Initializes parser/fetch service with config source and empty derived state.
 OpenWeatherService::OpenWeatherService(const OpenWeatherConfigService& configService)
-    : configService_(configService) {
+    : configService_(configService), retryPolicy_("OWM", kOwmRetryConfig) {
   lastLocationName_[0] = '\0';
   detectedUtcOffsetSeconds_ = 0;
 }
 
+// Transport errors (negative codes), rate limiting and server errors are transient.
+bool OpenWeatherService::isRetryableHttpCode(int httpCode) {
+  return httpCode < 0 || httpCode == 429 || httpCode >= 500;
+}
+
 // Finds a JSON section by key and returns its index or -1.
 int OpenWeatherService::findSection(const String& json, const char* sectionKey) {
   return json.indexOf(sectionKey);
 }
 
-// Rounds floating-point value to nearest integer using half-away-from-zero behavior.
-int OpenWeatherService::roundToInt(double value) {
-  return static_cast<int>(value + (value >= 0 ? 0.5 : -0.5));
-}
-
-// Parses a numeric field from the root payload.
-bool OpenWeatherService::parseNumber(const String& json, const char* key, double& outValue) {
-  return parseNumberFrom(json, key, 0, outValue, nullptr);
+// Parses a scaled numeric field from the root payload.
+bool OpenWeatherService::parseNumber(const String& json, const char* key, uint8_t decimals, int32_t& outValue) {
+  return parseNumberFrom(json, key, 0, decimals, outValue, nullptr);
 }
 
 // Parses an integer field from the root payload.
@@ -203,9 +395,9 @@ bool OpenWeatherService::parseInt(const String& json, const char* key, int& outV
   return parseIntFrom(json, key, 0, outValue, nullptr);
 }
 
-// Parses a numeric field by key from an offset and optionally returns end position.
+// Parses a numeric field by key from an offset into a scaled integer and optionally returns end position.
 bool OpenWeatherService::parseNumberFrom(
-    const String& json, const char* key, int start, double& outValue, int* valuePos) {
+    const String& json, const char* key, int start, uint8_t decimals, int32_t& outValue, int* valuePos) {
   if (key == nullptr || start < 0) {
     return false;
   }
@@ -215,41 +407,23 @@ bool OpenWeatherService::parseNumberFrom(
     return false;
   }
 
-  const size_t keyPos = static_cast<size_t>(keyPosInt);
-  const size_t jsonLen = json.length();
-  size_t valueStart = keyPos + strlen(key);
-  while (valueStart < jsonLen &&
-         (json[valueStart] == ' ' || json[valueStart] == '\t' || json[valueStart] == '\r' ||
-          json[valueStart] == '\n')) {
-    ++valueStart;
-  }
-
-  size_t valueEnd = valueStart;
-  while (valueEnd < jsonLen) {
-    const char c = json[valueEnd];
-    const bool numericChar = (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.';
-    if (!numericChar) {
-      break;
-    }
-    ++valueEnd;
-  }
-
-  if (valueEnd <= valueStart) {
+  // Parse in place: no substring copy, no soft-float conversion.
+  const char* base = json.c_str();
+  const char* end = nullptr;
+  if (!parseScaledInt(base + keyPosInt + strlen(key), decimals, outValue, &end)) {
     return false;
   }
-
-  const String numberText = json.substring(valueStart, valueEnd);
-  outValue = numberText.toFloat();
   if (valuePos != nullptr) {
-    *valuePos = static_cast<int>(valueEnd);
+    *valuePos = static_cast<int>(end - base);
   }
   return true;
 }
 
 // Parses an integer field by key from an offset and optionally returns end position.
 bool OpenWeatherService::parseIntFrom(const String& json, const char* key, int start, int& outValue, int* valuePos) {
-  double parsed = 0;
-  if (!parseNumberFrom(json, key, start, parsed, valuePos)) {
+  // Integer fields (ids, epochs, degrees) are integral in the payload; decoding stays exact past 2^24.
+  int32_t parsed = 0;
+  if (!parseNumberFrom(json, key, start, 0, parsed, valuePos)) {
     return false;
   }
   outValue = static_cast<int>(parsed);
@@ -318,42 +492,47 @@ WeatherType OpenWeatherService::mapWeatherType(int weatherId) {
 
 // Resolves configured ZIP code into latitude/longitude through OpenWeather geocoding.
 bool OpenWeatherService::fetchCoordinatesForZip(
-    const char* zipInput, const char* apiKey, double& lat, double& lon, ProgressCallback progress) const {
+    const char* zipInput, const char* apiKey, int32_t& latMicrodeg, int32_t& lonMicrodeg,
+    ProgressCallback progress) const {
+  TRACE_SCOPE("geocode");
   if (progress != nullptr) {
     progress("Weather API", "Getting coordinates", String("ZIP: ") + zipInput, "");
   }
-  const String geoUrl = String("https://api.openweathermap.org/geo/1.0/zip?zip=") +
-                        zipInput + "&appid=" + apiKey;
-  Serial.print("[OWM] Geocode request: ");
-  Serial.println(geoUrl);
-  SecureClient client;
-  client.setInsecure();
-  HTTPClient http;
-  if (!http.begin(client, geoUrl)) {
-    Serial.println("[OWM] Geocode begin() failed");
+  RequestArena& arena = requestArena();
+  if (!formatRequestUrl(arena, "Geocode", kGeocodeUrlFormat, zipInput, apiKey)) {
     return false;
   }
-
-  http.setTimeout(10000);
+  // The URL carries the API key; log only the ZIP.
+  LOG_INFO(OwmGeocodeRequest, zipInput);
+  HTTPClient& http = arena.http;
+  if (!beginRequest(arena, 10000)) {
+    LOG_ERROR(OwmGeocodeBeginFailed);
+    recordFailure(Metrics::kCodeBeginFailed);
+    return false;
+  }
+  ++apiCallCount_;
   const int httpCode = http.GET();
   if (httpCode != HTTP_CODE_OK) {
-    Serial.print("[OWM] Geocode HTTP error: ");
-    Serial.println(httpCode);
+    LOG_ERROR(OwmGeocodeHttpError, httpCode);
+    const uint32_t retryAfterMs = RetryPolicy::parseRetryAfterMs(http.header("Retry-After").c_str());
     const String body = http.getString();
     if (body.length() > 0) {
-      Serial.print("[OWM] Geocode response: ");
-      Serial.println(body);
+      LOG_WARN(OwmGeocodeResponse, body.c_str());
     }
     http.end();
+    recordFailure(httpCode, retryAfterMs);
     return false;
   }
 
   const String payload = http.getString();
   http.end();
+  if (metrics_ != nullptr) {
+    metrics_->observePayloadBytes(payload.length());
+  }
 
-  if (!parseNumber(payload, "\"lat\":", lat) || !parseNumber(payload, "\"lon\":", lon)) {
-    Serial.println("[OWM] Failed to parse lat/lon from geocode payload");
-    Serial.println(payload);
+  if (!parseNumber(payload, "\"lat\":", kFixedMicro, latMicrodeg) ||
+      !parseNumber(payload, "\"lon\":", kFixedMicro, lonMicrodeg)) {
+    LOG_ERROR(OwmGeocodeParseFailed, payload.c_str());
     return false;
   }
 
@@ -362,155 +541,135 @@ bool OpenWeatherService::fetchCoordinatesForZip(
     lastLocationName_[sizeof(lastLocationName_) - 1] = '\0';
   }
 
-  Serial.print("[OWM] Geocode success lat/lon: ");
-  Serial.print(lat, 6);
-  Serial.print(", ");
-  Serial.println(lon, 6);
+  char latText[16];
+  char lonText[16];
+  formatScaled(latMicrodeg, kFixedMicro, latText, sizeof(latText));
+  formatScaled(lonMicrodeg, kFixedMicro, lonText, sizeof(lonText));
+  LOG_INFO(OwmGeocodeSuccess, latText, lonText);
   return true;
 }
 
-// Fetches and parses OneCall payload into display model fields.
-bool OpenWeatherService::fetchWeatherByCoordinates(
-    double lat, double lon, const char* apiKey, WeatherData& weather, ProgressCallback progress) const {
-  if (progress != nullptr) {
-    progress("Weather API", String("Getting weather for"), String(lastLocationName_), "");
+// Fetches one OneCall section set with retry + full-length validation.
+bool OpenWeatherService::fetchOneCallPayload(
+    int32_t latMicrodeg, int32_t lonMicrodeg, const char* apiKey, const char* exclude, const char* tag,
+    String& outPayload) const {
+  TRACE_SCOPE("onecall-read");
+  char latText[16];
+  char lonText[16];
+  formatScaled(latMicrodeg, kFixedMicro, latText, sizeof(latText));
+  formatScaled(lonMicrodeg, kFixedMicro, lonText, sizeof(lonText));
+  RequestArena& arena = requestArena();
+  if (!formatRequestUrl(arena, tag, kOneCallUrlFormat, latText, lonText, exclude, apiKey)) {
+    return false;
   }
-  // Small helper that fetches a OneCall payload with retry + full-length validation.
-  auto fetchOneCallPayload = [&](const char* exclude, const char* tag, String& outPayload) -> bool {
-    const String url = String("https://api.openweathermap.org/data/3.0/onecall?lat=") + String(lat, 6) +
-                       "&lon=" + String(lon, 6) + "&units=imperial&exclude=" + exclude + "&appid=" + apiKey;
-    for (int attempt = 1; attempt <= 2; ++attempt) {
-      Serial.print("[OWM] ");
-      Serial.print(tag);
-      Serial.print(" request (attempt ");
-      Serial.print(attempt);
-      Serial.print("): ");
-      Serial.println(url);
-
-      SecureClient client;
-      client.setInsecure();
-      // Larger RX buffer helps prevent truncated reads on larger payloads.
-#if defined(ARDUINO_ARCH_ESP8266)
-      client.setBufferSizes(4096, 1024);
-#endif
-
-      HTTPClient http;
-      if (!http.begin(client, url)) {
-        Serial.print("[OWM] ");
-        Serial.print(tag);
-        Serial.println(" begin() failed");
+  HTTPClient& http = arena.http;
+  for (int attempt = 1; attempt <= kMaxOneCallAttempts; ++attempt) {
+    if (attempt > 1) {
+      // Follow the shared backoff; long waits (Retry-After, open breaker) end this sync instead.
+      const uint32_t waitMs = retryPolicy_.msUntilNextAttempt(millis());
+      if (waitMs > kMaxInlineRetryWaitMs || retryPolicy_.state() == RetryPolicy::State::Open) {
+        LOG_WARN(OwmGivingUp, tag, waitMs);
         return false;
       }
-
-      const char* headerKeys[] = {"Content-Type", "Content-Encoding", "Transfer-Encoding", "Content-Length"};
-      http.collectHeaders(headerKeys, 4);
-      http.useHTTP10(true);
-      http.addHeader("Accept-Encoding", "identity");
-      http.setTimeout(20000);
-      const int httpCode = http.GET();
-      if (httpCode != HTTP_CODE_OK) {
-        Serial.print("[OWM] ");
-        Serial.print(tag);
-        Serial.print(" HTTP error: ");
-        Serial.println(httpCode);
-        const String body = http.getString();
-        if (body.length() > 0) {
-          Serial.print("[OWM] ");
-          Serial.print(tag);
-          Serial.print(" response: ");
-          Serial.println(body);
-        }
-        http.end();
-        if (attempt == 2) {
-          return false;
-        }
-        delay(200);
-        continue;
+      delay(waitMs);
+      retryPolicy_.allowAttempt(millis());
+      if (metrics_ != nullptr) {
+        metrics_->recordRetry();
       }
+    }
 
-      const int contentLength = http.getSize();
-      Serial.print("[OWM] ");
-      Serial.print(tag);
-      Serial.print(" Content-Length: ");
-      Serial.println(http.header("Content-Length"));
-      Serial.print("[OWM] ");
-      Serial.print(tag);
-      Serial.print(" Content-Encoding: ");
-      Serial.println(http.header("Content-Encoding"));
-      Serial.print("[OWM] ");
-      Serial.print(tag);
-      Serial.print(" Transfer-Encoding: ");
-      Serial.println(http.header("Transfer-Encoding"));
-
-      constexpr int kMaxPayloadBytes = 30000;
-      outPayload = "";
-      if (contentLength > 0 && contentLength < kMaxPayloadBytes) {
-        outPayload.reserve(static_cast<unsigned int>(contentLength + 64));
-      } else {
-        outPayload.reserve(kMaxPayloadBytes);
-      }
+    // The URL carries the API key; log only the request parameters.
+    LOG_INFO(OwmRequest, tag, attempt, latText, lonText, exclude);
 
-      WiFiClient* stream = http.getStreamPtr();
-      char buf[512];
-      unsigned long lastReadMs = millis();
-      while ((http.connected() || stream->available() > 0) && outPayload.length() < kMaxPayloadBytes) {
-        int available = stream->available();
-        if (available > 0) {
-          int toRead = available;
-          if (toRead > static_cast<int>(sizeof(buf))) {
-            toRead = static_cast<int>(sizeof(buf));
-          }
-          const size_t got = stream->readBytes(buf, static_cast<size_t>(toRead));
-          if (got > 0) {
-            outPayload.concat(buf, got);
-            lastReadMs = millis();
-          }
-        } else {
-          if (millis() - lastReadMs > 30000) {
-            break;
-          }
-          delay(1);
-        }
+    if (!beginRequest(arena, 20000)) {
+      LOG_ERROR(OwmBeginFailed, tag);
+      recordFailure(Metrics::kCodeBeginFailed);
+      return false;
+    }
+    ++apiCallCount_;
+    const int httpCode = http.GET();
+    if (httpCode != HTTP_CODE_OK) {
+      LOG_ERROR(OwmHttpError, tag, httpCode);
+      const uint32_t retryAfterMs = RetryPolicy::parseRetryAfterMs(http.header("Retry-After").c_str());
+      const String body = http.getString();
+      if (body.length() > 0) {
+        LOG_WARN(OwmHttpErrorBody, tag, body.c_str());
       }
       http.end();
+      recordFailure(httpCode, retryAfterMs);
+      if (!isRetryableHttpCode(httpCode)) {
+        // Bad key / bad request: retrying inside this sync cannot help.
+        return false;
+      }
+      continue;
+    }
+
+    const int contentLength = http.getSize();
+    LOG_DEBUG(OwmResponseHeaders, tag, http.header("Content-Length").c_str(), http.header("Content-Encoding").c_str(),
+              http.header("Transfer-Encoding").c_str());
 
-      Serial.print("[OWM] ");
-      Serial.print(tag);
-      Serial.print(" payload length=");
-      Serial.println(outPayload.length());
-
-      if (contentLength > 0 && outPayload.length() > 0 &&
-          static_cast<int>(outPayload.length()) != contentLength) {
-        Serial.print("[OWM] ");
-        Serial.print(tag);
-        Serial.print(" partial payload: got ");
-        Serial.print(outPayload.length());
-        Serial.print(" expected ");
-        Serial.println(contentLength);
-        if (attempt == 2) {
-          return false;
+    constexpr int kMaxPayloadBytes = 30000;
+    outPayload = "";
+    if (contentLength > 0 && contentLength < kMaxPayloadBytes) {
+      outPayload.reserve(static_cast<unsigned int>(contentLength + 64));
+    } else {
+      outPayload.reserve(kMaxPayloadBytes);
+    }
+
+    WiFiClient* stream = http.getStreamPtr();
+    char buf[512];
+    unsigned long lastReadMs = millis();
+    while ((http.connected() || stream->available() > 0) && outPayload.length() < kMaxPayloadBytes) {
+      int available = stream->available();
+      if (available > 0) {
+        int toRead = available;
+        if (toRead > static_cast<int>(sizeof(buf))) {
+          toRead = static_cast<int>(sizeof(buf));
         }
-        delay(200);
-        continue;
+        const size_t got = stream->readBytes(buf, static_cast<size_t>(toRead));
+        if (got > 0) {
+          outPayload.concat(buf, got);
+          lastReadMs = millis();
+        }
+      } else {
+        if (millis() - lastReadMs > 30000) {
+          break;
+        }
+        delay(1);
       }
-
-      return outPayload.length() > 0;
     }
+    http.end();
 
-    return false;
-  };
+    LOG_INFO(OwmPayloadLength, tag, outPayload.length());
 
-  String corePayload;
-  if (!fetchOneCallPayload("minutely,alerts", "OneCall(core)", corePayload)) {
-    return false;
+    if (contentLength > 0 && outPayload.length() > 0 &&
+        static_cast<int>(outPayload.length()) != contentLength) {
+      LOG_WARN(OwmPartialPayload, tag, outPayload.length(), contentLength);
+      recordFailure(Metrics::kCodeIncomplete);
+      continue;
+    }
+
+    if (outPayload.length() == 0) {
+      recordFailure(Metrics::kCodeIncomplete);
+      continue;
+    }
+    retryPolicy_.recordSuccess();
+    if (metrics_ != nullptr) {
+      metrics_->observePayloadBytes(outPayload.length());
+    }
+    return true;
   }
 
+  return false;
+}
+
+// Parses current + hourly sections; resets only the fields it owns.
+bool OpenWeatherService::parseCoreSections(const String& corePayload, WeatherData& weather) const {
+  TRACE_SCOPE("parse-core");
   // Defaults
   weather.rainChancePct = 0;
   weather.snowChancePct = 0;
   weather.feelsLikeF = 0;
-  weather.todayHighF = 0;
-  weather.todayLowF = 0;
   weather.sunriseHour = 0;
   weather.sunriseMinute = 0;
   weather.sunsetHour = 0;
@@ -518,18 +677,11 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
   weather.windMph = 0;
   weather.gustMph = 0;
   weather.windDeg = 0;
-  strncpy(weather.advisory, "NO ADVISORIES", sizeof(weather.advisory) - 1);
-  weather.advisory[sizeof(weather.advisory) - 1] = '\0';
   for (int i = 0; i < 4; ++i) {
     weather.hourlyHour24[i] = 0;
     weather.hourlyTempF[i] = 0;
     weather.hourlyType[i] = WeatherType::Cloudy;
     weather.hourlyMain[i][0] = '\0';
-    weather.dailyDow[i] = 0;
-    weather.dailyHighF[i] = 0;
-    weather.dailyLowF[i] = 0;
-    weather.dailyType[i] = WeatherType::Cloudy;
-    weather.dailyMain[i][0] = '\0';
   }
 
   int timezoneOffsetSec = 0;
@@ -537,42 +689,33 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
   char timezoneName[40] = {0};
   parseStringFrom(corePayload, "\"timezone\":\"", 0, timezoneName, sizeof(timezoneName), nullptr);
   detectedUtcOffsetSeconds_ = timezoneOffsetSec;
-  Serial.print("[OWM] Timezone from API: iana='");
-  Serial.print(timezoneName);
-  Serial.print("' offsetSec=");
-  Serial.print(timezoneOffsetSec);
-  Serial.println("'");
+  LOG_INFO(OwmTimezone, timezoneName, timezoneOffsetSec);
 
   const int currentPos = findSection(corePayload, "\"current\":");
-  double currentTemp = 0;
+  int32_t currentTempF = 0;
   int currentId = 0;
   const int currentStart = (currentPos >= 0) ? currentPos : 0;
-  if (!parseNumberFrom(corePayload, "\"temp\":", currentStart, currentTemp, nullptr) ||
+  if (!parseNumberFrom(corePayload, "\"temp\":", currentStart, kFixedWhole, currentTempF, nullptr) ||
       !(parseIntFrom(corePayload, "\"weather\":[{\"id\":", currentStart, currentId, nullptr) ||
         parseIntFrom(corePayload, "\"id\":", currentStart, currentId, nullptr))) {
-    Serial.println("[OWM] Failed to parse current temp/weather id");
-    Serial.print("[OWM] currentStart=");
-    Serial.println(currentStart);
-    Serial.print("[OWM] payload head: ");
-    Serial.println(corePayload.substring(0, 220));
+    LOG_ERROR(OwmCurrentParseFailed, currentStart);
+    LOG_ERROR(OwmPayloadHead, corePayload.c_str());
     return false;
   }
-  weather.temperatureF = static_cast<int16_t>(roundToInt(currentTemp));
+  weather.temperatureF = static_cast<int16_t>(currentTempF);
   weather.type = mapWeatherType(currentId);
   weather.feelsLikeF = weather.temperatureF;
-  double currentFeelsLike = 0;
-  if (parseNumberFrom(corePayload, "\"feels_like\":", currentStart, currentFeelsLike, nullptr)) {
-    weather.feelsLikeF = static_cast<int16_t>(roundToInt(currentFeelsLike));
+  int32_t feelsLikeF = 0;
+  if (parseNumberFrom(corePayload, "\"feels_like\":", currentStart, kFixedWhole, feelsLikeF, nullptr)) {
+    weather.feelsLikeF = static_cast<int16_t>(feelsLikeF);
   }
-  weather.todayHighF = weather.temperatureF;
-  weather.todayLowF = weather.temperatureF;
-  double windSpeed = 0;
-  if (parseNumberFrom(corePayload, "\"wind_speed\":", currentStart, windSpeed, nullptr)) {
-    weather.windMph = static_cast<uint8_t>(roundToInt(windSpeed));
+  int32_t windMph = 0;
+  if (parseNumberFrom(corePayload, "\"wind_speed\":", currentStart, kFixedWhole, windMph, nullptr)) {
+    weather.windMph = static_cast<uint8_t>(windMph);
   }
-  double windGust = 0;
-  if (parseNumberFrom(corePayload, "\"wind_gust\":", currentStart, windGust, nullptr)) {
-    weather.gustMph = static_cast<uint8_t>(roundToInt(windGust));
+  int32_t gustMph = 0;
+  if (parseNumberFrom(corePayload, "\"wind_gust\":", currentStart, kFixedWhole, gustMph, nullptr)) {
+    weather.gustMph = static_cast<uint8_t>(gustMph);
   }
   int windDeg = 0;
   if (parseIntFrom(corePayload, "\"wind_deg\":", currentStart, windDeg, nullptr)) {
@@ -583,28 +726,24 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
 
   int sunrise = 0;
   if (parseIntFrom(corePayload, "\"sunrise\":", currentStart, sunrise, nullptr)) {
-    time_t localSunrise = static_cast<time_t>(sunrise + timezoneOffsetSec);
-    tm sunriseInfo{};
-    gmtime_r(&localSunrise, &sunriseInfo);
-    weather.sunriseHour = static_cast<uint8_t>(sunriseInfo.tm_hour);
-    weather.sunriseMinute = static_cast<uint8_t>(sunriseInfo.tm_min);
+    const CivilTime localSunrise = civilTimeFromEpoch(static_cast<int64_t>(sunrise) + timezoneOffsetSec);
+    weather.sunriseHour = localSunrise.hour;
+    weather.sunriseMinute = localSunrise.minute;
   }
 
   int sunset = 0;
   if (parseIntFrom(corePayload, "\"sunset\":", currentStart, sunset, nullptr)) {
-    time_t localSunset = static_cast<time_t>(sunset + timezoneOffsetSec);
-    tm sunsetInfo{};
-    gmtime_r(&localSunset, &sunsetInfo);
-    weather.sunsetHour = static_cast<uint8_t>(sunsetInfo.tm_hour);
-    weather.sunsetMinute = static_cast<uint8_t>(sunsetInfo.tm_min);
+    const CivilTime localSunset = civilTimeFromEpoch(static_cast<int64_t>(sunset) + timezoneOffsetSec);
+    weather.sunsetHour = localSunset.hour;
+    weather.sunsetMinute = localSunset.minute;
   }
 
   const int hourlyPos = findSection(corePayload, "\"hourly\":");
   if (hourlyPos >= 0) {
     // Precip probability from first hourly entry.
-    double pop = 0;
-    if (parseNumberFrom(corePayload, "\"pop\":", hourlyPos, pop, nullptr)) {
-      weather.rainChancePct = static_cast<uint8_t>(clampToPercent(pop));
+    int32_t popPct = 0;
+    if (parseNumberFrom(corePayload, "\"pop\":", hourlyPos, kFixedPercent, popPct, nullptr)) {
+      weather.rainChancePct = static_cast<uint8_t>(clampToPercent(popPct));
     }
 
     // Build hourly targets from the current local hour (rounded down to hh:00),
@@ -612,7 +751,7 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
     time_t targetLocalEpoch[4] = {0, 0, 0, 0};
     int nextTarget = 0;
     const time_t utcNow = time(nullptr);
-    if (utcNow >= 8 * 3600 * 2) {
+    if (TimeService::isClockSet(utcNow)) {
       const time_t localNow = static_cast<time_t>(utcNow + timezoneOffsetSec);
       const time_t baseHour = localNow - (localNow % 3600);
       for (int i = 0; i < 4; ++i) {
@@ -620,17 +759,22 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
       }
     }
 
-    int parsePos = hourlyPos;
+    // Walk every hourly entry: 4 display rows are picked while the full series
+    // goes into the forecast store for scrolling.
+    weather.forecast.clearHourly();
+    const int arrayStart = corePayload.indexOf('[', hourlyPos);
+    const int arrayEnd = findMatchingBracket(corePayload, arrayStart);
+    int parsePos = arrayStart + 1;
     int hourlyIndex = 0;  // Fallback index-based selection if system time is not valid.
     int selectedFallback = 0;
     const int wanted[4] = {2, 4, 6, 8};
-    while (hourlyIndex < 96 && (nextTarget < 4 || selectedFallback < 4)) {
+    while (arrayStart >= 0 && arrayEnd > arrayStart && hourlyIndex < 96) {
       const int objStart = corePayload.indexOf('{', parsePos);
-      if (objStart < 0) {
+      if (objStart < 0 || objStart > arrayEnd) {
         break;
       }
       const int objEnd = findMatchingBrace(corePayload, objStart);
-      if (objEnd < 0) {
+      if (objEnd < 0 || objEnd > arrayEnd) {
         break;
       }
       const String hourJson = corePayload.substring(objStart, objEnd + 1);
@@ -641,12 +785,16 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
         continue;
       }
 
-      double hourTemp = currentTemp;
-      parseNumberFrom(hourJson, "\"temp\":", 0, hourTemp, nullptr);
+      int32_t hourTempF = currentTempF;
+      parseNumberFrom(hourJson, "\"temp\":", 0, kFixedWhole, hourTempF, nullptr);
       int hourId = currentId;
       parseIntFrom(hourJson, "\"id\":", 0, hourId, nullptr);
       char hourMain[12] = {0};
       parseStringFrom(hourJson, "\"main\":\"", 0, hourMain, sizeof(hourMain), nullptr);
+      int32_t hourPopPct = 0;
+      parseNumberFrom(hourJson, "\"pop\":", 0, kFixedPercent, hourPopPct, nullptr);
+      weather.forecast.appendHourly(static_cast<uint32_t>(dt), static_cast<int16_t>(hourTempF),
+                                    mapWeatherType(hourId), static_cast<uint8_t>(clampToPercent(hourPopPct)));
 
       const time_t localDt = static_cast<time_t>(dt + timezoneOffsetSec);
       bool selectedThisEntry = false;
@@ -665,10 +813,8 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
       }
 
       if (selectedThisEntry && targetSlot >= 0 && targetSlot < 4) {
-        tm hourInfo{};
-        gmtime_r(&localDt, &hourInfo);
-        weather.hourlyHour24[targetSlot] = static_cast<uint8_t>(hourInfo.tm_hour);
-        weather.hourlyTempF[targetSlot] = static_cast<int16_t>(roundToInt(hourTemp));
+        weather.hourlyHour24[targetSlot] = civilTimeFromEpoch(localDt).hour;
+        weather.hourlyTempF[targetSlot] = static_cast<int16_t>(hourTempF);
         weather.hourlyType[targetSlot] = mapWeatherType(hourId);
         strncpy(weather.hourlyMain[targetSlot], hourMain, sizeof(weather.hourlyMain[targetSlot]) - 1);
         weather.hourlyMain[targetSlot][sizeof(weather.hourlyMain[targetSlot]) - 1] = '\0';
@@ -676,20 +822,31 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
 
       hourlyIndex++;
     }
+    LOG_INFO(OwmHourlyStored, weather.forecast.hourlyCount);
   }
 
-  const int alertsPos = findSection(corePayload, "\"alerts\":");
-  if (alertsPos >= 0) {
-    if (!parseStringFrom(corePayload, "\"event\":\"", alertsPos, weather.advisory, sizeof(weather.advisory), nullptr)) {
-      strncpy(weather.advisory, "ADVISORY ACTIVE", sizeof(weather.advisory) - 1);
-      weather.advisory[sizeof(weather.advisory) - 1] = '\0';
-    }
-  } else if (weather.gustMph >= 20) {
-    strncpy(weather.advisory, "WIND ADVISORY", sizeof(weather.advisory) - 1);
-    weather.advisory[sizeof(weather.advisory) - 1] = '\0';
+  // Alerts arrive on their own channel; only the gust fallback depends on this payload.
+  refreshAdvisorySummary(weather);
+  return true;
+}
+
+// Parses the daily section into today high/low and the 4-day rows; resets only those fields.
+bool OpenWeatherService::parseDailySection(const String& dailyPayload, WeatherData& weather) const {
+  TRACE_SCOPE("parse-daily");
+  const int timezoneOffsetSec = detectedUtcOffsetSeconds_;
+  const int32_t currentTempF = weather.temperatureF;
+  for (int i = 0; i < 4; ++i) {
+    weather.dailyDow[i] = 0;
+    weather.dailyHighF[i] = 0;
+    weather.dailyLowF[i] = 0;
+    weather.dailyType[i] = WeatherType::Cloudy;
+    weather.dailyMain[i][0] = '\0';
   }
+  weather.todayHighF = weather.temperatureF;
+  weather.todayLowF = weather.temperatureF;
+  weather.forecast.clearDaily();
 
-  // Parse daily directly from the same OneCall payload, preserving array order.
+  // Parse daily rows in array order.
   struct ParsedDailyItem {
     uint8_t dow;
     int16_t high;
@@ -700,22 +857,22 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
   ParsedDailyItem parsedDaily[8]{};
   int parsedDailyCount = 0;
 
-  const int dailyKeyPos = findSection(corePayload, "\"daily\":");
+  const int dailyKeyPos = findSection(dailyPayload, "\"daily\":");
   if (dailyKeyPos >= 0) {
-    const int arrayStart = corePayload.indexOf('[', dailyKeyPos);
-    const int arrayEnd = findMatchingBracket(corePayload, arrayStart);
+    const int arrayStart = dailyPayload.indexOf('[', dailyKeyPos);
+    const int arrayEnd = findMatchingBracket(dailyPayload, arrayStart);
     if (arrayStart >= 0 && arrayEnd > arrayStart) {
       int parsePos = arrayStart + 1;
       while (parsePos < arrayEnd && parsedDailyCount < 8) {
-        const int objStart = corePayload.indexOf('{', parsePos);
+        const int objStart = dailyPayload.indexOf('{', parsePos);
         if (objStart < 0 || objStart > arrayEnd) {
           break;
         }
-        const int objEnd = findMatchingBrace(corePayload, objStart);
+        const int objEnd = findMatchingBrace(dailyPayload, objStart);
         if (objEnd < 0 || objEnd > arrayEnd) {
           break;
         }
-        const String dayJson = corePayload.substring(objStart, objEnd + 1);
+        const String dayJson = dailyPayload.substring(objStart, objEnd + 1);
         parsePos = objEnd + 1;
 
         int dt = 0;
@@ -723,8 +880,8 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
           continue;
         }
 
-        double maxTemp = currentTemp;
-        double minTemp = currentTemp;
+        int32_t maxTempF = currentTempF;
+        int32_t minTempF = currentTempF;
         bool hasMax = false;
         bool hasMin = false;
         const int tempKeyPos = dayJson.indexOf("\"temp\":");
@@ -734,32 +891,35 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
             const int tempObjEnd = findMatchingBrace(dayJson, tempObjStart);
             if (tempObjEnd > tempObjStart) {
               const String tempJson = dayJson.substring(tempObjStart, tempObjEnd + 1);
-              hasMax = parseFieldNumberFlexible(tempJson, "\"max\"", maxTemp);
-              hasMin = parseFieldNumberFlexible(tempJson, "\"min\"", minTemp);
+              hasMax = parseFieldNumberFlexible(tempJson, "\"max\"", kFixedWhole, maxTempF);
+              hasMin = parseFieldNumberFlexible(tempJson, "\"min\"", kFixedWhole, minTempF);
             }
           }
         }
         if (!hasMax) {
-          parseFieldNumberFlexible(dayJson, "\"day\"", maxTemp);
+          parseFieldNumberFlexible(dayJson, "\"day\"", kFixedWhole, maxTempF);
         }
         if (!hasMin) {
-          parseFieldNumberFlexible(dayJson, "\"night\"", minTemp);
+          parseFieldNumberFlexible(dayJson, "\"night\"", kFixedWhole, minTempF);
         }
 
-        int dayId = currentId;
-        parseIntFrom(dayJson, "\"id\":", 0, dayId, nullptr);
+        int dayId = 0;
+        const bool hasDayId = parseIntFrom(dayJson, "\"id\":", 0, dayId, nullptr);
 
-        time_t localDt = static_cast<time_t>(dt + timezoneOffsetSec);
-        tm localInfo{};
-        gmtime_r(&localDt, &localInfo);
-        parsedDaily[parsedDailyCount].dow = static_cast<uint8_t>(localInfo.tm_wday);
-        parsedDaily[parsedDailyCount].high = static_cast<int16_t>(roundToInt(maxTemp));
-        parsedDaily[parsedDailyCount].low = static_cast<int16_t>(roundToInt(minTemp));
-        parsedDaily[parsedDailyCount].type = mapWeatherType(dayId);
+        const int64_t localDt = static_cast<int64_t>(dt) + timezoneOffsetSec;
+        parsedDaily[parsedDailyCount].dow = weekdayFromDays(civilTimeFromEpoch(localDt).days);
+        parsedDaily[parsedDailyCount].high = static_cast<int16_t>(maxTempF);
+        parsedDaily[parsedDailyCount].low = static_cast<int16_t>(minTempF);
+        parsedDaily[parsedDailyCount].type = hasDayId ? mapWeatherType(dayId) : weather.type;
         parsedDaily[parsedDailyCount].main[0] = '\0';
         parseStringFrom(
             dayJson, "\"main\":\"", 0, parsedDaily[parsedDailyCount].main,
             sizeof(parsedDaily[parsedDailyCount].main), nullptr);
+        int32_t dayPopPct = 0;
+        parseNumberFrom(dayJson, "\"pop\":", 0, kFixedPercent, dayPopPct, nullptr);
+        weather.forecast.appendDaily(static_cast<uint32_t>(dt), parsedDaily[parsedDailyCount].high,
+                                     parsedDaily[parsedDailyCount].low, parsedDaily[parsedDailyCount].type,
+                                     static_cast<uint8_t>(clampToPercent(dayPopPct)));
         ++parsedDailyCount;
       }
     }
@@ -772,8 +932,7 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
   }
 
   if (parsedDailyCount < 5) {
-    Serial.print("[OWM] Insufficient daily JSON entries. parsedDailyCount=");
-    Serial.println(parsedDailyCount);
+    LOG_ERROR(OwmDailyInsufficient, parsedDailyCount);
     return false;
   }
 
@@ -794,57 +953,327 @@ bool OpenWeatherService::fetchWeatherByCoordinates(
     ++dailyPageFilled;
   }
   if (dailyPageFilled < 4) {
-    Serial.print("[OWM] Failed to populate 4-day rows from JSON. filled=");
-    Serial.println(dailyPageFilled);
+    LOG_ERROR(OwmDailyRowsFailed, dailyPageFilled);
     return false;
   }
+  return true;
+}
+
+// Fetches core sections every sync and the daily section only when its tier is due.
+bool OpenWeatherService::fetchWeatherByCoordinates(
+    int32_t latMicrodeg, int32_t lonMicrodeg, const char* apiKey, WeatherData& weather,
+    ProgressCallback progress) const {
+  if (progress != nullptr) {
+    progress("Weather API", String("Getting weather for"), String(lastLocationName_), "");
+  }
+
+  uint32_t syncBytes = 0;
+  {
+    String corePayload;
+    phaseBegin(HeapPhase::OneCallRead);
+    const bool fetched =
+        fetchOneCallPayload(latMicrodeg, lonMicrodeg, apiKey, "minutely,daily,alerts", "OneCall(core)", corePayload);
+    phaseEnd(HeapPhase::OneCallRead);
+    if (!fetched) {
+      return false;
+    }
+    lastCoreBytes_ = corePayload.length();
+    syncBytes += lastCoreBytes_;
+    phaseBegin(HeapPhase::Parse);
+    const bool parsed = parseCoreSections(corePayload, weather);
+    phaseEnd(HeapPhase::Parse);
+    if (!parsed) {
+      return false;
+    }
+    weather.latMicrodeg = latMicrodeg;
+    weather.lonMicrodeg = lonMicrodeg;
+    // corePayload is released here, before the daily request allocates its own buffer.
+  }
+
+  const time_t utcNow = time(nullptr);
+  if (dailyTierDue(weather, utcNow)) {
+    String dailyPayload;
+    WeatherData dailyParsed = weather;
+    phaseBegin(HeapPhase::OneCallRead);
+    const bool fetched = fetchOneCallPayload(
+        latMicrodeg, lonMicrodeg, apiKey, "current,minutely,hourly,alerts", "OneCall(daily)", dailyPayload);
+    phaseEnd(HeapPhase::OneCallRead);
+    bool parsed = false;
+    if (fetched) {
+      lastDailyBytes_ = dailyPayload.length();
+      syncBytes += lastDailyBytes_;
+      phaseBegin(HeapPhase::Parse);
+      parsed = parseDailySection(dailyPayload, dailyParsed);
+      phaseEnd(HeapPhase::Parse);
+    }
+    if (parsed) {
+      dailyParsed.dailyFetchedAtEpoch = TimeService::epochOrZero(utcNow);
+      weather = dailyParsed;
+    } else if (!weather.valid) {
+      // No previous daily rows to fall back on.
+      return false;
+    } else {
+      LOG_WARN(OwmDailyTierFailed);
+    }
+  } else {
+    LOG_INFO(OwmDailyTierSkipped);
+  }
+
+  ++tieredSyncs_;
+  totalSyncBytes_ += syncBytes;
+  logTierBytes(syncBytes);
 
   weather.valid = true;
-  Serial.print("[OWM] Weather success: tempF=");
-  Serial.print(weather.temperatureF);
-  Serial.print(" type=");
-  Serial.print(static_cast<int>(weather.type));
-  Serial.print(" rain=");
-  Serial.print(weather.rainChancePct);
-  Serial.print("% wind=");
-  Serial.print(weather.windMph);
-  Serial.print(" gust=");
-  Serial.println(weather.gustMph);
+  LOG_INFO(OwmWeatherSuccess, weather.temperatureF, static_cast<uint8_t>(weather.type), weather.rainChancePct,
+           weather.windMph, weather.gustMph);
   logParsedWeather(weather);
   return true;
 }
 
+// True when the daily section is missing, older than its tier, or from a previous local day.
+bool OpenWeatherService::dailyTierDue(const WeatherData& weather, time_t utcNow) const {
+  if (!weather.valid || weather.dailyFetchedAtEpoch == 0 || !TimeService::isClockSet(utcNow)) {
+    return true;
+  }
+  const time_t fetchedAt = static_cast<time_t>(weather.dailyFetchedAtEpoch);
+  if (utcNow - fetchedAt >= kDailyTierSeconds) {
+    return true;
+  }
+  // daily[0] is "today"; roll the rows over at local midnight.
+  const time_t offset = static_cast<time_t>(detectedUtcOffsetSeconds_);
+  return (utcNow + offset) / 86400 != (fetchedAt + offset) / 86400;
+}
+
+// Logs bytes for this sync and the running average against an untiered request.
+void OpenWeatherService::logTierBytes(uint32_t syncBytes) const {
+  const uint32_t averageBytes = totalSyncBytes_ / tieredSyncs_;
+  if (lastDailyBytes_ == 0) {
+    LOG_INFO(OwmTierBytes, syncBytes, lastCoreBytes_, lastDailyBytes_, averageBytes);
+    return;
+  }
+  // An untiered sync fetches both section sets every time.
+  const uint32_t untieredBytes = lastCoreBytes_ + lastDailyBytes_;
+  const uint32_t reductionPct = static_cast<uint32_t>(100 - (static_cast<uint64_t>(averageBytes) * 100U) / untieredBytes);
+  LOG_INFO(OwmTierBytesSaved, syncBytes, lastCoreBytes_, lastDailyBytes_, averageBytes, untieredBytes, reductionPct);
+}
+
 // Runs full refresh flow: validate config, geocode ZIP, fetch weather payload.
 bool OpenWeatherService::refreshWeather(WeatherData& weather, ProgressCallback progress) const {
+  TRACE_SCOPE("weather");
   const char* zip = configService_.zipCode();
   const char* apiKey = configService_.apiKey();
 
   if (zip == nullptr || zip[0] == '\0' || apiKey == nullptr || apiKey[0] == '\0' || WiFi.status() != WL_CONNECTED) {
-    Serial.print("[OWM] Missing config or WiFi down. zip='");
-    Serial.print(zip == nullptr ? "(null)" : zip);
-    Serial.print("' apiKeyLen=");
-    Serial.print(apiKey == nullptr ? 0 : static_cast<int>(strlen(apiKey)));
-    Serial.print(" wifi=");
-    Serial.println(static_cast<int>(WiFi.status()));
-    weather.valid = false;
+    LOG_WARN(OwmMissingConfig, zip, apiKey == nullptr ? 0U : static_cast<uint32_t>(strlen(apiKey)),
+             static_cast<int>(WiFi.status()));
+    return false;
+  }
+
+  if (!retryPolicy_.allowAttempt(millis())) {
+    LOG_INFO(OwmSkippingRefresh, retryPolicy_.msUntilNextAttempt(millis()));
+    return false;
+  }
+
+  int32_t latMicrodeg = 0;
+  int32_t lonMicrodeg = 0;
+  phaseBegin(HeapPhase::Geocode);
+  const bool geocoded = fetchCoordinatesForZip(zip, apiKey, latMicrodeg, lonMicrodeg, progress);
+  phaseEnd(HeapPhase::Geocode);
+  if (!geocoded) {
+    return false;
+  }
+  // The alerts channel reuses the last resolved location.
+  lastLatMicrodeg_ = latMicrodeg;
+  lastLonMicrodeg_ = lonMicrodeg;
+  hasCoordinates_ = true;
+
+  // Parse into a scratch copy so a failed refresh leaves the cached data untouched.
+  WeatherData parsed = weather;
+  if (!fetchWeatherByCoordinates(latMicrodeg, lonMicrodeg, apiKey, parsed, progress)) {
+    return false;
+  }
+
+  weather = parsed;
+  return true;
+}
+
+// Streams one small OneCall section set through a scanner without buffering the body.
+bool OpenWeatherService::streamOneCallSection(
+    const char* exclude, const char* tag, JsonStreamScanner& scanner, uint32_t& bytes) const {
+  TRACE_SCOPE("stream-section");
+  bytes = 0;
+  const char* apiKey = configService_.apiKey();
+  if (!hasCoordinates_ || apiKey == nullptr || apiKey[0] == '\0' || WiFi.status() != WL_CONNECTED) {
+    return false;
+  }
+  if (!retryPolicy_.allowAttempt(millis())) {
+    LOG_INFO(OwmSkippingSection, tag, retryPolicy_.msUntilNextAttempt(millis()));
     return false;
   }
 
-  double lat = 0;
-  double lon = 0;
-  if (!fetchCoordinatesForZip(zip, apiKey, lat, lon, progress)) {
-    weather.valid = false;
+  char latText[16];
+  char lonText[16];
+  formatScaled(lastLatMicrodeg_, kFixedMicro, latText, sizeof(latText));
+  formatScaled(lastLonMicrodeg_, kFixedMicro, lonText, sizeof(lonText));
+  RequestArena& arena = requestArena();
+  if (!formatRequestUrl(arena, tag, kOneCallUrlFormat, latText, lonText, exclude, apiKey)) {
     return false;
   }
+  // The URL carries the API key; log only the request parameters.
+  LOG_INFO(OwmStreamRequest, tag, latText, lonText, exclude);
 
-  if (!fetchWeatherByCoordinates(lat, lon, apiKey, weather, progress)) {
-    weather.valid = false;
+  HTTPClient& http = arena.http;
+  if (!beginRequest(arena, 20000)) {
+    LOG_ERROR(OwmBeginFailed, tag);
+    recordFailure(Metrics::kCodeBeginFailed);
     return false;
   }
+  ++apiCallCount_;
+  const int httpCode = http.GET();
+  if (httpCode != HTTP_CODE_OK) {
+    LOG_ERROR(OwmHttpError, tag, httpCode);
+    const uint32_t retryAfterMs = RetryPolicy::parseRetryAfterMs(http.header("Retry-After").c_str());
+    http.end();
+    recordFailure(httpCode, retryAfterMs);
+    return false;
+  }
+
+  WiFiClient* stream = http.getStreamPtr();
+  char buf[128];
+  unsigned long lastReadMs = millis();
+  while ((http.connected() || stream->available() > 0) && !scanner.failed()) {
+    const int available = stream->available();
+    if (available > 0) {
+      const size_t toRead = available < static_cast<int>(sizeof(buf)) ? static_cast<size_t>(available) : sizeof(buf);
+      const size_t got = stream->readBytes(buf, toRead);
+      scanner.feed(buf, got);
+      bytes += got;
+      lastReadMs = millis();
+    } else {
+      if (millis() - lastReadMs > 20000) {
+        break;
+      }
+      delay(1);
+    }
+  }
+  http.end();
 
+  if (bytes == 0 || scanner.failed() || scanner.depth() != 0) {
+    LOG_WARN(OwmStreamIncomplete, tag, bytes);
+    recordFailure(Metrics::kCodeIncomplete);
+    return false;
+  }
+  retryPolicy_.recordSuccess();
+  if (metrics_ != nullptr) {
+    metrics_->observePayloadBytes(bytes);
+  }
+  return true;
+}
+
+// Fetches only the alerts section and stream-parses it into the advisory list.
+bool OpenWeatherService::refreshAlerts(WeatherData& weather) const {
+  const time_t utcNow = time(nullptr);
+  if (!TimeService::isClockSet(utcNow)) {
+    // Expiry times are meaningless without a synced clock.
+    return false;
+  }
+
+  // Alert descriptions can run to kilobytes; the scanner keeps only event/start/end.
+  AlertParseState state{};
+  state.utcNow = static_cast<uint32_t>(utcNow);
+  JsonStreamScanner scanner(onAlertToken, &state);
+  uint32_t bytes = 0;
+  // Streamed sections parse while reading, so the whole exchange counts as a read phase.
+  phaseBegin(HeapPhase::OneCallRead);
+  const bool streamed = streamOneCallSection("current,minutely,hourly,daily", "Alerts", scanner, bytes);
+  phaseEnd(HeapPhase::OneCallRead);
+  if (!streamed) {
+    return false;
+  }
+
+  memcpy(weather.alerts, state.parsed, sizeof(weather.alerts));
+  weather.alertCount = state.count;
+  weather.alertsFetchedAtEpoch = state.utcNow;
+  refreshAdvisorySummary(weather);
+
+  LOG_INFO(OwmAlerts, bytes, state.received, state.count);
+  for (uint8_t i = 0; i < state.count; ++i) {
+    LOG_INFO(OwmAlert, i, weather.alerts[i].event, weather.alerts[i].startEpoch, weather.alerts[i].endEpoch);
+  }
   return true;
 }
 
+// Fetches only the minutely section and quantizes it into the nowcast ring.
+bool OpenWeatherService::refreshNowcast(NowcastData& nowcast) const {
+  const time_t utcNow = time(nullptr);
+  if (!TimeService::isClockSet(utcNow)) {
+    return false;
+  }
+
+  NowcastParseState state{};
+  JsonStreamScanner scanner(onNowcastToken, &state);
+  uint32_t bytes = 0;
+  phaseBegin(HeapPhase::OneCallRead);
+  const bool streamed = streamOneCallSection("current,hourly,daily,alerts", "Nowcast", scanner, bytes);
+  phaseEnd(HeapPhase::OneCallRead);
+  if (!streamed) {
+    return false;
+  }
+  if (state.parsed.count == 0) {
+    LOG_WARN(OwmNowcastEmpty);
+    return false;
+  }
+
+  state.parsed.fetchedAtEpoch = static_cast<uint32_t>(utcNow);
+  nowcast = state.parsed;
+  uint8_t peak = 0;
+  for (uint8_t i = 0; i < nowcast.count; ++i) {
+    if (nowcast.intensity[i] > peak) {
+      peak = nowcast.intensity[i];
+    }
+  }
+  LOG_INFO(OwmNowcast, bytes, nowcast.count, peak);
+  return true;
+}
+
+// Attaches optional heap instrumentation for sync phases.
+void OpenWeatherService::setHeapMonitor(HeapMonitor* monitor) {
+  heapMonitor_ = monitor;
+}
+
+// Attaches optional timing/failure metrics for sync phases and requests.
+void OpenWeatherService::setMetrics(Metrics* metrics) {
+  metrics_ = metrics;
+}
+
+// Samples heap and starts the phase timer before a sync phase when instrumentation is attached.
+void OpenWeatherService::phaseBegin(HeapPhase phase) const {
+  if (heapMonitor_ != nullptr) {
+    heapMonitor_->begin(phase);
+  }
+  if (metrics_ != nullptr) {
+    metrics_->beginPhase(phase);
+  }
+}
+
+// Samples heap and records the phase duration after a sync phase when instrumentation is attached.
+void OpenWeatherService::phaseEnd(HeapPhase phase) const {
+  if (metrics_ != nullptr) {
+    metrics_->endPhase(phase);
+  }
+  if (heapMonitor_ != nullptr) {
+    heapMonitor_->end(phase);
+  }
+}
+
+// Feeds the shared backoff and counts the failure by status code.
+void OpenWeatherService::recordFailure(int code, uint32_t retryAfterMs) const {
+  retryPolicy_.recordFailure(millis(), retryAfterMs);
+  if (metrics_ != nullptr) {
+    metrics_->recordHttpFailure(code);
+  }
+}
+
 // Returns last successfully resolved location label.
 const char* OpenWeatherService::lastLocationName() const {
   return lastLocationName_;
@@ -854,3 +1283,18 @@ const char* OpenWeatherService::lastLocationName() const {
 int32_t OpenWeatherService::detectedUtcOffsetSeconds() const {
   return detectedUtcOffsetSeconds_;
 }
+
+// Returns remaining backoff before OpenWeather may be called again.
+uint32_t OpenWeatherService::msUntilRetry(unsigned long nowMs) const {
+  return retryPolicy_.msUntilNextAttempt(nowMs);
+}
+
+// Returns number of OpenWeather requests issued since boot.
+uint32_t OpenWeatherService::apiCallCount() const {
+  return apiCallCount_;
+}
+
+// Returns shared geocode/OneCall retry policy.
+const RetryPolicy& OpenWeatherService::retryPolicy() const {
+  return retryPolicy_;
+}
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <Arduino.h>
+#include <time.h>
+#include "HeapMonitor.h"
+#include "JsonStreamScanner.h"
+#include "Metrics.h"
 #include "Models.h"
 #include "OpenWeatherConfigService.h"
+#include "RetryPolicy.h"
 
 /**
  * @brief Fetches and parses OpenWeather geocode + OneCall payloads into WeatherData.
@@ -26,12 +31,43 @@ class OpenWeatherService {
 
   /**
    * @brief Refresh weather using configured ZIP + API key.
-   * @param weather Output model filled on success.
+   * @param weather Output model replaced only on success; left untouched on failure.
    * @param progress Optional callback for staged status updates.
    * @return True if weather was fetched and parsed successfully.
    */
   bool refreshWeather(WeatherData& weather, ProgressCallback progress = nullptr) const;
 
+  /**
+   * @brief Fetch only the OneCall alerts section for the last resolved location.
+   *
+   * The body is stream-parsed, so only event/start/end of up to
+   * kMaxWeatherAlerts unexpired alerts are kept.
+   * @param weather Model whose alert list and advisory summary are replaced on success.
+   * @return True if the alert list was refreshed.
+   */
+  bool refreshAlerts(WeatherData& weather) const;
+
+  /**
+   * @brief Fetch only the OneCall minutely section for the last resolved location.
+   *
+   * The body is stream-parsed straight into the 60-sample quantized array.
+   * @param nowcast Output replaced only on success.
+   * @return True if minutely data was fetched.
+   */
+  bool refreshNowcast(NowcastData& nowcast) const;
+
+  /**
+   * @brief Attach heap sampling around geocode, OneCall read and parse phases.
+   * @param monitor Caller-owned monitor, or nullptr to disable.
+   */
+  void setHeapMonitor(HeapMonitor* monitor);
+
+  /**
+   * @brief Attach phase timing, payload size and failure counters.
+   * @param metrics Caller-owned metrics, or nullptr to disable.
+   */
+  void setMetrics(Metrics* metrics);
+
   /**
    * @brief Return last successfully resolved location name.
    */
@@ -42,6 +78,22 @@ class OpenWeatherService {
    */
   int32_t detectedUtcOffsetSeconds() const;
 
+  /**
+   * @brief Milliseconds until backoff/circuit breaker allow the next OpenWeather request.
+   * @param nowMs Current millis().
+   */
+  uint32_t msUntilRetry(unsigned long nowMs) const;
+
+  /**
+   * @brief Total OpenWeather HTTP requests issued since boot (for quota planning).
+   */
+  uint32_t apiCallCount() const;
+
+  /**
+   * @brief Backoff/breaker state shared by geocode and OneCall requests.
+   */
+  const RetryPolicy& retryPolicy() const;
+
  private:
   /**
    * @brief Parse a string value by key starting at a given offset.
@@ -50,21 +102,81 @@ class OpenWeatherService {
       const String& json, const char* key, int start, char* outBuf, size_t outBufSize, int* valuePos = nullptr);
 
   /**
-   * @brief Resolve ZIP to latitude/longitude via geocoding endpoint.
+   * @brief Resolve ZIP to latitude/longitude (microdegrees) via geocoding endpoint.
+   */
+  bool fetchCoordinatesForZip(const char* zipInput, const char* apiKey, int32_t& latMicrodeg, int32_t& lonMicrodeg,
+                              ProgressCallback progress) const;
+
+  /**
+   * @brief Fetch and parse OneCall weather for given coordinates.
+   *
+   * Current + hourly are fetched every call; daily is fetched only when its
+   * tier is due, so most syncs skip the daily block entirely.
+   */
+  bool fetchWeatherByCoordinates(int32_t latMicrodeg, int32_t lonMicrodeg, const char* apiKey, WeatherData& weather,
+                                 ProgressCallback progress) const;
+
+  /**
+   * @brief Download one OneCall payload with the given exclude set, retrying per policy.
+   * @param exclude Comma-separated OneCall sections to omit.
+   * @param tag Log label for this request.
+   * @param outPayload Output response body.
    */
-  bool fetchCoordinatesForZip(
-      const char* zipInput, const char* apiKey, double& lat, double& lon, ProgressCallback progress) const;
+  bool fetchOneCallPayload(int32_t latMicrodeg, int32_t lonMicrodeg, const char* apiKey, const char* exclude,
+                           const char* tag, String& outPayload) const;
 
   /**
-   * @brief Fetch and parse OneCall weather payload for given coordinates.
+   * @brief GET a OneCall section set for the last location and feed the body to a scanner.
+   * @param exclude Sections to omit; callers keep the response small.
+   * @param tag Log label.
+   * @param scanner Receives the body as it arrives.
+   * @param bytes Output body size.
+   * @return True on HTTP 200 with a complete, well-formed document.
    */
-  bool fetchWeatherByCoordinates(
-      double lat, double lon, const char* apiKey, WeatherData& weather, ProgressCallback progress) const;
+  bool streamOneCallSection(const char* exclude, const char* tag, JsonStreamScanner& scanner, uint32_t& bytes) const;
 
   /**
-   * @brief Parse floating-point value by key starting at an offset.
+   * @brief Parse timezone, current, hourly and alert fallback into weather.
    */
-  static bool parseNumberFrom(const String& json, const char* key, int start, double& outValue, int* valuePos = nullptr);
+  bool parseCoreSections(const String& corePayload, WeatherData& weather) const;
+
+  /**
+   * @brief Parse the daily section into today high/low and the 4-day rows.
+   */
+  bool parseDailySection(const String& dailyPayload, WeatherData& weather) const;
+
+  /**
+   * @brief True when the daily section must be refetched.
+   */
+  bool dailyTierDue(const WeatherData& weather, time_t utcNow) const;
+
+  /**
+   * @brief Sample heap and start timing a phase if instrumentation is attached.
+   */
+  void phaseBegin(HeapPhase phase) const;
+
+  /**
+   * @brief Sample heap and record the phase duration if instrumentation is attached.
+   */
+  void phaseEnd(HeapPhase phase) const;
+
+  /**
+   * @brief Record a failed request with the retry policy and the failure counters.
+   * @param code HTTP status, transport error, or a Metrics::kCode* pseudo code.
+   * @param retryAfterMs Server-requested wait, or 0.
+   */
+  void recordFailure(int code, uint32_t retryAfterMs = 0) const;
+
+  /**
+   * @brief Log per-tier payload sizes and the average reduction versus untiered syncs.
+   */
+  void logTierBytes(uint32_t syncBytes) const;
+
+  /**
+   * @brief Parse a number by key starting at an offset into a scaled integer (value * 10^decimals).
+   */
+  static bool parseNumberFrom(
+      const String& json, const char* key, int start, uint8_t decimals, int32_t& outValue, int* valuePos = nullptr);
 
   /**
    * @brief Parse integer value by key starting at an offset.
@@ -76,27 +188,38 @@ class OpenWeatherService {
    */
   static int findSection(const String& json, const char* sectionKey);
 
-  /**
-   * @brief Round floating-point value to nearest integer.
-   */
-  static int roundToInt(double value);
-
   /**
    * @brief Map OpenWeather condition id to local WeatherType.
    */
   static WeatherType mapWeatherType(int weatherId);
 
   /**
-   * @brief Parse floating-point value by key from root.
+   * @brief Parse a scaled number by key from root.
    */
-  static bool parseNumber(const String& json, const char* key, double& outValue);
+  static bool parseNumber(const String& json, const char* key, uint8_t decimals, int32_t& outValue);
 
   /**
    * @brief Parse integer value by key from root.
    */
   static bool parseInt(const String& json, const char* key, int& outValue);
 
+  /**
+   * @brief True for failures worth retrying (transport errors, 429, 5xx).
+   */
+  static bool isRetryableHttpCode(int httpCode);
+
   const OpenWeatherConfigService& configService_;
+  mutable RetryPolicy retryPolicy_;
   mutable char lastLocationName_[40] = {0};
   mutable int32_t detectedUtcOffsetSeconds_ = 0;
+  mutable uint32_t apiCallCount_ = 0;
+  mutable int32_t lastLatMicrodeg_ = 0;
+  mutable int32_t lastLonMicrodeg_ = 0;
+  mutable bool hasCoordinates_ = false;
+  mutable uint32_t lastCoreBytes_ = 0;
+  mutable uint32_t lastDailyBytes_ = 0;
+  mutable uint32_t totalSyncBytes_ = 0;
+  mutable uint32_t tieredSyncs_ = 0;
+  HeapMonitor* heapMonitor_ = nullptr;
+  Metrics* metrics_ = nullptr;
 };
@@ -0,0 +1,152 @@
+#include "RetryPolicy.h"
+
+#include <Arduino.h>
+#if defined(ARDUINO_ARCH_ESP32)
+#include <esp_system.h>
+#endif
+#include "DeferredLog.h"
+
+namespace {
+// Hardware RNG on both targets; jitter only needs spread, not crypto strength.
+uint32_t hardwareRandom() {
+#if defined(ARDUINO_ARCH_ESP8266)
+  return RANDOM_REG32;
+#else
+  return esp_random();
+#endif
+}
+
+const char* stateLabel(RetryPolicy::State state) {
+  switch (state) {
+    case RetryPolicy::State::Closed:
+      return "closed";
+    case RetryPolicy::State::Open:
+      return "open";
+    case RetryPolicy::State::HalfOpen:
+      return "half-open";
+  }
+  return "?";
+}
+}  // namespace
+
+/**
+ * Start closed with no pending backoff.
+ */
+RetryPolicy::RetryPolicy(const char* name, const Config& config) : name_(name), config_(config) {}
+
+/**
+ * Gate an attempt on the backoff deadline; an elapsed open breaker admits one probe.
+ */
+bool RetryPolicy::allowAttempt(unsigned long nowMs) {
+  if (hasDeadline_ && static_cast<long>(nowMs - nextAttemptAtMs_) < 0) {
+    return false;
+  }
+  if (state_ == State::Open) {
+    state_ = State::HalfOpen;
+    LOG_INFO(RetryHalfOpen, name_);
+  }
+  return true;
+}
+
+/**
+ * Return remaining wait before the next attempt is allowed.
+ */
+uint32_t RetryPolicy::msUntilNextAttempt(unsigned long nowMs) const {
+  if (!hasDeadline_) {
+    return 0;
+  }
+  const long remaining = static_cast<long>(nextAttemptAtMs_ - nowMs);
+  return remaining > 0 ? static_cast<uint32_t>(remaining) : 0;
+}
+
+/**
+ * Clear failure streak and close the breaker.
+ */
+void RetryPolicy::recordSuccess() {
+  if (state_ != State::Closed) {
+    LOG_INFO(RetryClosed, name_);
+  }
+  state_ = State::Closed;
+  consecutiveFailures_ = 0;
+  hasDeadline_ = false;
+}
+
+/**
+ * Extend the failure streak and schedule the next allowed attempt.
+ */
+void RetryPolicy::recordFailure(unsigned long nowMs, uint32_t retryAfterMs) {
+  if (consecutiveFailures_ < 0xFFFF) {
+    ++consecutiveFailures_;
+  }
+
+  uint32_t delayMs = fullJitterDelayMs();
+  // A failed half-open probe, or too many failures in a row, (re)opens the breaker.
+  if (state_ == State::HalfOpen || consecutiveFailures_ >= config_.failureThreshold) {
+    state_ = State::Open;
+    if (delayMs < config_.openCooldownMs) {
+      delayMs = config_.openCooldownMs;
+    }
+  }
+  if (delayMs < retryAfterMs) {
+    delayMs = retryAfterMs;
+  }
+  nextAttemptAtMs_ = nowMs + delayMs;
+  hasDeadline_ = true;
+
+  LOG_WARN(RetryFailure, name_, consecutiveFailures_, delayMs, retryAfterMs, stateLabel(state_));
+}
+
+/**
+ * Return breaker state.
+ */
+RetryPolicy::State RetryPolicy::state() const {
+  return state_;
+}
+
+/**
+ * Return current failure streak length.
+ */
+uint16_t RetryPolicy::consecutiveFailures() const {
+  return consecutiveFailures_;
+}
+
+/**
+ * Full jitter: uniform over [0, capped exponential ceiling].
+ */
+uint32_t RetryPolicy::fullJitterDelayMs() const {
+  uint32_t ceiling = config_.baseDelayMs;
+  for (uint16_t i = 1; i < consecutiveFailures_ && ceiling < config_.maxDelayMs; ++i) {
+    ceiling = ceiling > config_.maxDelayMs / 2 ? config_.maxDelayMs : ceiling * 2;
+  }
+  if (ceiling > config_.maxDelayMs) {
+    ceiling = config_.maxDelayMs;
+  }
+  return ceiling == 0 ? 0 : hardwareRandom() % (ceiling + 1);
+}
+
+/**
+ * Accept "Retry-After: <seconds>"; reject dates and garbage.
+ */
+uint32_t RetryPolicy::parseRetryAfterMs(const char* value) {
+  if (value == nullptr) {
+    return 0;
+  }
+  while (*value == ' ') {
+    ++value;
+  }
+  uint32_t seconds = 0;
+  bool sawDigit = false;
+  for (; *value >= '0' && *value <= '9'; ++value) {
+    sawDigit = true;
+    if (seconds < 86400) {
+      seconds = seconds * 10 + static_cast<uint32_t>(*value - '0');
+    }
+  }
+  if (!sawDigit || (*value != '\0' && *value != ' ')) {
+    return 0;
+  }
+  if (seconds > 86400) {
+    seconds = 86400;
+  }
+  return seconds * 1000UL;
+}
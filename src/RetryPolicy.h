@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Backoff + circuit-breaker state for one remote dependency (NTP, OpenWeather).
+ *
+ * Failures schedule the next attempt with exponential backoff and full jitter,
+ * stretched to any server-provided Retry-After. After repeated failures the
+ * breaker opens and blocks attempts for a cooldown, then lets one probe through.
+ */
+class RetryPolicy {
+ public:
+  /**
+   * @brief Breaker state.
+   */
+  enum class State : uint8_t {
+    Closed,
+    Open,
+    HalfOpen
+  };
+
+  /**
+   * @brief Tuning for one dependency.
+   */
+  struct Config {
+    /** @brief Backoff ceiling for the first failure, doubled per consecutive failure. */
+    uint32_t baseDelayMs;
+    /** @brief Upper bound for any backoff delay. */
+    uint32_t maxDelayMs;
+    /** @brief Consecutive failures that open the breaker. */
+    uint8_t failureThreshold;
+    /** @brief How long the breaker stays open before a half-open probe. */
+    uint32_t openCooldownMs;
+  };
+
+  /**
+   * @brief Construct a policy in the closed state.
+   * @param name Short tag for serial logs (pointer is stored).
+   * @param config Backoff/breaker tuning.
+   */
+  RetryPolicy(const char* name, const Config& config);
+
+  /**
+   * @brief Whether an attempt may start now; moves an expired open breaker to half-open.
+   * @param nowMs Current millis().
+   */
+  bool allowAttempt(unsigned long nowMs);
+
+  /**
+   * @brief Milliseconds until allowAttempt() can succeed (0 if it already can).
+   * @param nowMs Current millis().
+   */
+  uint32_t msUntilNextAttempt(unsigned long nowMs) const;
+
+  /**
+   * @brief Reset backoff and close the breaker after a successful call.
+   */
+  void recordSuccess();
+
+  /**
+   * @brief Schedule the next attempt after a failed call.
+   * @param nowMs Current millis().
+   * @param retryAfterMs Server-requested minimum wait (0 if none).
+   */
+  void recordFailure(unsigned long nowMs, uint32_t retryAfterMs = 0);
+
+  /**
+   * @brief Current breaker state.
+   */
+  State state() const;
+
+  /**
+   * @brief Failures since the last success.
+   */
+  uint16_t consecutiveFailures() const;
+
+  /**
+   * @brief Parse an HTTP Retry-After header in delta-seconds form.
+   * @param value Header value; HTTP-date values are ignored.
+   * @return Delay in milliseconds, or 0 if absent/unsupported.
+   */
+  static uint32_t parseRetryAfterMs(const char* value);
+
+ private:
+  /**
+   * @brief Uniform random delay in [0, min(maxDelay, base * 2^(failures-1))].
+   */
+  uint32_t fullJitterDelayMs() const;
+
+  const char* name_;
+  Config config_;
+  State state_ = State::Closed;
+  uint16_t consecutiveFailures_ = 0;
+  unsigned long nextAttemptAtMs_ = 0;
+  bool hasDeadline_ = false;
+};
@@ -0,0 +1,237 @@
+#include "ScreenMirror.h"
+
+#include <Arduino.h>
+#include <string.h>
+#if !defined(ARDUINO_ARCH_ESP8266)
+#include <lwip/sockets.h>
+#endif
+
+namespace {
+const char kEventHeaders[] =
+    "HTTP/1.1 200 OK\r\n"
+    "Content-Type: text/event-stream\r\n"
+    "Cache-Control: no-cache\r\n"
+    "Connection: close\r\n"
+    "\r\n"
+    "retry: 2000\n"
+    "event: key\n"
+    "data: 128 64\n\n";
+
+const char kKeepAlive[] = ":\n\n";
+
+const char kHexDigits[] = "0123456789abcdef";
+
+// Pixels are drawn column-byte by column-byte exactly as the SSD1306 stores them: bit r of
+// byte x in page p is pixel (x, p * 8 + r).
+const char kScreenPage[] PROGMEM = R"HTML(<!DOCTYPE html>
+<html><head><meta name="viewport" content="width=device-width"><title>WeatherClock screen</title>
+<style>body{background:#111;color:#999;font:13px monospace;margin:16px}
+canvas{width:512px;height:256px;image-rendering:pixelated;background:#000;border:1px solid #333}</style>
+</head><body><canvas id="c" width="128" height="64"></canvas><p id="s">connecting</p>
+<script>
+var ctx=document.getElementById('c').getContext('2d'),img=ctx.createImageData(128,64),st=document.getElementById('s'),n=0;
+for(var i=3;i<img.data.length;i+=4)img.data[i]=255;
+function drawPage(d){var sp=d.indexOf(' '),p=parseInt(d.slice(0,sp),10),h=d.slice(sp+1);
+for(var x=0;x<128;x++){var b=parseInt(h.substr(x*2,2),16);
+for(var r=0;r<8;r++){var o=((p*8+r)*128+x)*4,v=(b>>r)&1?230:0;img.data[o]=img.data[o+1]=img.data[o+2]=v;}}}
+var es=new EventSource('/screen/events');
+es.addEventListener('key',function(){n=0;st.textContent='live';});
+es.addEventListener('page',function(e){drawPage(e.data);ctx.putImageData(img,0,0);st.textContent='live, '+(++n)+' page updates';});
+es.onerror=function(){st.textContent='reconnecting';};
+</script></body></html>
+)HTML";
+}  // namespace
+
+/**
+ * Claim a free slot, answer the request ourselves, and keep the connection for later writes.
+ */
+bool ScreenMirror::addViewer(WiFiClient& client) {
+  for (uint8_t i = 0; i < kMaxViewers; ++i) {
+    Viewer& viewer = viewers_[i];
+    if (viewer.active) {
+      continue;
+    }
+    // The web server drops its own reference once the handler returns; this copy keeps the socket.
+    viewer.client = client;
+    viewer.client.setNoDelay(true);
+    viewer.active = true;
+    viewer.validPages = 0;
+    viewer.lastWriteMs = millis();
+    if (viewer.client.write(reinterpret_cast<const uint8_t*>(kEventHeaders), sizeof(kEventHeaders) - 1) !=
+        sizeof(kEventHeaders) - 1) {
+      drop(viewer, "header write failed");
+      return true;
+    }
+    Serial.print("[SCREEN] Viewer connected slot=");
+    Serial.println(i);
+    return true;
+  }
+  return false;
+}
+
+/**
+ * Adopt the new frame's page CRCs and push the pages that changed.
+ */
+void ScreenMirror::onFrame(const uint8_t* buffer, const uint32_t* pageCrcs) {
+  buffer_ = buffer;
+  memcpy(frameCrc_, pageCrcs, sizeof(frameCrc_));
+  sendPending(millis());
+}
+
+/**
+ * Catch up viewers that ran out of send space, then keep quiet streams alive.
+ */
+void ScreenMirror::poll(unsigned long nowMs) {
+  sendPending(nowMs);
+  for (uint8_t i = 0; i < kMaxViewers; ++i) {
+    Viewer& viewer = viewers_[i];
+    if (!viewer.active) {
+      continue;
+    }
+    if (!viewer.client.connected()) {
+      drop(viewer, "closed");
+    } else if (nowMs - viewer.lastWriteMs >= kKeepAliveMs && writeRoom(viewer.client) >= sizeof(kKeepAlive) - 1) {
+      // An SSE comment; a dead peer shows up as a failed write here.
+      write(viewer, kKeepAlive, sizeof(kKeepAlive) - 1, nowMs);
+    }
+  }
+}
+
+/**
+ * One bounded pass over every viewer's stale pages, timed for /metrics.
+ */
+void ScreenMirror::sendPending(unsigned long nowMs) {
+  if (buffer_ == nullptr || viewerCount() == 0) {
+    return;
+  }
+  const uint32_t startUs = micros();
+  bool outOfTime = false;
+  for (uint8_t i = 0; i < kMaxViewers && !outOfTime; ++i) {
+    Viewer& viewer = viewers_[i];
+    for (uint8_t page = 0; page < kPageCount && viewer.active; ++page) {
+      if ((viewer.validPages & (1U << page)) != 0 && viewer.sentCrc[page] == frameCrc_[page]) {
+        continue;
+      }
+      if (micros() - startUs >= kPassBudgetUs) {
+        outOfTime = true;
+        break;
+      }
+      // No room means the browser is behind; leave the page stale and try on a later pass.
+      if (writeRoom(viewer.client) < kPageEventBytes || !sendPage(viewer, page, nowMs)) {
+        break;
+      }
+    }
+  }
+  lastPassUs_ = micros() - startUs;
+  if (lastPassUs_ > maxPassUs_) {
+    maxPassUs_ = lastPassUs_;
+  }
+}
+
+/**
+ * Format one page as "event: page / data: <index> <hex>" and mark it current for this viewer.
+ */
+bool ScreenMirror::sendPage(Viewer& viewer, uint8_t page, unsigned long nowMs) {
+  char event[kPageEventBytes];
+  size_t length = static_cast<size_t>(snprintf(event, sizeof(event), "event: page\ndata: %u ", page));
+  const uint8_t* bytes = buffer_ + page * kPageBytes;
+  for (uint8_t x = 0; x < kPageBytes; ++x) {
+    event[length++] = kHexDigits[bytes[x] >> 4];
+    event[length++] = kHexDigits[bytes[x] & 0x0F];
+  }
+  event[length++] = '\n';
+  event[length++] = '\n';
+  if (!write(viewer, event, length, nowMs)) {
+    return false;
+  }
+  viewer.sentCrc[page] = frameCrc_[page];
+  viewer.validPages |= static_cast<uint8_t>(1U << page);
+  ++pagesSent_;
+  return true;
+}
+
+/**
+ * Write a whole event or drop the viewer; a partial event would corrupt the stream.
+ */
+bool ScreenMirror::write(Viewer& viewer, const char* data, size_t length, unsigned long nowMs) {
+  if (viewer.client.write(reinterpret_cast<const uint8_t*>(data), length) != length) {
+    drop(viewer, "write failed");
+    return false;
+  }
+  viewer.lastWriteMs = nowMs;
+  return true;
+}
+
+/**
+ * Close a viewer's connection and free its slot.
+ */
+void ScreenMirror::drop(Viewer& viewer, const char* reason) {
+  viewer.client.stop();
+  viewer.client = WiFiClient();
+  viewer.active = false;
+  Serial.print("[SCREEN] Viewer dropped: ");
+  Serial.println(reason);
+}
+
+/**
+ * Bytes the socket accepts without blocking.
+ */
+size_t ScreenMirror::writeRoom(WiFiClient& client) {
+#if defined(ARDUINO_ARCH_ESP8266)
+  const int room = client.availableForWrite();
+  return room > 0 ? static_cast<size_t>(room) : 0;
+#else
+  // ESP32's WiFiClient has no availableForWrite() and its write() waits on a full socket;
+  // a zero-timeout select tells whether lwIP can take an event right now.
+  const int fd = client.fd();
+  if (fd < 0) {
+    return 0;
+  }
+  fd_set writable;
+  FD_ZERO(&writable);
+  FD_SET(fd, &writable);
+  timeval timeout = {0, 0};
+  return select(fd + 1, nullptr, &writable, nullptr, &timeout) > 0 ? kPageEventBytes : 0;
+#endif
+}
+
+/**
+ * Return connected viewers.
+ */
+uint8_t ScreenMirror::viewerCount() const {
+  uint8_t count = 0;
+  for (uint8_t i = 0; i < kMaxViewers; ++i) {
+    if (viewers_[i].active) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+/**
+ * Return page events sent since boot.
+ */
+uint32_t ScreenMirror::pagesSent() const {
+  return pagesSent_;
+}
+
+/**
+ * Return the last send pass duration.
+ */
+uint32_t ScreenMirror::lastPassMicros() const {
+  return lastPassUs_;
+}
+
+/**
+ * Return the longest send pass duration.
+ */
+uint32_t ScreenMirror::maxPassMicros() const {
+  return maxPassUs_;
+}
+
+/**
+ * Return the flash-resident viewer page.
+ */
+const char* ScreenMirror::pageHtml() {
+  return kScreenPage;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <WiFiClient.h>
+
+/**
+ * @brief Streams the OLED framebuffer to browsers as Server-Sent Events.
+ *
+ * DisplayService reports each frame it pushes to the panel together with the
+ * per-page CRCs it already computed to skip unchanged frames. A new viewer
+ * gets a keyframe (all eight 128-byte SSD1306 pages); after that only pages
+ * whose CRC differs from what that viewer last received are sent. Writes are
+ * limited to the socket's free send space and to a per-pass time budget, so a
+ * slow viewer falls behind instead of stalling the loop; poll() catches it
+ * up from the latest frame.
+ */
+class ScreenMirror {
+ public:
+  /** @brief SSD1306 pages (8-row bands) in a 128x64 frame. */
+  static constexpr uint8_t kPageCount = 8;
+  /** @brief Bytes per page: one column byte per pixel column. */
+  static constexpr uint8_t kPageBytes = 128;
+  /** @brief Concurrent /screen viewers; more get a 503. */
+  static constexpr uint8_t kMaxViewers = 2;
+
+  /**
+   * @brief Take over a request's connection as an event stream.
+   * @param client Connection of the current /screen/events request; a copy is kept open.
+   * @return False if all viewer slots are taken (nothing was written).
+   */
+  bool addViewer(WiFiClient& client);
+
+  /**
+   * @brief Called by DisplayService after a frame reached the panel.
+   * @param buffer Live framebuffer; must stay valid for the mirror's lifetime.
+   * @param pageCrcs CRC-32 of each page of buffer.
+   */
+  void onFrame(const uint8_t* buffer, const uint32_t* pageCrcs);
+
+  /**
+   * @brief Send pages a viewer is still missing, keep idle streams alive, and drop closed ones.
+   * @param nowMs Current millis().
+   */
+  void poll(unsigned long nowMs);
+
+  /** @brief Connected viewers. */
+  uint8_t viewerCount() const;
+  /** @brief Page events sent to all viewers since boot. */
+  uint32_t pagesSent() const;
+  /** @brief Microseconds the most recent send pass took (0 until a viewer connects). */
+  uint32_t lastPassMicros() const;
+  /** @brief Longest send pass since boot. */
+  uint32_t maxPassMicros() const;
+
+  /**
+   * @brief HTML page with the canvas that renders the stream; stored in flash.
+   */
+  static const char* pageHtml();
+
+ private:
+  // "event: page\ndata: N " + 256 hex digits + "\n\n".
+  static constexpr size_t kPageEventBytes = 20 + 2 * kPageBytes + 2;
+  static constexpr uint32_t kPassBudgetUs = 2000;
+  static constexpr unsigned long kKeepAliveMs = 15000;
+
+  struct Viewer {
+    WiFiClient client;
+    bool active = false;
+    uint8_t validPages = 0;  // Bit per page whose sentCrc matches what the browser shows.
+    uint32_t sentCrc[kPageCount] = {};
+    unsigned long lastWriteMs = 0;
+  };
+
+  void sendPending(unsigned long nowMs);
+  bool sendPage(Viewer& viewer, uint8_t page, unsigned long nowMs);
+  bool write(Viewer& viewer, const char* data, size_t length, unsigned long nowMs);
+  void drop(Viewer& viewer, const char* reason);
+  static size_t writeRoom(WiFiClient& client);
+
+  Viewer viewers_[kMaxViewers];
+  const uint8_t* buffer_ = nullptr;
+  uint32_t frameCrc_[kPageCount] = {};
+  uint32_t pagesSent_ = 0;
+  uint32_t lastPassUs_ = 0;
+  uint32_t maxPassUs_ = 0;
+};
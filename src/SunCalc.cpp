@@ -0,0 +1,150 @@
+#include "SunCalc.h"
+
+#include "CivilCalendar.h"
+
+namespace {
+// sin(0..90 deg) in Q15, one entry per degree; linear interpolation keeps error under 4e-5.
+const int16_t kSinQuarterQ15[91] = {
+    0, 572, 1144, 1715, 2286, 2856, 3425, 3993, 4560, 5126,
+    5690, 6252, 6813, 7371, 7927, 8481, 9032, 9580, 10126, 10668,
+    11207, 11743, 12275, 12803, 13328, 13848, 14364, 14876, 15383, 15886,
+    16383, 16876, 17364, 17846, 18323, 18794, 19260, 19720, 20173, 20621,
+    21062, 21497, 21925, 22347, 22762, 23170, 23571, 23964, 24351, 24730,
+    25101, 25465, 25821, 26169, 26509, 26841, 27165, 27481, 27788, 28087,
+    28377, 28659, 28932, 29196, 29451, 29697, 29934, 30162, 30381, 30591,
+    30791, 30982, 31163, 31335, 31498, 31650, 31794, 31927, 32051, 32165,
+    32269, 32364, 32448, 32523, 32587, 32642, 32687, 32722, 32747, 32762,
+    32767};
+
+// Sine of an angle in centidegrees, Q15.
+int32_t sinQ15(int32_t centideg) {
+  centideg %= 36000;
+  if (centideg < 0) {
+    centideg += 36000;
+  }
+  int32_t sign = 1;
+  if (centideg >= 18000) {
+    centideg -= 18000;
+    sign = -1;
+  }
+  if (centideg > 9000) {
+    centideg = 18000 - centideg;
+  }
+  const int32_t idx = centideg / 100;
+  const int32_t frac = centideg % 100;
+  const int32_t a = kSinQuarterQ15[idx];
+  const int32_t b = kSinQuarterQ15[idx < 90 ? idx + 1 : 90];
+  return sign * (a + ((b - a) * frac) / 100);
+}
+
+int32_t cosQ15(int32_t centideg) {
+  return sinQ15(centideg + 9000);
+}
+
+// Inverse cosine (Q15 in, centidegrees 0..18000 out) by bisection on the monotonic cosine.
+int32_t acosCentideg(int32_t valueQ15) {
+  int32_t lo = 0;
+  int32_t hi = 18000;
+  while (lo < hi) {
+    const int32_t mid = (lo + hi) / 2;
+    if (cosQ15(mid) > valueQ15) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+// Equation of time (milliminutes) and declination (centidegrees) at a fractional-year angle.
+struct SolarPosition {
+  int64_t eqMilliMin;
+  int32_t declCentideg;
+};
+
+SolarPosition solarPosition(int32_t gamma) {
+  const int64_t c1 = cosQ15(gamma);
+  const int64_t s1 = sinQ15(gamma);
+  const int64_t c2 = cosQ15(2 * gamma);
+  const int64_t s2 = sinQ15(2 * gamma);
+  const int64_t c3 = cosQ15(3 * gamma);
+  const int64_t s3 = sinQ15(3 * gamma);
+
+  // NOAA coefficients scaled by 1e6.
+  const int64_t eqMicro = 75 + (1868 * c1 - 32077 * s1 - 14615 * c2 - 40849 * s2) / 32768;
+  const int64_t declMicroRad =
+      6918 + (-399912 * c1 + 70257 * s1 - 6758 * c2 + 907 * s2 - 2697 * c3 + 1480 * s3) / 32768;
+  SolarPosition pos;
+  pos.eqMilliMin = (eqMicro * 229180) / 1000000;
+  pos.declCentideg = static_cast<int32_t>((declMicroRad * 18000) / 3141593);
+  return pos;
+}
+
+// Sunrise (rising) or sunset in UTC milliminutes from 00:00 of the day; false if the sun does not cross.
+bool eventUtcMilliMin(
+    int32_t latCentideg, int32_t lonCentideg, int32_t dayOfYear, int32_t daysInYear, bool rising, int64_t& out) {
+  // Start from solar noon, then re-evaluate the sun's position at the estimated event time. The
+  // declination moves up to 0.4 deg a day, which is minutes of sunrise error at mid-latitudes.
+  out = 720000 - 40LL * lonCentideg;
+  for (int pass = 0; pass < 2; ++pass) {
+    // The series phased from Jan 1 12:00 UTC, as NOAA publishes it, lags the sun by about a day
+    // (the 2026 equinoxes come out 0.4 deg of declination late), so phase it from Dec 31 12:00 UTC.
+    const int64_t dayMilliMin = static_cast<int64_t>(dayOfYear) * 1440000 + out + 720000;
+    const SolarPosition pos = solarPosition(static_cast<int32_t>((36000LL * dayMilliMin) / (daysInYear * 1440000LL)));
+
+    // Hour angle for the standard 90.833 deg zenith (refraction + solar disc).
+    const int64_t numQ30 = static_cast<int64_t>(cosQ15(9083)) * 32768 -
+                           static_cast<int64_t>(sinQ15(latCentideg)) * sinQ15(pos.declCentideg);
+    const int64_t denQ30 = static_cast<int64_t>(cosQ15(latCentideg)) * cosQ15(pos.declCentideg);
+    if (denQ30 <= 0) {
+      return false;
+    }
+    const int64_t cosHaQ15 = (numQ30 * 32768) / denQ30;
+    if (cosHaQ15 > 32767 || cosHaQ15 < -32767) {
+      // Polar night or midnight sun: no sunrise/sunset this day.
+      return false;
+    }
+    const int32_t haCentideg = acosCentideg(static_cast<int32_t>(cosHaQ15));
+
+    // 4 minutes of time per degree of longitude/hour angle.
+    out = 720000 - 40LL * (lonCentideg + (rising ? haCentideg : -haCentideg)) - pos.eqMilliMin;
+  }
+  return true;
+}
+}  // namespace
+
+/**
+ * NOAA general solar position equations in fixed point, evaluated at each event's own time.
+ */
+bool computeSunTimes(
+    int32_t latMicrodeg, int32_t lonMicrodeg, int32_t localDayNumber, int32_t utcOffsetSeconds, SunTimes& out) {
+  out.valid = false;
+  out.sunriseMinute = 0;
+  out.sunsetMinute = 0;
+
+  // Day of year (0-based) and year length for the fractional-year angle.
+  const int32_t daysInYear = isLeapYear(civilFromDays(localDayNumber).year) ? 366 : 365;
+  const int32_t dayOfYear = dayOfYearFromDays(localDayNumber);
+  const int32_t latCentideg = latMicrodeg / 10000;
+  const int32_t lonCentideg = lonMicrodeg / 10000;
+
+  int64_t sunriseUtcMilliMin = 0;
+  int64_t sunsetUtcMilliMin = 0;
+  if (!eventUtcMilliMin(latCentideg, lonCentideg, dayOfYear, daysInYear, true, sunriseUtcMilliMin) ||
+      !eventUtcMilliMin(latCentideg, lonCentideg, dayOfYear, daysInYear, false, sunsetUtcMilliMin)) {
+    return false;
+  }
+  const int64_t offsetMilliMin = static_cast<int64_t>(utcOffsetSeconds) * 1000 / 60;
+
+  auto toLocalMinute = [offsetMilliMin](int64_t utcMilliMin) -> uint16_t {
+    int64_t local = (utcMilliMin + offsetMilliMin + 500) / 1000;
+    local %= 1440;
+    if (local < 0) {
+      local += 1440;
+    }
+    return static_cast<uint16_t>(local);
+  };
+  out.sunriseMinute = toLocalMinute(sunriseUtcMilliMin);
+  out.sunsetMinute = toLocalMinute(sunsetUtcMilliMin);
+  out.valid = true;
+  return true;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Locally computed sunrise/sunset for one day.
+ */
+struct SunTimes {
+  /** @brief Sunrise as local minutes after midnight (0-1439). */
+  uint16_t sunriseMinute;
+  /** @brief Sunset as local minutes after midnight (0-1439). */
+  uint16_t sunsetMinute;
+  /** @brief False during polar day/night or before a location is known. */
+  bool valid;
+};
+
+/**
+ * @brief Fixed-point NOAA sunrise/sunset for one local day.
+ *
+ * Integer-only and free of Arduino dependencies so tools/sun_check.cpp can
+ * compare it against a float reference on the host.
+ * @param latMicrodeg Latitude in microdegrees.
+ * @param lonMicrodeg Longitude in microdegrees.
+ * @param localDayNumber Local days since 1970-01-01.
+ * @param utcOffsetSeconds Offset used to express the result in local minutes.
+ * @param out Output times; valid=false during polar day/night.
+ * @return True if the sun rises and sets that day.
+ */
+bool computeSunTimes(
+    int32_t latMicrodeg, int32_t lonMicrodeg, int32_t localDayNumber, int32_t utcOffsetSeconds, SunTimes& out);
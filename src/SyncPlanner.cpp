@@ -0,0 +1,149 @@
+#include "SyncPlanner.h"
+
+#include <string.h>
+#include "DeferredLog.h"
+
+namespace {
+constexpr uint32_t kSecondsPerDay = 86400UL;
+
+bool isPrecipitation(WeatherType type) {
+  return type == WeatherType::Rain || type == WeatherType::Thunderstorm || type == WeatherType::Snow;
+}
+}  // namespace
+
+/**
+ * Start with no plan; the first recordSync() schedules the next sync.
+ */
+SyncPlanner::SyncPlanner(const Config& config) : config_(config), currentIntervalSec_(config.baseIntervalSec) {}
+
+/**
+ * Store MAC-derived seed; the offset is taken modulo the active interval.
+ */
+void SyncPlanner::setDeviceSeed(uint16_t macSuffix) {
+  // Spread adjacent suffixes across the hour instead of clustering them.
+  deviceSeed_ = static_cast<uint32_t>(macSuffix) * 2654435761UL;
+}
+
+/**
+ * Due once the planned epoch has passed.
+ */
+bool SyncPlanner::isDue(uint32_t utcNow) const {
+  return nextSyncEpoch_ != 0 && utcNow >= nextSyncEpoch_;
+}
+
+/**
+ * Volatile when precipitation or an advisory shows up in the next hours; stable when all clear.
+ */
+uint32_t SyncPlanner::intervalForWeather(const WeatherData& weather) const {
+  if (!weather.valid) {
+    return config_.baseIntervalSec;
+  }
+
+  bool precipitationAhead = isPrecipitation(weather.type) || weather.rainChancePct >= 40;
+  bool allSameType = true;
+  for (int i = 0; i < 4; ++i) {
+    precipitationAhead = precipitationAhead || isPrecipitation(weather.hourlyType[i]);
+    allSameType = allSameType && weather.hourlyType[i] == weather.type;
+  }
+  const bool advisoryActive = strcmp(weather.advisory, "NO ADVISORIES") != 0;
+  if (precipitationAhead || advisoryActive) {
+    return config_.volatileIntervalSec;
+  }
+  if (allSameType && weather.rainChancePct < 10) {
+    return config_.stableIntervalSec;
+  }
+  return config_.baseIntervalSec;
+}
+
+/**
+ * Count calls against today's quota, then plan the next slot on this device's offset grid.
+ */
+void SyncPlanner::recordSync(uint32_t utcNow, uint16_t apiCalls, const WeatherData& weather) {
+  const uint32_t day = utcNow / kSecondsPerDay;
+  if (day != quotaDay_) {
+    quotaDay_ = day;
+    callsToday_ = 0;
+  }
+  callsToday_ += apiCalls;
+  if (apiCalls > 0) {
+    lastCallsPerSync_ = apiCalls;
+  }
+
+  uint32_t interval = intervalForWeather(weather);
+
+  // Stretch the interval so the remaining budget lasts until the quota resets.
+  const uint32_t secondsLeftToday = kSecondsPerDay - (utcNow % kSecondsPerDay);
+  const uint32_t callsLeft = callsToday_ < config_.dailyCallQuota ? config_.dailyCallQuota - callsToday_ : 0;
+  const uint32_t syncsLeft = callsLeft / lastCallsPerSync_;
+  uint32_t offset = 0;
+  if (syncsLeft == 0) {
+    // Budget spent: wait for the quota reset, still staggered per device.
+    offset = deviceSeed_ % config_.baseIntervalSec;
+    nextSyncEpoch_ = (day + 1) * kSecondsPerDay + offset;
+    interval = nextSyncEpoch_ - utcNow;
+  } else {
+    if (secondsLeftToday / syncsLeft > interval) {
+      interval = secondsLeftToday / syncsLeft;
+    }
+    // Next slot on the grid {k * interval + offset} strictly after now.
+    offset = deviceSeed_ % interval;
+    const uint32_t shifted = utcNow >= offset ? utcNow - offset : 0;
+    nextSyncEpoch_ = (shifted / interval + 1) * interval + offset;
+  }
+  currentIntervalSec_ = interval;
+
+  LOG_INFO(PlanNext, callsToday_, config_.dailyCallQuota, interval, offset, nextSyncEpoch_ - utcNow);
+}
+
+/**
+ * Spare budget is what is left today after one sync per remaining interval.
+ */
+bool SyncPlanner::allowExtraCall(uint32_t utcNow, uint16_t apiCalls) const {
+  const uint32_t day = utcNow / kSecondsPerDay;
+  const uint32_t spent = day == quotaDay_ ? callsToday_ : 0;
+  const uint32_t callsLeft = spent < config_.dailyCallQuota ? config_.dailyCallQuota - spent : 0;
+  const uint32_t secondsLeftToday = kSecondsPerDay - (utcNow % kSecondsPerDay);
+  const uint32_t syncsLeft = (secondsLeftToday + currentIntervalSec_ - 1) / currentIntervalSec_;
+  const uint32_t reserved = syncsLeft * lastCallsPerSync_;
+  return callsLeft >= reserved + apiCalls;
+}
+
+/**
+ * Count calls against today's quota without replanning.
+ */
+void SyncPlanner::recordExtraCalls(uint32_t utcNow, uint16_t apiCalls) {
+  const uint32_t day = utcNow / kSecondsPerDay;
+  if (day != quotaDay_) {
+    quotaDay_ = day;
+    callsToday_ = 0;
+  }
+  callsToday_ += apiCalls;
+}
+
+/**
+ * Return the last sync's call count.
+ */
+uint32_t SyncPlanner::callsPerSync() const {
+  return lastCallsPerSync_;
+}
+
+/**
+ * Return planned epoch.
+ */
+uint32_t SyncPlanner::nextSyncEpoch() const {
+  return nextSyncEpoch_;
+}
+
+/**
+ * Return calls spent today.
+ */
+uint32_t SyncPlanner::callsToday() const {
+  return callsToday_;
+}
+
+/**
+ * Return active interval.
+ */
+uint32_t SyncPlanner::currentIntervalSec() const {
+  return currentIntervalSec_;
+}
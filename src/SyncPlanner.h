@@ -0,0 +1,109 @@
+#pragma once
+
+#include <stdint.h>
+#include "Models.h"
+
+/**
+ * @brief Plans weather sync times against a daily API call budget.
+ *
+ * Each device is shifted by a MAC-derived offset so a fleet does not hit the
+ * API in one burst, and the interval shrinks when the forecast is volatile
+ * (precipitation, advisories) and grows when it is stable. All inputs are
+ * explicit UTC epochs, so the planner can be driven in simulated time.
+ */
+class SyncPlanner {
+ public:
+  /**
+   * @brief Planner tuning.
+   */
+  struct Config {
+    /** @brief API calls this device may spend per UTC day. */
+    uint32_t dailyCallQuota;
+    /** @brief Interval when conditions are neither volatile nor stable. */
+    uint32_t baseIntervalSec;
+    /** @brief Interval while precipitation or an advisory is expected. */
+    uint32_t volatileIntervalSec;
+    /** @brief Interval while conditions are stable. */
+    uint32_t stableIntervalSec;
+  };
+
+  /**
+   * @brief Construct planner with no sync history.
+   * @param config Budget and cadence tuning.
+   */
+  explicit SyncPlanner(const Config& config);
+
+  /**
+   * @brief Derive this device's schedule offset from its MAC suffix.
+   * @param macSuffix Last two MAC bytes (same bytes as the device name suffix).
+   */
+  void setDeviceSeed(uint16_t macSuffix);
+
+  /**
+   * @brief Whether a planned sync is due.
+   * @param utcNow Current UTC epoch.
+   */
+  bool isDue(uint32_t utcNow) const;
+
+  /**
+   * @brief Record a completed sync and plan the next one.
+   * @param utcNow UTC epoch when the sync finished.
+   * @param apiCalls API requests spent by this sync.
+   * @param weather Latest weather, used to pick the cadence.
+   */
+  void recordSync(uint32_t utcNow, uint16_t apiCalls, const WeatherData& weather);
+
+  /**
+   * @brief Whether requests outside the planned syncs fit in today's budget.
+   *
+   * Leaves room for the planned syncs still due before the quota resets, so
+   * extra requests only spend calls the schedule would not use.
+   * @param utcNow Current UTC epoch.
+   * @param apiCalls Calls the extra request would spend.
+   */
+  bool allowExtraCall(uint32_t utcNow, uint16_t apiCalls) const;
+
+  /**
+   * @brief Charge requests made outside a planned sync against today's quota.
+   *
+   * Unlike recordSync() this keeps the per-sync call estimate and the plan, so
+   * extra requests do not stretch the core sync interval.
+   * @param utcNow Current UTC epoch.
+   * @param apiCalls API requests spent.
+   */
+  void recordExtraCalls(uint32_t utcNow, uint16_t apiCalls);
+
+  /**
+   * @brief API calls one planned sync spent last time (estimate for the next one).
+   */
+  uint32_t callsPerSync() const;
+
+  /**
+   * @brief UTC epoch of the next planned sync (0 if not planned yet).
+   */
+  uint32_t nextSyncEpoch() const;
+
+  /**
+   * @brief API calls spent in the current UTC day.
+   */
+  uint32_t callsToday() const;
+
+  /**
+   * @brief Interval chosen for the last plan, in seconds.
+   */
+  uint32_t currentIntervalSec() const;
+
+ private:
+  /**
+   * @brief Choose cadence from forecast volatility.
+   */
+  uint32_t intervalForWeather(const WeatherData& weather) const;
+
+  Config config_;
+  uint32_t deviceSeed_ = 0;
+  uint32_t nextSyncEpoch_ = 0;
+  uint32_t quotaDay_ = 0;
+  uint32_t callsToday_ = 0;
+  uint32_t lastCallsPerSync_ = 2;
+  uint32_t currentIntervalSec_ = 0;
+};
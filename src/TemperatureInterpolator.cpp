@@ -0,0 +1,103 @@
+#include "TemperatureInterpolator.h"
+
+#include "DeferredLog.h"
+
+namespace {
+uint32_t absDiffTenths(int32_t aCenti, int32_t bCenti) {
+  const int32_t diff = aCenti - bCenti;
+  return static_cast<uint32_t>((diff < 0 ? -diff : diff) + 5) / 10;
+}
+
+int16_t roundCenti(int32_t centi) {
+  return static_cast<int16_t>(centi >= 0 ? (centi + 50) / 100 : (centi - 50) / 100);
+}
+}  // namespace
+
+/**
+ * Score the last shown value against the new observation, then re-anchor the blend.
+ */
+void TemperatureInterpolator::observe(const WeatherData& weather, uint32_t utcEpoch) {
+  const int32_t actualCenti = static_cast<int32_t>(weather.temperatureF) * 100;
+  if (active_ && utcEpoch > observedEpoch_ && utcEpoch - observedEpoch_ <= kMaxScoredGapSec) {
+    // The model already holds the new forecast, so score what was on screen (at most a minute old).
+    const uint32_t interpError = absDiffTenths(displayCenti_, actualCenti);
+    const uint32_t heldError = absDiffTenths(static_cast<int32_t>(observedF_) * 100, actualCenti);
+    ++scoredSamples_;
+    sumAbsErrorTenths_ += interpError;
+    sumHeldAbsErrorTenths_ += heldError;
+    if (interpError > maxAbsErrorTenths_) {
+      maxAbsErrorTenths_ = interpError;
+    }
+    LOG_INFO(InterpError, interpError, heldError, meanAbsErrorTenths(), heldMeanAbsErrorTenths(), maxAbsErrorTenths_,
+             scoredSamples_);
+  }
+
+  forecast_ = &weather.forecast;
+  observedF_ = weather.temperatureF;
+  observedEpoch_ = utcEpoch;
+  lastMinute_ = utcEpoch / 60UL;
+  active_ = weather.forecast.hourlyCount > 0;
+  biasCenti_ = active_ ? actualCenti - forecastCentiAt(utcEpoch) : 0;
+  displayCenti_ = actualCenti;
+}
+
+/**
+ * Decay the bias once per elapsed minute and re-evaluate forecast + bias.
+ */
+bool TemperatureInterpolator::update(uint32_t utcNow) {
+  const uint32_t minute = utcNow / 60UL;
+  if (!active_ || minute <= lastMinute_) {
+    return false;
+  }
+  const uint32_t elapsed = minute - lastMinute_;
+  lastMinute_ = minute;
+  if (elapsed >= kMaxDecayMinutes) {
+    biasCenti_ = 0;
+  } else {
+    for (uint32_t i = 0; i < elapsed && biasCenti_ != 0; ++i) {
+      biasCenti_ = (biasCenti_ * kBiasDecayQ15) / 32768;
+    }
+  }
+  displayCenti_ = forecastCentiAt(utcNow) + biasCenti_;
+  return true;
+}
+
+/**
+ * Linear interpolation between neighbouring hourly points, clamped to the series ends.
+ */
+int32_t TemperatureInterpolator::forecastCentiAt(uint32_t utcEpoch) const {
+  const ForecastStore& forecast = *forecast_;
+  const uint8_t count = forecast.hourlyCount;
+  if (utcEpoch <= forecast.hourlyStartEpoch) {
+    return static_cast<int32_t>(forecast.hourlyTempF(0)) * 100;
+  }
+  const uint32_t offset = utcEpoch - forecast.hourlyStartEpoch;
+  const uint32_t idx = offset / 3600UL;
+  if (idx + 1 >= count) {
+    return static_cast<int32_t>(forecast.hourlyTempF(static_cast<uint8_t>(count - 1))) * 100;
+  }
+  const int32_t a = static_cast<int32_t>(forecast.hourlyTempF(static_cast<uint8_t>(idx))) * 100;
+  const int32_t b = static_cast<int32_t>(forecast.hourlyTempF(static_cast<uint8_t>(idx + 1))) * 100;
+  const int32_t frac = static_cast<int32_t>(offset % 3600UL);
+  return a + ((b - a) * frac) / 3600;
+}
+
+bool TemperatureInterpolator::active() const {
+  return active_;
+}
+
+int16_t TemperatureInterpolator::temperatureF() const {
+  return roundCenti(displayCenti_);
+}
+
+uint32_t TemperatureInterpolator::scoredSamples() const {
+  return scoredSamples_;
+}
+
+uint32_t TemperatureInterpolator::meanAbsErrorTenths() const {
+  return scoredSamples_ == 0 ? 0 : sumAbsErrorTenths_ / scoredSamples_;
+}
+
+uint32_t TemperatureInterpolator::heldMeanAbsErrorTenths() const {
+  return scoredSamples_ == 0 ? 0 : sumHeldAbsErrorTenths_ / scoredSamples_;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <stdint.h>
+#include "Models.h"
+
+/**
+ * @brief Blends the last observed temperature toward the hourly forecast curve between syncs.
+ *
+ * At each observation the gap between observed and forecast temperature (the
+ * bias) is captured. Once per minute the bias decays by a fixed-point factor
+ * (time constant kBiasTimeConstantMin), and the shown value is the linearly
+ * interpolated forecast plus the remaining bias. Each new observation is also
+ * scored against the running prediction and against simply holding the
+ * previous observation, so the benefit can be read from the serial log.
+ */
+class TemperatureInterpolator {
+ public:
+  /**
+   * @brief Start a new blend from a fresh observation.
+   * @param weather Model with temperatureF and the hourly forecast series; must stay alive.
+   * @param utcEpoch Observation time.
+   */
+  void observe(const WeatherData& weather, uint32_t utcEpoch);
+
+  /**
+   * @brief Advance the blend to utcNow; does work only when a new minute has started.
+   * @return True if the displayed value was recomputed.
+   */
+  bool update(uint32_t utcNow);
+
+  /**
+   * @brief True once an observation with a forecast series has been seen.
+   */
+  bool active() const;
+
+  /**
+   * @brief Interpolated temperature in Fahrenheit.
+   */
+  int16_t temperatureF() const;
+
+  /**
+   * @brief Observations scored so far.
+   */
+  uint32_t scoredSamples() const;
+
+  /**
+   * @brief Mean absolute error of the interpolated prediction, in tenths of a degree.
+   */
+  uint32_t meanAbsErrorTenths() const;
+
+  /**
+   * @brief Mean absolute error of holding the previous observation, in tenths of a degree.
+   */
+  uint32_t heldMeanAbsErrorTenths() const;
+
+ private:
+  static constexpr uint32_t kBiasTimeConstantMin = 180;
+  // exp(-1 / kBiasTimeConstantMin) in Q15.
+  static constexpr int32_t kBiasDecayQ15 = 32586;
+  // Beyond this the bias is below rounding; skip the per-minute loop.
+  static constexpr uint32_t kMaxDecayMinutes = 12 * 60;
+  // Observations further apart than this say little about the blend.
+  static constexpr uint32_t kMaxScoredGapSec = 4 * 3600;
+
+  /**
+   * @brief Forecast temperature at utcEpoch in hundredths of a degree.
+   */
+  int32_t forecastCentiAt(uint32_t utcEpoch) const;
+
+  const ForecastStore* forecast_ = nullptr;
+  bool active_ = false;
+  int16_t observedF_ = 0;
+  uint32_t observedEpoch_ = 0;
+  uint32_t lastMinute_ = 0;
+  int32_t biasCenti_ = 0;
+  int32_t displayCenti_ = 0;
+
+  uint32_t scoredSamples_ = 0;
+  uint32_t sumAbsErrorTenths_ = 0;
+  uint32_t sumHeldAbsErrorTenths_ = 0;
+  uint32_t maxAbsErrorTenths_ = 0;
+};
@@ -2,19 +2,45 @@
 
 #include <Arduino.h>
 #include <time.h>
+#include "DeferredLog.h"
+#include "SunCalc.h"
+#include "Trace.h"
+
+namespace {
+// NTP attempts block for up to 24 s, so back off harder than the HTTP paths.
+constexpr RetryPolicy::Config kNtpRetryConfig = {
+    30UL * 1000UL,          // baseDelayMs
+    30UL * 60UL * 1000UL,   // maxDelayMs
+    3,                      // failureThreshold
+    60UL * 60UL * 1000UL};  // openCooldownMs
+}  // namespace
 
 /**
  * Initialize local offset to UTC until weather API offset is applied.
  */
-TimeService::TimeService() : utcOffsetSeconds_(0) {}
+TimeService::TimeService() : utcOffsetSeconds_(0), ntpRetry_("NTP", kNtpRetryConfig) {}
 
 /**
  * Store UTC offset (seconds) used for local-time conversion.
  */
 void TimeService::setUtcOffsetSeconds(int32_t offsetSeconds) {
   utcOffsetSeconds_ = offsetSeconds;
-  Serial.print("[TIME] UTC offset set to seconds: ");
-  Serial.println(utcOffsetSeconds_);
+  tick_.valid = false;
+  LOG_INFO(TimeOffsetSet, utcOffsetSeconds_);
+}
+
+/**
+ * Treat anything before kMinValidEpoch as the unset power-on clock.
+ */
+bool TimeService::isClockSet(time_t utcNow) {
+  return utcNow >= kMinValidEpoch;
+}
+
+/**
+ * Return utcNow for storage, or 0 when it cannot be trusted yet.
+ */
+uint32_t TimeService::epochOrZero(time_t utcNow) {
+  return isClockSet(utcNow) ? static_cast<uint32_t>(utcNow) : 0;
 }
 
 /**
@@ -28,50 +54,228 @@ int32_t TimeService::utcOffsetSeconds() const {
  * Synchronize system UTC time from pool NTP servers.
  */
 bool TimeService::syncFromNtp() {
-  // Two attempts with overlapping pool servers improves cold-boot reliability.
-  Serial.println("[TIME] Starting NTP sync (attempt 1)");
+  beginNtpSync();
+  return finishNtpSync();
+}
+
+/**
+ * Kick off NTP attempt 1; SNTP completes in the background.
+ */
+void TimeService::beginNtpSync() {
+  ntpAttemptActive_ = ntpRetry_.allowAttempt(millis());
+  if (!ntpAttemptActive_) {
+    // SNTP keeps polling from the last configTime(); skip the blocking wait.
+    LOG_INFO(TimeNtpSkipped);
+    return;
+  }
+  LOG_INFO(TimeNtpStarting);
   configTime(0, 0, "0.us.pool.ntp.org", "1.us.pool.ntp.org", "2.us.pool.ntp.org");
-  const unsigned long firstAttemptStart = millis();
-  while (time(nullptr) < 8 * 3600 * 2 && (millis() - firstAttemptStart) < 12000) {
+  ntpAttemptStartMs_ = millis();
+}
+
+/**
+ * Wait for the pending NTP attempt, then fall back to a second server set.
+ */
+bool TimeService::finishNtpSync() {
+  TRACE_SCOPE("ntp-wait");
+  if (!ntpAttemptActive_) {
+    return isClockSet(time(nullptr));
+  }
+  ntpAttemptActive_ = false;
+
+  // Two attempts with overlapping pool servers improves cold-boot reliability.
+  // Time already spent on overlapped work counts against attempt 1's window.
+  while (!isClockSet(time(nullptr)) && (millis() - ntpAttemptStartMs_) < 12000) {
     delay(100);
   }
-  if (time(nullptr) >= 8 * 3600 * 2) {
-    Serial.println("[TIME] NTP sync succeeded on attempt 1");
+  if (isClockSet(time(nullptr))) {
+    LOG_INFO(TimeNtpFirstOk, static_cast<uint32_t>(millis() - ntpAttemptStartMs_));
+    ntpRetry_.recordSuccess();
     return true;
   }
 
-  Serial.println("[TIME] NTP sync attempt 1 failed, trying attempt 2");
+  LOG_WARN(TimeNtpSecondTry);
   configTime(0, 0, "1.us.pool.ntp.org", "2.us.pool.ntp.org", "3.us.pool.ntp.org");
   const unsigned long secondAttemptStart = millis();
-  while (time(nullptr) < 8 * 3600 * 2 && (millis() - secondAttemptStart) < 12000) {
+  while (!isClockSet(time(nullptr)) && (millis() - secondAttemptStart) < 12000) {
     delay(100);
   }
 
-  const bool ok = time(nullptr) >= 8 * 3600 * 2;
-  Serial.print("[TIME] NTP sync attempt 2 result: ");
-  Serial.println(ok ? "success" : "failed");
+  const bool ok = isClockSet(time(nullptr));
+  LOG_INFO(TimeNtpSecondResult, ok ? "success" : "failed");
+  if (ok) {
+    ntpRetry_.recordSuccess();
+  } else {
+    ntpRetry_.recordFailure(millis());
+  }
   return ok;
 }
 
+/**
+ * Return remaining NTP backoff.
+ */
+uint32_t TimeService::msUntilNtpRetry(unsigned long nowMs) const {
+  return ntpRetry_.msUntilNextAttempt(nowMs);
+}
+
 /**
  * Refresh clock fields by converting current UTC epoch into local time.
  */
 bool TimeService::refreshClockData(ClockData& clock) const {
   const time_t utcNow = time(nullptr);
-  if (utcNow < 8 * 3600 * 2) {
-    Serial.println("[TIME] refreshClockData failed: system time not valid yet");
+  if (!isClockSet(utcNow)) {
+    LOG_WARN(TimeClockInvalid);
     clock.valid = false;
     return false;
   }
 
   // Convert to local time by applying OpenWeather-provided UTC offset.
-  const time_t localNow = utcNow + utcOffsetSeconds_;
-  tm timeInfo{};
-  gmtime_r(&localNow, &timeInfo);
-  clock.hour = static_cast<uint8_t>(timeInfo.tm_hour);
-  clock.minute = static_cast<uint8_t>(timeInfo.tm_min);
-  clock.month = static_cast<uint8_t>(timeInfo.tm_mon + 1);
-  clock.day = static_cast<uint8_t>(timeInfo.tm_mday);
+  const int64_t localNow = static_cast<int64_t>(utcNow) + utcOffsetSeconds_;
+  const int64_t step = localNow - tick_.localEpoch;
+  if (tick_.valid && step >= 0 && step < 60) {
+    // Regular 1 s refresh: carry seconds into the cached fields.
+    advanceTick(tick_, static_cast<uint8_t>(step));
+  } else {
+    // First call, clock step (NTP) or offset change: full conversion.
+    tick_.time = civilTimeFromEpoch(localNow);
+    tick_.date = civilFromDays(tick_.time.days);
+    tick_.localEpoch = localNow;
+    tick_.valid = true;
+  }
+  clock.hour = tick_.time.hour;
+  clock.minute = tick_.time.minute;
+  clock.month = tick_.date.month;
+  clock.day = tick_.date.day;
+  clock.weekday = weekdayFromDays(tick_.time.days);
   clock.valid = true;
   return true;
 }
+
+/**
+ * Advance cached local time by less than one minute; the date is rebuilt only at midnight.
+ */
+void TimeService::advanceTick(ClockTick& tick, uint8_t seconds) {
+  tick.localEpoch += seconds;
+  tick.time.second = static_cast<uint8_t>(tick.time.second + seconds);
+  if (tick.time.second < 60) {
+    return;
+  }
+  tick.time.second = static_cast<uint8_t>(tick.time.second - 60);
+  if (++tick.time.minute < 60) {
+    return;
+  }
+  tick.time.minute = 0;
+  if (++tick.time.hour < 24) {
+    return;
+  }
+  tick.time.hour = 0;
+  ++tick.time.days;
+  tick.date = civilFromDays(tick.time.days);
+}
+
+#if WEATHERCLOCK_BENCH
+/**
+ * Compare gmtime_r, a full civil conversion and the incremental tick in CPU cycles.
+ */
+void TimeService::logCalendarBenchmark() {
+  constexpr uint16_t kIterations = 256;
+  // Start just before a local midnight so the tick loop crosses a day boundary.
+  const int64_t baseEpoch = static_cast<int64_t>(daysFromCivil(2025, 2, 28)) * 86400 + 86400 - 100;
+  volatile uint32_t sink = 0;
+
+  uint32_t start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    const time_t epoch = static_cast<time_t>(baseEpoch + i);
+    tm info{};
+    gmtime_r(&epoch, &info);
+    sink = sink + static_cast<uint32_t>(info.tm_mday + info.tm_hour + info.tm_wday);
+  }
+  const uint32_t gmtimeCycles = ESP.getCycleCount() - start;
+
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    const CivilTime time = civilTimeFromEpoch(baseEpoch + i);
+    const CivilDate date = civilFromDays(time.days);
+    sink = sink + date.day + time.hour + weekdayFromDays(time.days);
+  }
+  const uint32_t civilCycles = ESP.getCycleCount() - start;
+
+  ClockTick tick{};
+  tick.time = civilTimeFromEpoch(baseEpoch);
+  tick.date = civilFromDays(tick.time.days);
+  tick.localEpoch = baseEpoch;
+  tick.valid = true;
+  start = ESP.getCycleCount();
+  for (uint16_t i = 0; i < kIterations; ++i) {
+    advanceTick(tick, 1);
+    sink = sink + tick.date.day + tick.time.hour + weekdayFromDays(tick.time.days);
+  }
+  const uint32_t tickCycles = ESP.getCycleCount() - start;
+  (void)sink;
+
+  Serial.print("[TIME] Calendar cycles/conversion gmtime_r=");
+  Serial.print(gmtimeCycles / kIterations);
+  Serial.print(" civil=");
+  Serial.print(civilCycles / kIterations);
+  Serial.print(" tick=");
+  Serial.println(tickCycles / kIterations);
+}
+#endif
+
+/**
+ * Remember the observer location used for local sunrise/sunset.
+ */
+void TimeService::setLocation(int32_t latMicrodeg, int32_t lonMicrodeg) {
+  if (hasLocation_ && latMicrodeg == latMicrodeg_ && lonMicrodeg == lonMicrodeg_) {
+    return;
+  }
+  latMicrodeg_ = latMicrodeg;
+  lonMicrodeg_ = lonMicrodeg;
+  hasLocation_ = true;
+  // Force recomputation on the next update.
+  sunDayNumber_ = INT32_MIN;
+}
+
+/**
+ * Return true once a location is known.
+ */
+bool TimeService::hasLocation() const {
+  return hasLocation_;
+}
+
+/**
+ * Recompute today's and tomorrow's sun times when the local day, offset or location changed.
+ */
+bool TimeService::updateSunTimes() {
+  const time_t utcNow = time(nullptr);
+  if (!hasLocation_ || !isClockSet(utcNow)) {
+    return false;
+  }
+  const int64_t localNow = static_cast<int64_t>(utcNow) + utcOffsetSeconds_;
+  const int32_t dayNumber = civilTimeFromEpoch(localNow).days;
+  if (dayNumber == sunDayNumber_ && utcOffsetSeconds_ == sunOffsetSeconds_) {
+    return false;
+  }
+  sunDayNumber_ = dayNumber;
+  sunOffsetSeconds_ = utcOffsetSeconds_;
+  computeSunTimes(latMicrodeg_, lonMicrodeg_, dayNumber, utcOffsetSeconds_, sunToday_);
+  computeSunTimes(latMicrodeg_, lonMicrodeg_, dayNumber + 1, utcOffsetSeconds_, sunTomorrow_);
+
+  LOG_INFO(SunToday, sunToday_.sunriseMinute / 60, sunToday_.sunriseMinute % 60, sunToday_.sunsetMinute / 60,
+           sunToday_.sunsetMinute % 60, sunToday_.valid ? "yes" : "no");
+  return true;
+}
+
+/**
+ * Return sun times for the current local day.
+ */
+const SunTimes& TimeService::sunToday() const {
+  return sunToday_;
+}
+
+/**
+ * Return sun times for the next local day.
+ */
+const SunTimes& TimeService::sunTomorrow() const {
+  return sunTomorrow_;
+}
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <stdint.h>
+#include <time.h>
+#include "CivilCalendar.h"
 #include "Models.h"
+#include "RetryPolicy.h"
 
 /**
  * @brief Handles NTP sync and UTC-offset-based local time conversion.
@@ -12,6 +16,21 @@ class TimeService {
    */
   TimeService();
 
+  /**
+   * @brief UTC epochs earlier than this mean NTP has not set the system clock yet.
+   */
+  static constexpr time_t kMinValidEpoch = 8 * 3600 * 2;
+
+  /**
+   * @brief True if utcNow comes from a clock that NTP has set.
+   */
+  static bool isClockSet(time_t utcNow);
+
+  /**
+   * @brief utcNow as a stored epoch, or 0 (unknown) while the clock is not set.
+   */
+  static uint32_t epochOrZero(time_t utcNow);
+
   /**
    * @brief Set local offset from UTC in seconds.
    * @param offsetSeconds Offset returned by weather API timezone offset.
@@ -29,13 +48,97 @@ class TimeService {
    */
   bool syncFromNtp();
 
+  /**
+   * @brief Start the first NTP attempt without waiting for it.
+   *
+   * SNTP runs in the background, so callers can do other network work
+   * (e.g. the weather fetch) before calling finishNtpSync().
+   */
+  void beginNtpSync();
+
+  /**
+   * @brief Wait out the NTP attempt started by beginNtpSync(), retrying once if needed.
+   * @return True if UTC time was synchronized successfully.
+   */
+  bool finishNtpSync();
+
+  /**
+   * @brief Milliseconds until NTP backoff/circuit breaker allow another sync attempt.
+   * @param nowMs Current millis().
+   */
+  uint32_t msUntilNtpRetry(unsigned long nowMs) const;
+
   /**
    * @brief Convert current UTC epoch to local clock fields.
+   *
+   * Consecutive calls less than a minute apart advance cached fields instead
+   * of converting the full epoch again.
    * @param clock Output structure to populate.
    * @return True if clock fields are valid.
    */
   bool refreshClockData(ClockData& clock) const;
 
+  /**
+   * @brief Set observer location for local sunrise/sunset.
+   * @param latMicrodeg Latitude in millionths of a degree (north positive).
+   * @param lonMicrodeg Longitude in millionths of a degree (east positive).
+   */
+  void setLocation(int32_t latMicrodeg, int32_t lonMicrodeg);
+
+  /**
+   * @brief True once setLocation() has been called.
+   */
+  bool hasLocation() const;
+
+  /**
+   * @brief Recompute today's/tomorrow's sun times if the local day, offset or location changed.
+   * @return True if the values were recomputed.
+   */
+  bool updateSunTimes();
+
+  /**
+   * @brief Sunrise/sunset for the current local day.
+   */
+  const SunTimes& sunToday() const;
+
+  /**
+   * @brief Sunrise/sunset for the next local day.
+   */
+  const SunTimes& sunTomorrow() const;
+
+#if WEATHERCLOCK_BENCH
+  /**
+   * @brief Log CPU cycles per conversion for gmtime_r, the civil calendar and the incremental tick.
+   */
+  static void logCalendarBenchmark();
+#endif
+
  private:
+  /**
+   * @brief Cached local time advanced by refreshClockData().
+   */
+  struct ClockTick {
+    int64_t localEpoch;
+    CivilTime time;
+    CivilDate date;
+    bool valid;
+  };
+
+  /**
+   * @brief Add up to 59 seconds to a cached tick, carrying into minute/hour/date.
+   */
+  static void advanceTick(ClockTick& tick, uint8_t seconds);
+
   int32_t utcOffsetSeconds_ = 0;
+  unsigned long ntpAttemptStartMs_ = 0;
+  bool ntpAttemptActive_ = false;
+  RetryPolicy ntpRetry_;
+  bool hasLocation_ = false;
+  int32_t latMicrodeg_ = 0;
+  int32_t lonMicrodeg_ = 0;
+  int32_t sunDayNumber_ = INT32_MIN;
+  int32_t sunOffsetSeconds_ = 0;
+  SunTimes sunToday_{};
+  SunTimes sunTomorrow_{};
+  mutable ClockTick tick_{};
 };
@@ -0,0 +1,113 @@
+#include "Trace.h"
+
+#if WEATHERCLOCK_TRACE
+
+#include <Arduino.h>
+#include <stdio.h>
+
+TraceSpan TraceRing::spans_[TraceRing::kCapacity];
+volatile uint16_t TraceRing::head_ = 0;
+volatile uint16_t TraceRing::count_ = 0;
+volatile bool TraceRing::frozen_ = false;
+
+namespace {
+constexpr size_t kChunkSize = 512;
+// Longest event line: fixed text plus a short label and two 10-digit numbers.
+constexpr size_t kMaxEventLength = 128;
+}  // namespace
+
+/**
+ * Fill the head slot, then publish it.
+ */
+void TraceRing::record(const char* name, uint32_t startUs, uint32_t durationUs) {
+  if (frozen_) {
+    return;
+  }
+  const uint16_t head = head_;
+  spans_[head].name = name;
+  spans_[head].startUs = startUs;
+  spans_[head].durationUs = durationUs;
+  head_ = static_cast<uint16_t>((head + 1) & (kCapacity - 1));
+  if (count_ < kCapacity) {
+    count_ = static_cast<uint16_t>(count_ + 1);
+  }
+}
+
+/**
+ * Hold the current spans until the next dump.
+ */
+void TraceRing::freeze() {
+  frozen_ = true;
+  Serial.print("[TRACE] Capture held, spans=");
+  Serial.print(count_);
+  Serial.println("; fetch /trace.json to view and resume");
+}
+
+/**
+ * Stream the ring oldest-first as Chrome trace-event JSON in fixed-size chunks.
+ */
+size_t TraceRing::renderChromeJson(Writer writer, void* context) {
+  char chunk[kChunkSize];
+  size_t used = 0;
+  size_t total = 0;
+  const uint16_t count = count_;
+  const uint16_t first = static_cast<uint16_t>((head_ - count) & (kCapacity - 1));
+  // Spans are recorded on exit, so an enclosing span can start before the oldest record.
+  uint32_t originUs = count > 0 ? spans_[first].startUs : 0;
+  for (uint16_t i = 1; i < count; ++i) {
+    const uint32_t startUs = spans_[(first + i) & (kCapacity - 1)].startUs;
+    if (static_cast<int32_t>(startUs - originUs) < 0) {
+      originUs = startUs;
+    }
+  }
+
+  used = static_cast<size_t>(snprintf(chunk, sizeof(chunk), "{\"traceEvents\":["));
+  for (uint16_t i = 0; i < count; ++i) {
+    if (sizeof(chunk) - used < kMaxEventLength) {
+      writer(context, chunk, used);
+      total += used;
+      used = 0;
+    }
+    const TraceSpan& span = spans_[(first + i) & (kCapacity - 1)];
+    const int n = snprintf(chunk + used, sizeof(chunk) - used,
+                           "%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%lu,\"dur\":%lu,\"pid\":1,\"tid\":1}",
+                           i == 0 ? "" : ",", span.name, static_cast<unsigned long>(span.startUs - originUs),
+                           static_cast<unsigned long>(span.durationUs));
+    if (n > 0 && static_cast<size_t>(n) < sizeof(chunk) - used) {
+      used += static_cast<size_t>(n);
+    }
+  }
+  if (sizeof(chunk) - used < kMaxEventLength) {
+    writer(context, chunk, used);
+    total += used;
+    used = 0;
+  }
+  const int n = snprintf(chunk + used, sizeof(chunk) - used, "],\"displayTimeUnit\":\"ms\"}");
+  if (n > 0 && static_cast<size_t>(n) < sizeof(chunk) - used) {
+    used += static_cast<size_t>(n);
+  }
+  writer(context, chunk, used);
+  total += used;
+
+  count_ = 0;
+  frozen_ = false;
+  return total;
+}
+
+/**
+ * Stamp the entry time.
+ */
+TraceScope::TraceScope(const char* name, bool freezeOnExit)
+    : name_(name), startUs_(micros()), freezeOnExit_(freezeOnExit) {}
+
+/**
+ * Record the span on scope exit.
+ */
+TraceScope::~TraceScope() {
+  TraceRing::record(name_, startUs_, micros() - startUs_);
+  if (freezeOnExit_) {
+    TraceRing::freeze();
+  }
+}
+
+#endif
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Build with -D WEATHERCLOCK_TRACE=1 to record spans; otherwise TRACE_SCOPE expands to nothing.
+#ifndef WEATHERCLOCK_TRACE
+#define WEATHERCLOCK_TRACE 0
+#endif
+
+#if WEATHERCLOCK_TRACE
+
+/**
+ * @brief One completed timed region.
+ */
+struct TraceSpan {
+  /** @brief Static label; must be a string literal. */
+  const char* name;
+  /** @brief micros() at entry. */
+  uint32_t startUs;
+  /** @brief Time spent inside the region. */
+  uint32_t durationUs;
+};
+
+/**
+ * @brief Fixed-size ring of the most recent spans, exportable as Chrome trace-event JSON.
+ *
+ * Spans are recorded from loop context only. The writer fills a slot before
+ * publishing the new head, so a dump taken from a web handler never sees a
+ * half-written span. When full, the oldest spans are overwritten.
+ *
+ * Every loop pass adds draw spans, so a sync would scroll out of the ring
+ * within a second; freeze() holds the ring after a sync until it is dumped.
+ */
+class TraceRing {
+ public:
+  /**
+   * @brief Receives one chunk of rendered JSON.
+   * @param context Caller-owned state passed to renderChromeJson().
+   * @param data Chunk bytes; not NUL-terminated and only valid during the call.
+   * @param length Chunk size.
+   */
+  using Writer = void (*)(void* context, const char* data, size_t length);
+
+  /**
+   * @brief Append one span, overwriting the oldest when full.
+   */
+  static void record(const char* name, uint32_t startUs, uint32_t durationUs);
+
+  /**
+   * @brief Stop recording so the current contents survive until the next dump.
+   */
+  static void freeze();
+
+  /**
+   * @brief Format the ring oldest-first as {"traceEvents":[...]} complete ("X") events.
+   *
+   * Timestamps are relative to the oldest span so micros() wrap does not reorder the timeline.
+   * Dumping clears a freeze() and starts a fresh capture.
+   * @return Total bytes written.
+   */
+  static size_t renderChromeJson(Writer writer, void* context);
+
+ private:
+  static constexpr uint16_t kCapacity = 128;  // Power of two for cheap index wrap.
+
+  static TraceSpan spans_[kCapacity];
+  static volatile uint16_t head_;
+  static volatile uint16_t count_;
+  static volatile bool frozen_;
+};
+
+/**
+ * @brief RAII timer that records a span for its enclosing scope.
+ */
+class TraceScope {
+ public:
+  /**
+   * @param name String-literal label.
+   * @param freezeOnExit Hold the ring after this span so it can be dumped intact.
+   */
+  explicit TraceScope(const char* name, bool freezeOnExit = false);
+  ~TraceScope();
+
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private:
+  const char* name_;
+  uint32_t startUs_;
+  bool freezeOnExit_;
+};
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+/** @brief Time the rest of the enclosing scope under a string-literal label. */
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name)
+/** @brief Like TRACE_SCOPE, then hold the ring so the whole capture can be dumped. */
+#define TRACE_CAPTURE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope_, __LINE__)(name, true)
+
+#else
+
+#define TRACE_SCOPE(name) static_cast<void>(0)
+#define TRACE_CAPTURE_SCOPE(name) static_cast<void>(0)
+
+#endif
@@ -0,0 +1,41 @@
+#include "WeatherAlerts.h"
+
+#include <string.h>
+
+namespace {
+constexpr uint8_t kWindAdvisoryGustMph = 20;
+
+void setAdvisory(WeatherData& weather, const char* text) {
+  strncpy(weather.advisory, text, sizeof(weather.advisory) - 1);
+  weather.advisory[sizeof(weather.advisory) - 1] = '\0';
+}
+}  // namespace
+
+uint8_t pruneExpiredAlerts(WeatherData& weather, uint32_t utcNow) {
+  uint8_t kept = 0;
+  const uint8_t count = weather.alertCount > kMaxWeatherAlerts ? kMaxWeatherAlerts : weather.alertCount;
+  for (uint8_t i = 0; i < count; ++i) {
+    if (weather.alerts[i].endEpoch > utcNow) {
+      if (kept != i) {
+        weather.alerts[kept] = weather.alerts[i];
+      }
+      ++kept;
+    }
+  }
+  const uint8_t removed = static_cast<uint8_t>(count - kept);
+  weather.alertCount = kept;
+  if (removed > 0) {
+    refreshAdvisorySummary(weather);
+  }
+  return removed;
+}
+
+void refreshAdvisorySummary(WeatherData& weather) {
+  if (weather.alertCount > 0) {
+    setAdvisory(weather, weather.alerts[0].event);
+  } else if (weather.gustMph >= kWindAdvisoryGustMph) {
+    setAdvisory(weather, "WIND ADVISORY");
+  } else {
+    setAdvisory(weather, "NO ADVISORIES");
+  }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <stdint.h>
+#include "Models.h"
+
+/**
+ * @brief Drop alerts whose end time has passed, keeping the remaining order.
+ * @param weather Model whose alert list is pruned in place.
+ * @param utcNow Current UTC epoch.
+ * @return Number of alerts removed.
+ */
+uint8_t pruneExpiredAlerts(WeatherData& weather, uint32_t utcNow);
+
+/**
+ * @brief Rebuild the one-line advisory summary.
+ *
+ * Uses the first alert in the list, then a synthetic wind advisory for
+ * strong gusts, then "NO ADVISORIES".
+ * @param weather Model whose advisory line is rewritten.
+ */
+void refreshAdvisorySummary(WeatherData& weather);
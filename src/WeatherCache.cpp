@@ -0,0 +1,76 @@
+#include "WeatherCache.h"
+
+#include "TimeService.h"
+
+/**
+ * Classify by age; unknown age (no NTP yet, or fetched before NTP) is treated as stale.
+ */
+WeatherFreshness WeatherCache::evaluate(const WeatherData& weather, time_t utcNow) {
+  lastAgeMinutes_ = -1;
+  if (!weather.valid) {
+    lastFreshness_ = WeatherFreshness::Expired;
+    return lastFreshness_;
+  }
+
+  const bool clockValid = TimeService::isClockSet(utcNow);
+  if (!clockValid || weather.fetchedAtEpoch == 0 || utcNow < static_cast<time_t>(weather.fetchedAtEpoch)) {
+    lastFreshness_ = WeatherFreshness::Stale;
+    return lastFreshness_;
+  }
+
+  const uint32_t ageSeconds = static_cast<uint32_t>(utcNow - static_cast<time_t>(weather.fetchedAtEpoch));
+  lastAgeMinutes_ = static_cast<int32_t>(ageSeconds / 60);
+  if (ageSeconds < kFreshSeconds) {
+    lastFreshness_ = WeatherFreshness::Fresh;
+  } else if (ageSeconds < kExpiredSeconds) {
+    lastFreshness_ = WeatherFreshness::Stale;
+  } else {
+    lastFreshness_ = WeatherFreshness::Expired;
+  }
+  return lastFreshness_;
+}
+
+/**
+ * Count one sync against the tier it found.
+ */
+void WeatherCache::recordSync() {
+  switch (lastFreshness_) {
+    case WeatherFreshness::Fresh:
+      ++hitCount_;
+      break;
+    case WeatherFreshness::Stale:
+      ++staleCount_;
+      break;
+    case WeatherFreshness::Expired:
+      ++expiredCount_;
+      break;
+  }
+}
+
+/**
+ * Return age from the last classification.
+ */
+int32_t WeatherCache::lastAgeMinutes() const {
+  return lastAgeMinutes_;
+}
+
+/**
+ * Return syncs that found fresh data.
+ */
+uint32_t WeatherCache::hitCount() const {
+  return hitCount_;
+}
+
+/**
+ * Return syncs that found stale data.
+ */
+uint32_t WeatherCache::staleCount() const {
+  return staleCount_;
+}
+
+/**
+ * Return syncs that found expired or missing data.
+ */
+uint32_t WeatherCache::expiredCount() const {
+  return expiredCount_;
+}
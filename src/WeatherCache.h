@@ -0,0 +1,72 @@
+#pragma once
+
+#include <stdint.h>
+#include <time.h>
+#include "Models.h"
+
+/**
+ * @brief Freshness tier of cached weather relative to its fetch time.
+ */
+enum class WeatherFreshness : uint8_t {
+  Fresh,
+  Stale,
+  Expired
+};
+
+/**
+ * @brief Stale-while-revalidate policy for the current WeatherData.
+ *
+ * Fresh data is shown as-is, stale data keeps showing with an age badge while
+ * refreshes retry, and only expired data falls back to the error screen.
+ */
+class WeatherCache {
+ public:
+  /** @brief Data younger than this is fresh; covers the planner's longest (stable) interval. */
+  static constexpr uint32_t kFreshSeconds = 150UL * 60UL;
+  /** @brief Data older than this is expired and no longer shown. */
+  static constexpr uint32_t kExpiredSeconds = 6UL * 60UL * 60UL;
+
+  /**
+   * @brief Classify weather; cheap enough for the once-per-second display refresh.
+   * @param weather Cached model with fetchedAtEpoch.
+   * @param utcNow Current UTC epoch (may be unsynced).
+   * @return Freshness tier; Expired also covers never-valid data.
+   */
+  WeatherFreshness evaluate(const WeatherData& weather, time_t utcNow);
+
+  /**
+   * @brief Age in minutes from the last evaluate(), or -1 when unknown.
+   */
+  int32_t lastAgeMinutes() const;
+
+  /**
+   * @brief Count the tier from the last evaluate() against one sync attempt.
+   *
+   * Called once at the start of each sync, so the counters say how often a
+   * sync found the cache fresh, stale or unusable rather than how many
+   * seconds were spent in each tier.
+   */
+  void recordSync();
+
+  /**
+   * @brief Syncs that started with fresh data on screen.
+   */
+  uint32_t hitCount() const;
+
+  /**
+   * @brief Syncs that started with stale data on screen.
+   */
+  uint32_t staleCount() const;
+
+  /**
+   * @brief Syncs that started with data expired or missing.
+   */
+  uint32_t expiredCount() const;
+
+ private:
+  int32_t lastAgeMinutes_ = -1;
+  WeatherFreshness lastFreshness_ = WeatherFreshness::Expired;
+  uint32_t hitCount_ = 0;
+  uint32_t staleCount_ = 0;
+  uint32_t expiredCount_ = 0;
+};
@@ -0,0 +1,240 @@
+#include "WeatherCodec.h"
+
+#include <string.h>
+#include "Crc32.h"
+
+namespace {
+// Every field has a fixed width, so the fetch timestamps sit at fixed distances from the
+// record end: fetchedAt, dailyFetchedAt, alerts, alertsFetchedAt, lat, lon, valid.
+constexpr size_t kAlertsFetchedFromEnd = 4 + 4 + 4 + 1;
+constexpr size_t kAlertBlockBytes = 1 + kMaxWeatherAlerts * (sizeof(WeatherAlert::event) + 4 + 4);
+constexpr size_t kDailyFetchedFromEnd = 4 + kAlertBlockBytes + kAlertsFetchedFromEnd;
+constexpr size_t kFetchedFromEnd = 4 + kDailyFetchedFromEnd;
+
+// Bounds-checked little-endian appender; sticks in the failed state on overflow.
+class ByteWriter {
+ public:
+  ByteWriter(uint8_t* out, size_t size) : out_(out), size_(size) {}
+
+  void u8(uint8_t value) { bytes(&value, 1); }
+  void u16(uint16_t value) {
+    const uint8_t raw[2] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8)};
+    bytes(raw, sizeof(raw));
+  }
+  void i16(int16_t value) { u16(static_cast<uint16_t>(value)); }
+  void u32(uint32_t value) {
+    const uint8_t raw[4] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+                            static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)};
+    bytes(raw, sizeof(raw));
+  }
+  void bytes(const void* data, size_t length) {
+    if (failed_ || pos_ + length > size_) {
+      failed_ = true;
+      return;
+    }
+    memcpy(out_ + pos_, data, length);
+    pos_ += length;
+  }
+  size_t finish() const { return failed_ ? 0 : pos_; }
+
+ private:
+  uint8_t* out_;
+  size_t size_;
+  size_t pos_ = 0;
+  bool failed_ = false;
+};
+
+// Bounds-checked little-endian reader mirroring ByteWriter.
+class ByteReader {
+ public:
+  ByteReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+  uint8_t u8() {
+    uint8_t value = 0;
+    bytes(&value, 1);
+    return value;
+  }
+  uint16_t u16() {
+    uint8_t raw[2] = {0, 0};
+    bytes(raw, sizeof(raw));
+    return static_cast<uint16_t>(raw[0] | (raw[1] << 8));
+  }
+  int16_t i16() { return static_cast<int16_t>(u16()); }
+  uint32_t u32() {
+    uint8_t raw[4] = {0, 0, 0, 0};
+    bytes(raw, sizeof(raw));
+    return static_cast<uint32_t>(raw[0]) | (static_cast<uint32_t>(raw[1]) << 8) |
+           (static_cast<uint32_t>(raw[2]) << 16) | (static_cast<uint32_t>(raw[3]) << 24);
+  }
+  void bytes(void* out, size_t length) {
+    if (failed_ || pos_ + length > size_) {
+      failed_ = true;
+      return;
+    }
+    memcpy(out, data_ + pos_, length);
+    pos_ += length;
+  }
+  // Fixed-size text field that must stay NUL-terminated after decode.
+  void text(char* out, size_t length) {
+    bytes(out, length);
+    out[length - 1] = '\0';
+  }
+  WeatherType type() {
+    const uint8_t raw = u8();
+    if (raw >= static_cast<uint8_t>(WeatherType::Count)) {
+      failed_ = true;
+      return WeatherType::Cloudy;
+    }
+    return static_cast<WeatherType>(raw);
+  }
+  bool ok() const { return !failed_ && pos_ == size_; }
+
+ private:
+  const uint8_t* data_;
+  size_t size_;
+  size_t pos_ = 0;
+  bool failed_ = false;
+};
+}  // namespace
+
+size_t encodeWeatherData(const WeatherData& weather, uint8_t* out, size_t outSize) {
+  if (out == nullptr) {
+    return 0;
+  }
+  ByteWriter w(out, outSize);
+  w.i16(weather.temperatureF);
+  w.i16(weather.feelsLikeF);
+  w.u8(weather.rainChancePct);
+  w.u8(weather.snowChancePct);
+  w.u8(static_cast<uint8_t>(weather.type));
+  w.i16(weather.todayHighF);
+  w.i16(weather.todayLowF);
+  w.u8(weather.sunriseHour);
+  w.u8(weather.sunriseMinute);
+  w.u8(weather.sunsetHour);
+  w.u8(weather.sunsetMinute);
+  w.u8(weather.windMph);
+  w.u8(weather.gustMph);
+  w.u16(weather.windDeg);
+  w.bytes(weather.advisory, sizeof(weather.advisory));
+  for (int i = 0; i < 4; ++i) {
+    w.u8(weather.hourlyHour24[i]);
+    w.i16(weather.hourlyTempF[i]);
+    w.u8(static_cast<uint8_t>(weather.hourlyType[i]));
+    w.bytes(weather.hourlyMain[i], sizeof(weather.hourlyMain[i]));
+  }
+  for (int i = 0; i < 4; ++i) {
+    w.u8(weather.dailyDow[i]);
+    w.i16(weather.dailyHighF[i]);
+    w.i16(weather.dailyLowF[i]);
+    w.u8(static_cast<uint8_t>(weather.dailyType[i]));
+    w.bytes(weather.dailyMain[i], sizeof(weather.dailyMain[i]));
+  }
+  const ForecastStore& fc = weather.forecast;
+  w.u32(fc.hourlyStartEpoch);
+  w.i16(fc.hourlyBaseF);
+  w.u8(fc.hourlyCount);
+  w.bytes(fc.hourlyTempDelta, sizeof(fc.hourlyTempDelta));
+  w.bytes(fc.hourlyTypes, sizeof(fc.hourlyTypes));
+  w.bytes(fc.hourlyPopPct, sizeof(fc.hourlyPopPct));
+  w.u32(fc.dailyStartEpoch);
+  w.i16(fc.dailyBaseF);
+  w.u8(fc.dailyCount);
+  w.bytes(fc.dailyHighDelta, sizeof(fc.dailyHighDelta));
+  w.bytes(fc.dailyLowDelta, sizeof(fc.dailyLowDelta));
+  w.bytes(fc.dailyTypes, sizeof(fc.dailyTypes));
+  w.bytes(fc.dailyPopPct, sizeof(fc.dailyPopPct));
+  w.u32(weather.fetchedAtEpoch);
+  w.u32(weather.dailyFetchedAtEpoch);
+  w.u8(weather.alertCount);
+  for (int i = 0; i < kMaxWeatherAlerts; ++i) {
+    w.bytes(weather.alerts[i].event, sizeof(weather.alerts[i].event));
+    w.u32(weather.alerts[i].startEpoch);
+    w.u32(weather.alerts[i].endEpoch);
+  }
+  w.u32(weather.alertsFetchedAtEpoch);
+  w.u32(static_cast<uint32_t>(weather.latMicrodeg));
+  w.u32(static_cast<uint32_t>(weather.lonMicrodeg));
+  w.u8(weather.valid ? 1 : 0);
+  return w.finish();
+}
+
+uint32_t weatherDataContentCrc(uint32_t crc, const uint8_t* data, size_t size) {
+  if (data == nullptr || size < kFetchedFromEnd) {
+    return crc32Update(crc, data, data == nullptr ? 0 : size);
+  }
+  const size_t fetched = size - kFetchedFromEnd;  // fetchedAt and dailyFetchedAt are adjacent.
+  const size_t alertsFetched = size - kAlertsFetchedFromEnd;
+  crc = crc32Update(crc, data, fetched);
+  crc = crc32Update(crc, data + fetched + 8, alertsFetched - (fetched + 8));
+  return crc32Update(crc, data + alertsFetched + 4, size - (alertsFetched + 4));
+}
+
+bool decodeWeatherData(const uint8_t* data, size_t size, WeatherData& weather) {
+  if (data == nullptr) {
+    return false;
+  }
+  // Decode into a scratch copy so a malformed record never leaves a half-written model.
+  WeatherData decoded{};
+  ByteReader r(data, size);
+  decoded.temperatureF = r.i16();
+  decoded.feelsLikeF = r.i16();
+  decoded.rainChancePct = r.u8();
+  decoded.snowChancePct = r.u8();
+  decoded.type = r.type();
+  decoded.todayHighF = r.i16();
+  decoded.todayLowF = r.i16();
+  decoded.sunriseHour = r.u8();
+  decoded.sunriseMinute = r.u8();
+  decoded.sunsetHour = r.u8();
+  decoded.sunsetMinute = r.u8();
+  decoded.windMph = r.u8();
+  decoded.gustMph = r.u8();
+  decoded.windDeg = r.u16();
+  r.text(decoded.advisory, sizeof(decoded.advisory));
+  for (int i = 0; i < 4; ++i) {
+    decoded.hourlyHour24[i] = r.u8();
+    decoded.hourlyTempF[i] = r.i16();
+    decoded.hourlyType[i] = r.type();
+    r.text(decoded.hourlyMain[i], sizeof(decoded.hourlyMain[i]));
+  }
+  for (int i = 0; i < 4; ++i) {
+    decoded.dailyDow[i] = r.u8();
+    decoded.dailyHighF[i] = r.i16();
+    decoded.dailyLowF[i] = r.i16();
+    decoded.dailyType[i] = r.type();
+    r.text(decoded.dailyMain[i], sizeof(decoded.dailyMain[i]));
+  }
+  ForecastStore& fc = decoded.forecast;
+  fc.hourlyStartEpoch = r.u32();
+  fc.hourlyBaseF = r.i16();
+  fc.hourlyCount = r.u8();
+  r.bytes(fc.hourlyTempDelta, sizeof(fc.hourlyTempDelta));
+  r.bytes(fc.hourlyTypes, sizeof(fc.hourlyTypes));
+  r.bytes(fc.hourlyPopPct, sizeof(fc.hourlyPopPct));
+  fc.dailyStartEpoch = r.u32();
+  fc.dailyBaseF = r.i16();
+  fc.dailyCount = r.u8();
+  r.bytes(fc.dailyHighDelta, sizeof(fc.dailyHighDelta));
+  r.bytes(fc.dailyLowDelta, sizeof(fc.dailyLowDelta));
+  r.bytes(fc.dailyTypes, sizeof(fc.dailyTypes));
+  r.bytes(fc.dailyPopPct, sizeof(fc.dailyPopPct));
+  decoded.fetchedAtEpoch = r.u32();
+  decoded.dailyFetchedAtEpoch = r.u32();
+  decoded.alertCount = r.u8();
+  for (int i = 0; i < kMaxWeatherAlerts; ++i) {
+    r.text(decoded.alerts[i].event, sizeof(decoded.alerts[i].event));
+    decoded.alerts[i].startEpoch = r.u32();
+    decoded.alerts[i].endEpoch = r.u32();
+  }
+  decoded.alertsFetchedAtEpoch = r.u32();
+  decoded.latMicrodeg = static_cast<int32_t>(r.u32());
+  decoded.lonMicrodeg = static_cast<int32_t>(r.u32());
+  decoded.valid = r.u8() != 0;
+  if (!r.ok() || decoded.alertCount > kMaxWeatherAlerts || fc.hourlyCount > ForecastStore::kHourlyCapacity ||
+      fc.dailyCount > ForecastStore::kDailyCapacity) {
+    return false;
+  }
+  weather = decoded;
+  return true;
+}
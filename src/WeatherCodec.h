@@ -0,0 +1,44 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Models.h"
+
+/**
+ * @brief Layout version of the packed WeatherData encoding; bump on any field change.
+ */
+constexpr uint8_t kWeatherCodecVersion = 6;
+
+/**
+ * @brief Upper bound for an encoded WeatherData record, for caller buffers.
+ */
+constexpr size_t kWeatherDataMaxEncodedSize = 512;
+
+/**
+ * @brief Pack WeatherData field-by-field (little-endian, no padding).
+ * @param weather Source model.
+ * @param out Destination buffer.
+ * @param outSize Destination capacity.
+ * @return Encoded length, or 0 if the buffer is too small.
+ */
+size_t encodeWeatherData(const WeatherData& weather, uint8_t* out, size_t outSize);
+
+/**
+ * @brief Unpack a record produced by encodeWeatherData().
+ * @param data Encoded bytes.
+ * @param size Encoded length; must match the current layout exactly.
+ * @param weather Output model, only written on success.
+ * @return True if the record was complete and well-formed.
+ */
+bool decodeWeatherData(const uint8_t* data, size_t size, WeatherData& weather);
+
+/**
+ * @brief CRC-32 of an encoded record with its three fetch timestamps skipped.
+ *
+ * Two records that differ only in when they were fetched hash the same, so
+ * callers can detect real content changes from the bytes they already encoded.
+ * @param crc Running CRC to continue (0 to start).
+ * @param data Record produced by encodeWeatherData().
+ * @param size Encoded length.
+ */
+uint32_t weatherDataContentCrc(uint32_t crc, const uint8_t* data, size_t size);
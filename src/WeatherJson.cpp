@@ -0,0 +1,216 @@
+#include "WeatherJson.h"
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include "Crc32.h"
+#include "DeferredLog.h"
+#include "FixedPoint.h"
+#include "WeatherIcons.h"
+
+/**
+ * Rebuild the body and ETag when the generation moved; otherwise keep the cached bytes.
+ */
+bool WeatherJsonSnapshot::update(const WeatherData& weather, uint32_t generation, int32_t utcOffsetSeconds) {
+  if (hasBody_ && generation == generation_) {
+    return false;
+  }
+  const uint32_t startUs = micros();
+  length_ = 0;
+  overflow_ = false;
+  buffer_[0] = '\0';
+
+  char lat[16];
+  char lon[16];
+  formatScaled(weather.latMicrodeg, kFixedMicro, lat, sizeof(lat));
+  formatScaled(weather.lonMicrodeg, kFixedMicro, lon, sizeof(lon));
+  // The generation restarts at boot and moves without a content change, so it stays out of the body (and the ETag).
+  append("{\"fetchedAt\":%lu,\"utcOffset\":%ld,\"lat\":%s,\"lon\":%s,",
+         static_cast<unsigned long>(weather.fetchedAtEpoch), static_cast<long>(utcOffsetSeconds), lat, lon);
+
+  // Series carry type ids; this table turns them back into the labels the pages show.
+  append("\"types\":[");
+  for (uint8_t t = 0; t < static_cast<uint8_t>(WeatherType::Count); ++t) {
+    append(t == 0 ? "" : ",");
+    appendString(weatherTypeLabel(static_cast<WeatherType>(t)));
+  }
+  append("],");
+
+  append("\"current\":{\"tempF\":%d,\"feelsLikeF\":%d,\"type\":%u,\"rainPct\":%u,\"snowPct\":%u,"
+         "\"windMph\":%u,\"gustMph\":%u,\"windDeg\":%u},",
+         weather.temperatureF, weather.feelsLikeF, static_cast<unsigned>(weather.type), weather.rainChancePct,
+         weather.snowChancePct, weather.windMph, weather.gustMph, weather.windDeg);
+  append("\"today\":{\"highF\":%d,\"lowF\":%d,\"sunrise\":\"%02u:%02u\",\"sunset\":\"%02u:%02u\"},",
+         weather.todayHighF, weather.todayLowF, weather.sunriseHour, weather.sunriseMinute, weather.sunsetHour,
+         weather.sunsetMinute);
+
+  append("\"advisory\":");
+  appendString(weather.advisory);
+  append(",\"alerts\":[");
+  for (uint8_t i = 0; i < weather.alertCount && i < kMaxWeatherAlerts; ++i) {
+    append(i == 0 ? "{\"event\":" : ",{\"event\":");
+    appendString(weather.alerts[i].event);
+    append(",\"start\":%lu,\"end\":%lu}", static_cast<unsigned long>(weather.alerts[i].startEpoch),
+           static_cast<unsigned long>(weather.alerts[i].endEpoch));
+  }
+  append("],");
+  appendHourly(weather.forecast);
+  append(",");
+  appendDaily(weather.forecast);
+  append("}");
+
+  if (overflow_) {
+    // Never serve a cut-off document; clients get a small valid error instead.
+    length_ = static_cast<size_t>(snprintf(buffer_, sizeof(buffer_), "{\"error\":\"snapshot too large\"}"));
+    LOG_ERROR(JsonOverflow);
+  }
+
+  snprintf(etag_, sizeof(etag_), "\"%08lx\"", static_cast<unsigned long>(crc32Update(0, buffer_, length_)));
+  generation_ = generation;
+  hasBody_ = true;
+  ++serializations_;
+  lastSerializeUs_ = micros() - startUs;
+  LOG_INFO(JsonBuilt, generation, static_cast<uint32_t>(length_), lastSerializeUs_);
+  return true;
+}
+
+/**
+ * Hourly series as parallel arrays from a start epoch, one entry per hour.
+ */
+void WeatherJsonSnapshot::appendHourly(const ForecastStore& forecast) {
+  append("\"hourly\":{\"start\":%lu,\"stepSec\":3600,\"tempF\":[", static_cast<unsigned long>(forecast.hourlyStartEpoch));
+  for (uint8_t i = 0; i < forecast.hourlyCount; ++i) {
+    append(i == 0 ? "%d" : ",%d", forecast.hourlyTempF(i));
+  }
+  append("],\"popPct\":[");
+  for (uint8_t i = 0; i < forecast.hourlyCount; ++i) {
+    append(i == 0 ? "%u" : ",%u", forecast.hourlyPopPct[i]);
+  }
+  append("],\"type\":[");
+  for (uint8_t i = 0; i < forecast.hourlyCount; ++i) {
+    append(i == 0 ? "%u" : ",%u", static_cast<unsigned>(forecast.hourlyType(i)));
+  }
+  append("]}");
+}
+
+/**
+ * Daily series as parallel arrays from a start epoch, one entry per day.
+ */
+void WeatherJsonSnapshot::appendDaily(const ForecastStore& forecast) {
+  append("\"daily\":{\"start\":%lu,\"stepSec\":86400,\"highF\":[", static_cast<unsigned long>(forecast.dailyStartEpoch));
+  for (uint8_t i = 0; i < forecast.dailyCount; ++i) {
+    append(i == 0 ? "%d" : ",%d", forecast.dailyHighF(i));
+  }
+  append("],\"lowF\":[");
+  for (uint8_t i = 0; i < forecast.dailyCount; ++i) {
+    append(i == 0 ? "%d" : ",%d", forecast.dailyLowF(i));
+  }
+  append("],\"popPct\":[");
+  for (uint8_t i = 0; i < forecast.dailyCount; ++i) {
+    append(i == 0 ? "%u" : ",%u", forecast.dailyPopPct[i]);
+  }
+  append("],\"type\":[");
+  for (uint8_t i = 0; i < forecast.dailyCount; ++i) {
+    append(i == 0 ? "%u" : ",%u", static_cast<unsigned>(forecast.dailyType(i)));
+  }
+  append("]}");
+}
+
+/**
+ * Append formatted text; once anything fails to fit the body is marked overflowed.
+ */
+void WeatherJsonSnapshot::append(const char* format, ...) {
+  if (overflow_) {
+    return;
+  }
+  va_list args;
+  va_start(args, format);
+  const int written = vsnprintf(buffer_ + length_, sizeof(buffer_) - length_, format, args);
+  va_end(args);
+  if (written < 0 || static_cast<size_t>(written) >= sizeof(buffer_) - length_) {
+    overflow_ = true;
+    return;
+  }
+  length_ += static_cast<size_t>(written);
+}
+
+/**
+ * Append a quoted JSON string, escaping quotes and backslashes and dropping control bytes.
+ */
+void WeatherJsonSnapshot::appendString(const char* text) {
+  append("\"");
+  for (const char* p = text; *p != '\0' && !overflow_; ++p) {
+    const char c = *p;
+    if (c == '"' || c == '\\') {
+      append("\\%c", c);
+    } else if (static_cast<unsigned char>(c) >= 0x20) {
+      append("%c", c);
+    }
+  }
+  append("\"");
+}
+
+/**
+ * Return the cached body.
+ */
+const char* WeatherJsonSnapshot::body() const {
+  return buffer_;
+}
+
+/**
+ * Return the cached body length.
+ */
+size_t WeatherJsonSnapshot::length() const {
+  return length_;
+}
+
+/**
+ * Return the quoted ETag.
+ */
+const char* WeatherJsonSnapshot::etag() const {
+  return etag_;
+}
+
+/**
+ * Compare each entity tag in an If-None-Match list, ignoring a weak "W/" prefix as RFC 9110 requires.
+ */
+bool WeatherJsonSnapshot::matches(const char* ifNoneMatch) const {
+  if (!hasBody_ || ifNoneMatch == nullptr) {
+    return false;
+  }
+  const size_t tagLength = strlen(etag_);
+  const char* p = ifNoneMatch;
+  while (*p != '\0') {
+    while (*p == ' ' || *p == ',') {
+      ++p;
+    }
+    if (*p == '*') {
+      return true;
+    }
+    if (p[0] == 'W' && p[1] == '/') {
+      p += 2;
+    }
+    if (strncmp(p, etag_, tagLength) == 0 && (p[tagLength] == '\0' || p[tagLength] == ',' || p[tagLength] == ' ')) {
+      return true;
+    }
+    while (*p != '\0' && *p != ',') {
+      ++p;
+    }
+  }
+  return false;
+}
+
+/**
+ * Return bodies built since boot.
+ */
+uint32_t WeatherJsonSnapshot::serializations() const {
+  return serializations_;
+}
+
+/**
+ * Return the last rebuild duration.
+ */
+uint32_t WeatherJsonSnapshot::lastSerializeMicros() const {
+  return lastSerializeUs_;
+}
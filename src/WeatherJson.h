@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "Models.h"
+
+/**
+ * @brief WeatherData serialized to JSON once per generation for the /weather.json endpoint.
+ *
+ * The body is formatted into a fixed buffer only when the caller's generation
+ * counter moves; every request in between is served from that buffer. The
+ * strong ETag is the CRC-32 of the body, which leaves the generation out, so
+ * identical data after a reboot or a no-op regeneration keeps the same tag and
+ * repeat polls can be answered with 304.
+ */
+class WeatherJsonSnapshot {
+ public:
+  /** @brief Body capacity; the largest forecast with four alerts stays well under it. */
+  static constexpr size_t kBufferSize = 2048;
+
+  /**
+   * @brief Re-serialize if generation differs from the cached body.
+   * @param weather Current model.
+   * @param generation Caller's generation counter for weather.
+   * @param utcOffsetSeconds Offset reported with the data.
+   * @return True if the body was rebuilt.
+   */
+  bool update(const WeatherData& weather, uint32_t generation, int32_t utcOffsetSeconds);
+
+  /**
+   * @brief Serialized body (NUL-terminated).
+   */
+  const char* body() const;
+
+  /**
+   * @brief Body length in bytes.
+   */
+  size_t length() const;
+
+  /**
+   * @brief Quoted strong ETag for the current body.
+   */
+  const char* etag() const;
+
+  /**
+   * @brief True if an If-None-Match header value names the current ETag (or is "*").
+   */
+  bool matches(const char* ifNoneMatch) const;
+
+  /**
+   * @brief Bodies built since boot.
+   */
+  uint32_t serializations() const;
+
+  /**
+   * @brief Microseconds the last rebuild took.
+   */
+  uint32_t lastSerializeMicros() const;
+
+ private:
+  void append(const char* format, ...) __attribute__((format(printf, 2, 3)));
+  void appendString(const char* text);
+  void appendHourly(const ForecastStore& forecast);
+  void appendDaily(const ForecastStore& forecast);
+
+  char buffer_[kBufferSize] = {};
+  size_t length_ = 0;
+  bool overflow_ = false;
+  bool hasBody_ = false;
+  uint32_t generation_ = 0;
+  char etag_[11] = {};
+  uint32_t serializations_ = 0;
+  uint32_t lastSerializeUs_ = 0;
+};
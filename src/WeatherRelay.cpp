@@ -0,0 +1,308 @@
+#include "WeatherRelay.h"
+
+#include <Arduino.h>
+#include <string.h>
+#if defined(ARDUINO_ARCH_ESP8266)
+#include <ESP8266WiFi.h>
+#else
+#include <WiFi.h>
+#include <esp_system.h>
+#endif
+#include "Crc32.h"
+
+namespace {
+const uint8_t kDataMagic[4] = {'W', 'C', 'R', '1'};
+const uint8_t kRequestMagic[4] = {'W', 'C', 'R', 'Q'};
+constexpr uint8_t kPacketVersion = 1;
+constexpr size_t kRequestSize = 8;
+constexpr size_t kCrcOffset = 24;
+
+void putU32(uint8_t* out, uint32_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+  out[2] = static_cast<uint8_t>(value >> 16);
+  out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t getU32(const uint8_t* in) {
+  return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+         (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+// Administratively scoped group; routers do not forward it off the LAN.
+IPAddress relayGroup() {
+  return IPAddress(239, 255, 77, 67);
+}
+
+uint32_t hardwareRandom() {
+#if defined(ARDUINO_ARCH_ESP8266)
+  return RANDOM_REG32;
+#else
+  return esp_random();
+#endif
+}
+
+const char* roleLabel(RelayRole role) {
+  switch (role) {
+    case RelayRole::Leader:
+      return "leader";
+    case RelayRole::Follower:
+      return "follower";
+    case RelayRole::Off:
+      break;
+  }
+  return "off";
+}
+}  // namespace
+
+/**
+ * Pick a per-boot session id and join the group.
+ */
+void WeatherRelay::begin(RelayRole role, uint16_t deviceId) {
+  role_ = role;
+  if (role_ == RelayRole::Off) {
+    return;
+  }
+  // The random half makes a rebooted leader a new session, so its restarted generation is not mistaken for old data.
+  sessionId_ = (static_cast<uint32_t>(deviceId) << 16) | (hardwareRandom() & 0xFFFFU);
+  joinGroup();
+  Serial.print("[RELAY] Role=");
+  Serial.print(roleLabel(role_));
+  Serial.print(" session=");
+  Serial.println(sessionId_, HEX);
+}
+
+/**
+ * Subscribe to the relay group on the station interface.
+ */
+void WeatherRelay::joinGroup() {
+#if defined(ARDUINO_ARCH_ESP8266)
+  udp_.beginMulticast(WiFi.localIP(), relayGroup(), kPort);
+#else
+  udp_.beginMulticast(relayGroup(), kPort);
+#endif
+}
+
+/**
+ * Return the configured role.
+ */
+RelayRole WeatherRelay::role() const {
+  return role_;
+}
+
+/**
+ * Send one datagram to the group.
+ */
+void WeatherRelay::send(const uint8_t* data, size_t length) {
+#if defined(ARDUINO_ARCH_ESP8266)
+  udp_.beginPacketMulticast(relayGroup(), kPort, WiFi.localIP());
+#else
+  udp_.beginPacket(relayGroup(), kPort);
+#endif
+  udp_.write(data, length);
+  udp_.endPacket();
+}
+
+/**
+ * Encode and multicast only on a new generation, a follower request or a due heartbeat.
+ */
+bool WeatherRelay::publish(const WeatherData& weather, uint32_t generation, int32_t utcOffsetSeconds,
+                           uint32_t utcNow, unsigned long nowMs) {
+  if (role_ != RelayRole::Leader || !weather.valid) {
+    return false;
+  }
+  const bool changed = !hasSent_ || generation != lastSentGeneration_;
+  if (!changed && !sendRequested_ && nowMs - lastSentMs_ < kHeartbeatMs) {
+    return false;
+  }
+
+  const RelayPacketInfo info = {sessionId_, generation, utcNow, utcOffsetSeconds};
+  const size_t length = encodePacket(weather, info, packet_, sizeof(packet_));
+  if (length == 0) {
+    Serial.println("[RELAY] Encode failed");
+    return false;
+  }
+  send(packet_, length);
+  hasSent_ = true;
+  sendRequested_ = false;
+  lastSentGeneration_ = generation;
+  lastSentMs_ = nowMs;
+  ++sent_;
+  if (changed) {
+    Serial.print("[RELAY] Sent generation=");
+    Serial.print(generation);
+    Serial.print(" bytes=");
+    Serial.println(static_cast<unsigned>(length));
+  }
+  return true;
+}
+
+/**
+ * Drain a few datagrams: requests for the leader, data for followers.
+ */
+bool WeatherRelay::poll(WeatherData& weather, int32_t& utcOffsetSeconds, unsigned long nowMs, uint32_t utcNow) {
+  if (role_ == RelayRole::Off) {
+    return false;
+  }
+  bool replaced = false;
+  for (uint8_t i = 0; i < kMaxPacketsPerPoll; ++i) {
+    const int size = udp_.parsePacket();
+    if (size <= 0) {
+      break;
+    }
+    if (static_cast<size_t>(size) > sizeof(packet_)) {
+      ++rejected_;
+      udp_.flush();
+      continue;
+    }
+    const int got = udp_.read(packet_, sizeof(packet_));
+    if (got <= 0) {
+      continue;
+    }
+    const size_t length = static_cast<size_t>(got);
+
+    if (length == kRequestSize && memcmp(packet_, kRequestMagic, sizeof(kRequestMagic)) == 0) {
+      if (role_ == RelayRole::Leader && getU32(packet_ + 4) != sessionId_) {
+        // A follower just booted without data; answer instead of waiting for the heartbeat.
+        sendRequested_ = true;
+      }
+      continue;
+    }
+    if (role_ != RelayRole::Follower) {
+      continue;
+    }
+
+    RelayPacketInfo info{};
+    // Peek at the header first so heartbeats of a known generation skip the decode.
+    if (length >= kHeaderSize && memcmp(packet_, kDataMagic, sizeof(kDataMagic)) == 0 && hasLeader_ &&
+        getU32(packet_ + 8) == leaderSession_ && getU32(packet_ + 12) == leaderGeneration_) {
+      lastHeardMs_ = nowMs;
+      continue;
+    }
+    // Decode aside: only an accepted packet may replace what the caller is showing.
+    WeatherData decoded{};
+    if (!decodePacket(packet_, length, info, decoded)) {
+      ++rejected_;
+      Serial.print("[RELAY] Rejected packet bytes=");
+      Serial.println(static_cast<unsigned>(length));
+      continue;
+    }
+    if (utcNow != 0 && info.sentAtEpoch != 0 && utcNow > info.sentAtEpoch + kMaxPacketAgeSec) {
+      // Both clocks are set and the packet is far behind: replayed or badly delayed.
+      ++rejected_;
+      Serial.print("[RELAY] Rejected stale packet age=");
+      Serial.println(static_cast<unsigned long>(utcNow - info.sentAtEpoch));
+      continue;
+    }
+    weather = decoded;
+    hasLeader_ = true;
+    leaderSession_ = info.sessionId;
+    leaderGeneration_ = info.generation;
+    lastHeardMs_ = nowMs;
+    utcOffsetSeconds = info.utcOffsetSeconds;
+    replaced = true;
+    ++accepted_;
+    Serial.print("[RELAY] Received generation=");
+    Serial.print(info.generation);
+    Serial.print(" from session=");
+    Serial.print(info.sessionId, HEX);
+    Serial.print(" bytes=");
+    Serial.println(static_cast<unsigned>(length));
+  }
+  return replaced;
+}
+
+/**
+ * Multicast a request so the leader sends its current data immediately.
+ */
+void WeatherRelay::requestLatest() {
+  if (role_ != RelayRole::Follower) {
+    return;
+  }
+  uint8_t request[kRequestSize];
+  memcpy(request, kRequestMagic, sizeof(kRequestMagic));
+  putU32(request + 4, sessionId_);
+  send(request, sizeof(request));
+}
+
+/**
+ * Return whether the leader has been heard recently enough to rely on.
+ */
+bool WeatherRelay::leaderActive(unsigned long nowMs) const {
+  return role_ == RelayRole::Follower && hasLeader_ && nowMs - lastHeardMs_ < kLeaderTimeoutMs;
+}
+
+/**
+ * Return data packets sent.
+ */
+uint32_t WeatherRelay::packetsSent() const {
+  return sent_;
+}
+
+/**
+ * Return data packets accepted.
+ */
+uint32_t WeatherRelay::packetsAccepted() const {
+  return accepted_;
+}
+
+/**
+ * Return packets rejected.
+ */
+uint32_t WeatherRelay::packetsRejected() const {
+  return rejected_;
+}
+
+/**
+ * Header: magic(4) packetVersion(1) codecVersion(1) payloadLen(2) session(4)
+ * generation(4) sentAt(4) utcOffset(4) crc(4), then the WeatherCodec payload.
+ * The CRC covers the first 24 header bytes and the payload.
+ */
+size_t WeatherRelay::encodePacket(const WeatherData& weather, const RelayPacketInfo& info, uint8_t* out,
+                                  size_t outSize) {
+  if (outSize < kHeaderSize) {
+    return 0;
+  }
+  uint8_t* payload = out + kHeaderSize;
+  const size_t payloadSize = encodeWeatherData(weather, payload, outSize - kHeaderSize);
+  if (payloadSize == 0) {
+    return 0;
+  }
+  memcpy(out, kDataMagic, sizeof(kDataMagic));
+  out[4] = kPacketVersion;
+  out[5] = kWeatherCodecVersion;
+  out[6] = static_cast<uint8_t>(payloadSize);
+  out[7] = static_cast<uint8_t>(payloadSize >> 8);
+  putU32(out + 8, info.sessionId);
+  putU32(out + 12, info.generation);
+  putU32(out + 16, info.sentAtEpoch);
+  putU32(out + 20, static_cast<uint32_t>(info.utcOffsetSeconds));
+  putU32(out + kCrcOffset, crc32Update(crc32Update(0, out, kCrcOffset), payload, payloadSize));
+  return kHeaderSize + payloadSize;
+}
+
+/**
+ * Check framing and CRC before handing the payload to the codec.
+ */
+bool WeatherRelay::decodePacket(const uint8_t* data, size_t size, RelayPacketInfo& info, WeatherData& weather) {
+  if (size < kHeaderSize || memcmp(data, kDataMagic, sizeof(kDataMagic)) != 0 || data[4] != kPacketVersion ||
+      data[5] != kWeatherCodecVersion) {
+    return false;
+  }
+  const size_t payloadSize = static_cast<size_t>(data[6] | (data[7] << 8));
+  if (size != kHeaderSize + payloadSize) {
+    return false;
+  }
+  const uint8_t* payload = data + kHeaderSize;
+  if (getU32(data + kCrcOffset) != crc32Update(crc32Update(0, data, kCrcOffset), payload, payloadSize)) {
+    return false;
+  }
+  if (!decodeWeatherData(payload, payloadSize, weather)) {
+    return false;
+  }
+  info.sessionId = getU32(data + 8);
+  info.generation = getU32(data + 12);
+  info.sentAtEpoch = getU32(data + 16);
+  info.utcOffsetSeconds = static_cast<int32_t>(getU32(data + 20));
+  return true;
+}
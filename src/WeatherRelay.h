@@ -0,0 +1,141 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <WiFiUdp.h>
+#include "Models.h"
+#include "WeatherCodec.h"
+
+/**
+ * @brief Part a clock plays in the LAN relay.
+ */
+enum class RelayRole : uint8_t {
+  Off,
+  Leader,
+  Follower
+};
+
+/**
+ * @brief Metadata carried in every relay data packet next to the encoded WeatherData.
+ */
+struct RelayPacketInfo {
+  /** @brief Sender's MAC suffix (high 16 bits) plus a per-boot random (low 16 bits). */
+  uint32_t sessionId;
+  /** @brief Leader's weather generation; changes whenever its WeatherData changes. */
+  uint32_t generation;
+  /** @brief Leader's UTC time when the packet was sent (0 if its clock was not set). */
+  uint32_t sentAtEpoch;
+  /** @brief Timezone offset the leader applies to this location. */
+  int32_t utcOffsetSeconds;
+};
+
+/**
+ * @brief Shares one clock's parsed WeatherData with the other clocks on the LAN over UDP multicast.
+ *
+ * The leader multicasts the packed record (WeatherCodec layout, CRC-32
+ * protected) whenever its generation changes and repeats it as a heartbeat.
+ * Followers decode new generations into their own model and leave
+ * OpenWeather alone while the leader keeps being heard; when it goes quiet
+ * they fall back to fetching. A follower that boots without data sends a
+ * request packet and the leader answers at once.
+ */
+class WeatherRelay {
+ public:
+  /** @brief Data packet header: magic, versions, length, session, generation, time, offset, CRC. */
+  static constexpr size_t kHeaderSize = 28;
+  /** @brief Largest packet: header plus the largest encoded WeatherData. */
+  static constexpr size_t kMaxPacketSize = kHeaderSize + kWeatherDataMaxEncodedSize;
+
+  /**
+   * @brief Join the multicast group; call once WiFi is connected.
+   * @param role Leader or Follower; Off leaves the relay idle.
+   * @param deviceId Stable per-device id (MAC suffix).
+   */
+  void begin(RelayRole role, uint16_t deviceId);
+
+  /**
+   * @brief Configured role (Off until begin()).
+   */
+  RelayRole role() const;
+
+  /**
+   * @brief Leader: send when the generation changed, a follower asked, or the heartbeat is due.
+   * @param weather Current model.
+   * @param generation Caller's generation counter for weather.
+   * @param utcOffsetSeconds Offset followers should apply.
+   * @param utcNow Current UTC (0 if unknown).
+   * @param nowMs Current millis().
+   * @return True if a packet was sent.
+   */
+  bool publish(const WeatherData& weather, uint32_t generation, int32_t utcOffsetSeconds, uint32_t utcNow,
+               unsigned long nowMs);
+
+  /**
+   * @brief Read pending packets: followers decode new generations, leaders note requests.
+   * @param weather Output model, written only when a new generation decodes cleanly and is not stale.
+   * @param utcOffsetSeconds Output offset from the same packet.
+   * @param nowMs Current millis().
+   * @param utcNow Current UTC (0 if unknown), used to reject stale packets.
+   * @return True if weather was replaced.
+   */
+  bool poll(WeatherData& weather, int32_t& utcOffsetSeconds, unsigned long nowMs, uint32_t utcNow);
+
+  /**
+   * @brief Follower: ask the leader to send its current data now.
+   */
+  void requestLatest();
+
+  /**
+   * @brief Follower: a leader packet arrived within the timeout.
+   */
+  bool leaderActive(unsigned long nowMs) const;
+
+  /** @brief Data packets sent (leader). */
+  uint32_t packetsSent() const;
+  /** @brief Data packets decoded into a new generation (follower). */
+  uint32_t packetsAccepted() const;
+  /** @brief Packets dropped for size, magic, version, CRC or age. */
+  uint32_t packetsRejected() const;
+
+  /**
+   * @brief Frame a data packet.
+   * @return Packet length, or 0 if weather does not encode into outSize.
+   */
+  static size_t encodePacket(const WeatherData& weather, const RelayPacketInfo& info, uint8_t* out, size_t outSize);
+
+  /**
+   * @brief Validate a data packet and decode it.
+   * @param weather Output model, written only on success.
+   * @return True if magic, versions, length and CRC all matched and the payload decoded.
+   */
+  static bool decodePacket(const uint8_t* data, size_t size, RelayPacketInfo& info, WeatherData& weather);
+
+ private:
+  static constexpr unsigned long kHeartbeatMs = 5UL * 60UL * 1000UL;
+  // Three missed heartbeats, then followers fetch for themselves.
+  static constexpr unsigned long kLeaderTimeoutMs = 3 * kHeartbeatMs + 60UL * 1000UL;
+  static constexpr uint32_t kMaxPacketAgeSec = 15UL * 60UL;
+  static constexpr uint16_t kPort = 47767;
+  static constexpr uint8_t kMaxPacketsPerPoll = 4;
+
+  void joinGroup();
+  void send(const uint8_t* data, size_t length);
+
+  WiFiUDP udp_;
+  RelayRole role_ = RelayRole::Off;
+  uint32_t sessionId_ = 0;
+  // Leader state.
+  bool hasSent_ = false;
+  bool sendRequested_ = false;
+  uint32_t lastSentGeneration_ = 0;
+  unsigned long lastSentMs_ = 0;
+  // Follower state.
+  bool hasLeader_ = false;
+  uint32_t leaderSession_ = 0;
+  uint32_t leaderGeneration_ = 0;
+  unsigned long lastHeardMs_ = 0;
+  uint8_t packet_[kMaxPacketSize];
+  uint32_t sent_ = 0;
+  uint32_t accepted_ = 0;
+  uint32_t rejected_ = 0;
+};
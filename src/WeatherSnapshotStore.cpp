@@ -0,0 +1,156 @@
+#include "WeatherSnapshotStore.h"
+
+#include <Arduino.h>
+#include <LittleFS.h>
+#include <string.h>
+#include "Crc32.h"
+#include "DeferredLog.h"
+#include "WeatherCodec.h"
+
+namespace {
+void putU32(uint8_t* out, uint32_t value) {
+  out[0] = static_cast<uint8_t>(value);
+  out[1] = static_cast<uint8_t>(value >> 8);
+  out[2] = static_cast<uint8_t>(value >> 16);
+  out[3] = static_cast<uint8_t>(value >> 24);
+}
+
+uint32_t getU32(const uint8_t* in) {
+  return static_cast<uint32_t>(in[0]) | (static_cast<uint32_t>(in[1]) << 8) |
+         (static_cast<uint32_t>(in[2]) << 16) | (static_cast<uint32_t>(in[3]) << 24);
+}
+
+// Change detection ignores fetch times so identical forecasts never rewrite flash.
+// Works on the already-encoded payload; no second WeatherData or buffer on the stack.
+uint32_t contentCrc(const uint8_t* payload, size_t payloadSize, int32_t utcOffsetSeconds) {
+  uint8_t offsetRaw[4];
+  putU32(offsetRaw, static_cast<uint32_t>(utcOffsetSeconds));
+  const uint32_t crc = crc32Update(0, offsetRaw, sizeof(offsetRaw));
+  return weatherDataContentCrc(crc, payload, payloadSize);
+}
+}  // namespace
+
+/**
+ * Ensure LittleFS is mounted once before file operations.
+ */
+bool WeatherSnapshotStore::ensureFsMounted() {
+  if (fsMounted_) {
+    return true;
+  }
+  fsMounted_ = LittleFS.begin(true);
+  if (!fsMounted_) {
+    LOG_ERROR(SnapMountFailed);
+  }
+  return fsMounted_;
+}
+
+/**
+ * Read and validate header, CRC and codec version in a single file read.
+ */
+bool WeatherSnapshotStore::load(WeatherData& weather, int32_t& utcOffsetSeconds) {
+  if (!ensureFsMounted() || !LittleFS.exists(kSnapshotFile)) {
+    return false;
+  }
+
+  File file = LittleFS.open(kSnapshotFile, "r");
+  if (!file) {
+    return false;
+  }
+  uint8_t record[kHeaderSize + kMetaSize + kWeatherDataMaxEncodedSize];
+  const size_t got = file.read(record, sizeof(record));
+  file.close();
+
+  // Header: magic(4) format(1) codec(1) payloadLen(2) crc(4).
+  if (got < kHeaderSize + kMetaSize || getU32(record) != kMagic || record[4] != kFormatVersion ||
+      record[5] != kWeatherCodecVersion) {
+    LOG_WARN(SnapVersionMismatch);
+    return false;
+  }
+  const size_t payloadSize = static_cast<size_t>(record[6] | (record[7] << 8));
+  if (got != kHeaderSize + kMetaSize + payloadSize) {
+    LOG_WARN(SnapLengthMismatch);
+    return false;
+  }
+  const uint32_t storedCrc = getU32(record + 8);
+  const uint32_t actualCrc = crc32Update(0, record + kHeaderSize, kMetaSize + payloadSize);
+  if (storedCrc != actualCrc) {
+    LOG_WARN(SnapCrcMismatch);
+    return false;
+  }
+
+  const uint8_t* payload = record + kHeaderSize + kMetaSize;
+  const int32_t offset = static_cast<int32_t>(getU32(record + kHeaderSize));
+  if (!decodeWeatherData(payload, payloadSize, weather)) {
+    LOG_WARN(SnapDecodeFailed);
+    return false;
+  }
+  utcOffsetSeconds = offset;
+  lastContentCrc_ = contentCrc(payload, payloadSize, offset);
+  hasContentCrc_ = true;
+
+  LOG_INFO(SnapLoaded, static_cast<uint32_t>(got), weather.fetchedAtEpoch);
+  return true;
+}
+
+/**
+ * Encode, compare against the last persisted contents, and write when allowed.
+ */
+bool WeatherSnapshotStore::save(const WeatherData& weather, int32_t utcOffsetSeconds) {
+  uint8_t record[kHeaderSize + kMetaSize + kWeatherDataMaxEncodedSize];
+  uint8_t* payload = record + kHeaderSize + kMetaSize;
+  const size_t payloadSize = encodeWeatherData(weather, payload, kWeatherDataMaxEncodedSize);
+  if (payloadSize == 0) {
+    LOG_ERROR(SnapEncodeFailed);
+    return false;
+  }
+
+  const uint32_t newContentCrc = contentCrc(payload, payloadSize, utcOffsetSeconds);
+  if (hasContentCrc_ && newContentCrc == lastContentCrc_) {
+    LOG_DEBUG(SnapUnchanged);
+    return false;
+  }
+  const unsigned long now = millis();
+  if (hasWritten_ && now - lastWriteMs_ < kMinWriteIntervalMs) {
+    LOG_INFO(SnapRateLimited);
+    return false;
+  }
+  if (!ensureFsMounted()) {
+    return false;
+  }
+
+  putU32(record, kMagic);
+  record[4] = kFormatVersion;
+  record[5] = kWeatherCodecVersion;
+  record[6] = static_cast<uint8_t>(payloadSize);
+  record[7] = static_cast<uint8_t>(payloadSize >> 8);
+  putU32(record + kHeaderSize, static_cast<uint32_t>(utcOffsetSeconds));
+  putU32(record + 8, crc32Update(0, record + kHeaderSize, kMetaSize + payloadSize));
+
+  File file = LittleFS.open(kSnapshotFile, "w");
+  if (!file) {
+    LOG_ERROR(SnapOpenFailed);
+    return false;
+  }
+  const size_t recordSize = kHeaderSize + kMetaSize + payloadSize;
+  const size_t written = file.write(record, recordSize);
+  file.close();
+  if (written != recordSize) {
+    LOG_ERROR(SnapWriteShort);
+    return false;
+  }
+
+  lastContentCrc_ = newContentCrc;
+  hasContentCrc_ = true;
+  hasWritten_ = true;
+  lastWriteMs_ = now;
+  ++writeCount_;
+  LOG_INFO(SnapWritten, static_cast<uint32_t>(recordSize), writeCount_);
+  return true;
+}
+
+/**
+ * Return number of snapshot writes since boot.
+ */
+uint32_t WeatherSnapshotStore::writeCount() const {
+  return writeCount_;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <stdint.h>
+#include "Models.h"
+
+/**
+ * @brief Persists the last good WeatherData as a versioned, CRC-protected binary record.
+ *
+ * Lets setup() draw real weather immediately after a reboot. Writes are skipped
+ * when contents are unchanged and rate-limited to protect flash wear.
+ */
+class WeatherSnapshotStore {
+ public:
+  /**
+   * @brief Load the persisted snapshot.
+   * @param weather Output model, written only if the record is intact.
+   * @param utcOffsetSeconds Output timezone offset stored with the snapshot.
+   * @return True if a valid snapshot for the current layout was loaded.
+   */
+  bool load(WeatherData& weather, int32_t& utcOffsetSeconds);
+
+  /**
+   * @brief Persist a snapshot if contents changed and the write interval allows it.
+   * @param weather Freshly parsed model.
+   * @param utcOffsetSeconds Timezone offset from the same payload.
+   * @return True if the record was written to flash.
+   */
+  bool save(const WeatherData& weather, int32_t utcOffsetSeconds);
+
+  /**
+   * @brief Number of flash writes performed since boot.
+   */
+  uint32_t writeCount() const;
+
+ private:
+  static constexpr const char* kSnapshotFile = "/weather.bin";
+  static constexpr uint32_t kMagic = 0x31534357UL;  // "WCS1" little-endian.
+  static constexpr uint8_t kFormatVersion = 2;
+  static constexpr unsigned long kMinWriteIntervalMs = 2UL * 60UL * 60UL * 1000UL;
+  static constexpr size_t kHeaderSize = 12;
+  static constexpr size_t kMetaSize = 4;
+
+  /**
+   * @brief Ensure LittleFS is mounted.
+   * @return True if filesystem is mounted and ready.
+   */
+  bool ensureFsMounted();
+
+  bool fsMounted_ = false;
+  bool hasContentCrc_ = false;
+  uint32_t lastContentCrc_ = 0;
+  bool hasWritten_ = false;
+  unsigned long lastWriteMs_ = 0;
+  uint32_t writeCount_ = 0;
+};
@@ -1,5 +1,6 @@
 #include <Arduino.h>
 #include <string.h>
+#include <time.h>
 #include <Wire.h>
 #if defined(ARDUINO_ARCH_ESP8266)
 #include <ESP8266WiFi.h>
@@ -10,10 +11,26 @@
 #endif
 #include <WiFiManager.h>
 #include <Adafruit_SSD1306.h>
+#include "BootProfiler.h"
+#include "ButtonService.h"
+#include "DeferredLog.h"
 #include "DisplayService.h"
+#include "FixedPoint.h"
+#include "HeapMonitor.h"
+#include "Metrics.h"
 #include "OpenWeatherConfigService.h"
+#include "ObservationHistory.h"
 #include "OpenWeatherService.h"
+#include "ScreenMirror.h"
+#include "SyncPlanner.h"
+#include "TemperatureInterpolator.h"
 #include "TimeService.h"
+#include "Trace.h"
+#include "WeatherAlerts.h"
+#include "WeatherCache.h"
+#include "WeatherJson.h"
+#include "WeatherRelay.h"
+#include "WeatherSnapshotStore.h"
 
 namespace {
 // Display geometry, GPIO, and UI timing constants used by the app.
@@ -27,19 +44,71 @@ constexpr uint8_t RESET_BUTTON_PIN = D5;
 constexpr uint8_t RESET_BUTTON_PIN = 5;
 #endif
 constexpr unsigned long RESET_HOLD_WINDOW_MS = 5000;
-constexpr uint8_t TOTAL_PAGES = 6;  // 0=Home, 1..5 detail pages
+constexpr uint8_t TOTAL_PAGES = 9;  // 0=Home, 1..7 detail pages, 8=Diag
 constexpr unsigned long PAGE_AUTO_RETURN_MS = 10000;
-constexpr unsigned long PAGE_BUTTON_DEBOUNCE_MS = 35;
+// Floor between retry syncs; the per-service RetryPolicy decides the actual backoff.
+constexpr unsigned long RETRY_SYNC_MIN_SPACING_MS = 60000;
+// Stale data with no recorded failure is revalidated this often, within the planner's spare budget.
+constexpr unsigned long STALE_REVALIDATE_INTERVAL_MS = 10UL * 60UL * 1000UL;
+// Per-device share of the OpenWeather key's daily call budget; override via build flags.
+#ifndef WEATHERCLOCK_DAILY_CALL_QUOTA
+#define WEATHERCLOCK_DAILY_CALL_QUOTA 200
+#endif
+// LAN relay role: 0 = off, 1 = leader (fetches and multicasts), 2 = follower (listens, fetches only as fallback).
+#ifndef WEATHERCLOCK_RELAY_ROLE
+#define WEATHERCLOCK_RELAY_ROLE 0
+#endif
+// How long a booting follower waits for the leader to answer before fetching itself.
+constexpr unsigned long RELAY_BOOT_WAIT_MS = 1500;
+// Bench builds (-D WEATHERCLOCK_BENCH=1) log parser, calendar and footprint measurements at boot.
+// Off by default so production firmware does not link the soft-float reference paths.
+#ifndef WEATHERCLOCK_BENCH
+#define WEATHERCLOCK_BENCH 0
+#endif
+// Bench-only fragmentation soak: repeat this many refreshes after the boot sync (0 = off).
+#ifndef WEATHERCLOCK_SYNC_SOAK
+#define WEATHERCLOCK_SYNC_SOAK 0
+#endif
+constexpr SyncPlanner::Config SYNC_PLANNER_CONFIG = {
+    WEATHERCLOCK_DAILY_CALL_QUOTA,  // dailyCallQuota
+    60UL * 60UL,                    // baseIntervalSec
+    30UL * 60UL,                    // volatileIntervalSec
+    120UL * 60UL};                  // stableIntervalSec
+// Alerts use a tiny exclude-everything-else request on their own cadence.
+constexpr unsigned long ALERTS_REFRESH_INTERVAL_MS = 30UL * 60UL * 1000UL;
+// Minutely nowcast is only fetched while rain is plausible within the next hour.
+constexpr uint8_t NOWCAST_POP_THRESHOLD_PCT = 30;
+constexpr unsigned long NOWCAST_REFRESH_INTERVAL_MS = 10UL * 60UL * 1000UL;
+// Deferred log records printed per idle loop pass.
+constexpr uint8_t LOG_DRAIN_PER_LOOP = 4;
 // WiFiManager menu order: include weather params page.
 const char* WIFI_MENU_WITH_SETTINGS[] = {"wifi", "param", "info", "exit"};
 
 // Core services and shared runtime state.
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RESET);
 DisplayService displayService(display);
+// Streams flushed frames to /screen viewers; idle unless a browser is connected.
+ScreenMirror screenMirror;
+ButtonService buttonService(RESET_BUTTON_PIN);
 TimeService timeService;
 OpenWeatherConfigService openWeatherConfigService;
 OpenWeatherService openWeatherService(openWeatherConfigService);
+WeatherSnapshotStore weatherSnapshotStore;
+ObservationHistory observationHistory;
+TemperatureInterpolator temperatureInterpolator;
+WeatherCache weatherCache;
+SyncPlanner syncPlanner(SYNC_PLANNER_CONFIG);
 WiFiManager wifiManager;
+BootProfiler bootProfiler;
+HeapMonitor heapMonitor;
+Metrics metrics;
+WeatherRelay weatherRelay;
+// /weather.json body, rebuilt only when weatherGeneration moves.
+WeatherJsonSnapshot weatherJson;
+uint32_t weatherJsonNotModified = 0;
+// Bumped whenever currentWeather changes; the relay sends each generation once plus heartbeats.
+uint32_t weatherGeneration = 0;
+uint32_t plannerCallsAccounted = 0;
 String deviceName;
 String portalSsid;
 bool networkBusy = false;
@@ -51,17 +120,25 @@ DisplayService* configPortalDisplay = nullptr;
 // App data models with sensible placeholder defaults until first sync.
 ClockData clockData{};
 WeatherData currentWeather{};
+NowcastData nowcast{};
+WeatherFreshness currentFreshness = WeatherFreshness::Expired;
 
-String buildDeviceName() {
-  // Use last 2 MAC bytes for a short unique suffix.
+uint16_t deviceMacSuffix() {
+  // Last 2 MAC bytes: unique enough per building, stable across reboots.
   uint8_t mac[6];
   WiFi.macAddress(mac);
+  return static_cast<uint16_t>((mac[4] << 8) | mac[5]);
+}
+
+String buildDeviceName() {
+  // Use last 2 MAC bytes for a short unique suffix.
   char suffix[5];
-  snprintf(suffix, sizeof(suffix), "%02X%02X", mac[4], mac[5]);
+  snprintf(suffix, sizeof(suffix), "%04X", deviceMacSuffix());
   return String("Wethr-") + suffix;
 }
 
 bool performHourlySync();
+void onWeatherRefreshed();
 void showSyncStatus(const char* title, const String& line1, const String& line2, const String& line3);
 
 void onParamsSaved() {
@@ -90,10 +167,15 @@ void clearSavedAppSettings() {
   openWeatherConfigService.clearSaved();
 }
 
-bool shouldEnterFactoryResetFromButton() {
-  // Hold reset button during boot countdown to wipe credentials/settings.
+bool isButtonHeldAtPowerOn() {
+  // Single sample after the pull-up settles; normal boots never wait on the button.
   pinMode(RESET_BUTTON_PIN, INPUT_PULLUP);
+  delay(5);
+  return digitalRead(RESET_BUTTON_PIN) == LOW;
+}
 
+bool shouldEnterFactoryResetFromButton() {
+  // Button was held at power-on: it must stay held through the countdown to wipe settings.
   const unsigned long start = millis();
   int lastShownSeconds = -1;
   // Show live countdown during the reset hold window.
@@ -108,90 +190,365 @@ bool shouldEnterFactoryResetFromButton() {
       Serial.println(" sec remaining");
       displayService.drawStatusScreen(
           "Boot Options",
-          "Push button for reset",
-          "",
+          "Keep holding for reset",
+          "Release to cancel",
           countdownText);
     }
 
-    if (digitalRead(RESET_BUTTON_PIN) == LOW) {
-      // Small debounce before confirming the press.
+    if (digitalRead(RESET_BUTTON_PIN) == HIGH) {
+      // Small debounce before treating it as a release.
       delay(30);
-      if (digitalRead(RESET_BUTTON_PIN) == LOW) {
-        return true;
+      if (digitalRead(RESET_BUTTON_PIN) == HIGH) {
+        Serial.println("[BOOT] Button released, reset cancelled");
+        return false;
       }
     }
     delay(20);
   }
+  return true;
+}
+
+bool loadWeatherSnapshot() {
+  // Restore last good weather so the first frame shows real data instead of placeholders.
+  int32_t offset = 0;
+  if (!weatherSnapshotStore.load(currentWeather, offset)) {
+    return false;
+  }
+  ++weatherGeneration;
+  timeService.setUtcOffsetSeconds(offset);
+  displayService.setUtcOffsetSeconds(offset);
+  if (currentWeather.valid) {
+    // Sun times are recomputed from the stored location once NTP has set the clock.
+    timeService.setLocation(currentWeather.latMicrodeg, currentWeather.lonMicrodeg);
+  }
+  if (currentWeather.valid && currentWeather.fetchedAtEpoch != 0) {
+    // Anchor the blend at the snapshot's observation; it catches up once NTP sets the clock.
+    temperatureInterpolator.observe(currentWeather, currentWeather.fetchedAtEpoch);
+  }
+  return currentWeather.valid;
+}
+
+void updateWeatherFreshness() {
+  // Age is only known once NTP has set the clock; until then cached data counts as stale.
+  currentFreshness = weatherCache.evaluate(currentWeather, time(nullptr));
+  displayService.setWeatherFreshness(currentFreshness, weatherCache.lastAgeMinutes());
+}
+
+void applyLocalSunTimes() {
+  // Sunrise/sunset shown on screen come from the solar routine, so they roll over at local midnight offline.
+  const SunTimes& sun = timeService.sunToday();
+  if (!currentWeather.valid || !sun.valid) {
+    // Polar day/night or no clock yet: keep whatever the API reported.
+    return;
+  }
+  currentWeather.sunriseHour = static_cast<uint8_t>(sun.sunriseMinute / 60);
+  currentWeather.sunriseMinute = static_cast<uint8_t>(sun.sunriseMinute % 60);
+  currentWeather.sunsetHour = static_cast<uint8_t>(sun.sunsetMinute / 60);
+  currentWeather.sunsetMinute = static_cast<uint8_t>(sun.sunsetMinute % 60);
+}
+
+void checkSunTimesAgainstApi() {
+  // The fresh payload still carries API sunrise/sunset; log the drift of the local computation.
+  timeService.setLocation(currentWeather.latMicrodeg, currentWeather.lonMicrodeg);
+  timeService.updateSunTimes();
+  const SunTimes& sun = timeService.sunToday();
+  if (!sun.valid) {
+    return;
+  }
+  const int apiSunrise = currentWeather.sunriseHour * 60 + currentWeather.sunriseMinute;
+  const int apiSunset = currentWeather.sunsetHour * 60 + currentWeather.sunsetMinute;
+  LOG_INFO(SunApiDelta, static_cast<int>(sun.sunriseMinute) - apiSunrise,
+           static_cast<int>(sun.sunsetMinute) - apiSunset);
+}
+
+void onWeatherChanged(int32_t utcOffsetSeconds) {
+  // New contents in currentWeather, fetched here or relayed: refresh derived state, then persist.
+  TRACE_SCOPE("on-weather");
+  ++weatherGeneration;
+  updateWeatherFreshness();
+  if (currentWeather.fetchedAtEpoch != 0) {
+    checkSunTimesAgainstApi();
+    applyLocalSunTimes();
+    // One observation per hour feeds the Trend page; a later sync in the same hour replaces it. Every relay
+    // generation re-delivers the leader's last fetch, so only an observation newer than the last sample counts.
+    if (currentWeather.fetchedAtEpoch > observationHistory.newestEpoch()) {
+      const ObservationSample sample = {currentWeather.temperatureF, currentWeather.windMph, currentWeather.gustMph};
+      observationHistory.record(currentWeather.fetchedAtEpoch, sample);
+    }
+    temperatureInterpolator.observe(currentWeather, currentWeather.fetchedAtEpoch);
+    displayService.setInterpolatedTemperature(temperatureInterpolator.active(), temperatureInterpolator.temperatureF());
+  }
+  weatherSnapshotStore.save(currentWeather, utcOffsetSeconds);
+}
+
+void onWeatherRefreshed() {
+  // Called after a successful parse: stamp fetch time, then persist.
+  const time_t utcNow = time(nullptr);
+  currentWeather.fetchedAtEpoch = TimeService::epochOrZero(utcNow);
+  onWeatherChanged(openWeatherService.detectedUtcOffsetSeconds());
+}
+
+void applyRelayedWeather(int32_t utcOffsetSeconds) {
+  // The relayed record keeps the leader's fetch time, so freshness ages from the real fetch.
+  timeService.setUtcOffsetSeconds(utcOffsetSeconds);
+  displayService.setUtcOffsetSeconds(utcOffsetSeconds);
+  timeService.refreshClockData(clockData);
+  onWeatherChanged(utcOffsetSeconds);
+}
+
+bool pollRelay(unsigned long now) {
+  // Leaders pick up follower requests here; followers take in new generations.
+  int32_t offset = 0;
+  const time_t utcNow = time(nullptr);
+  if (!weatherRelay.poll(currentWeather, offset, now, TimeService::epochOrZero(utcNow))) {
+    return false;
+  }
+  applyRelayedWeather(offset);
+  return true;
+}
+
+bool relayCoversWeather(unsigned long now) {
+  // A follower leaves OpenWeather to the leader while it is heard and its data is fresh.
+  return weatherRelay.leaderActive(now) && currentFreshness == WeatherFreshness::Fresh;
+}
+
+bool awaitRelayedWeather() {
+  // A booting follower asks the leader first; only a silent LAN costs it an API call.
+  if (weatherRelay.role() != RelayRole::Follower) {
+    return false;
+  }
+  weatherRelay.requestLatest();
+  const unsigned long startMs = millis();
+  while (millis() - startMs < RELAY_BOOT_WAIT_MS) {
+    if (pollRelay(millis())) {
+      return true;
+    }
+    delay(10);
+  }
+  Serial.println("[RELAY] No leader answered, fetching directly");
   return false;
 }
 
+void planNextSync() {
+  // Planner needs real UTC time; without it the retry path drives syncs.
+  const time_t utcNow = time(nullptr);
+  if (!TimeService::isClockSet(utcNow)) {
+    return;
+  }
+  // Charge the sync's calls; alert and nowcast requests were charged as they happened.
+  const uint32_t apiCalls = openWeatherService.apiCallCount() - plannerCallsAccounted;
+  plannerCallsAccounted = openWeatherService.apiCallCount();
+  syncPlanner.recordSync(static_cast<uint32_t>(utcNow), static_cast<uint16_t>(apiCalls), currentWeather);
+}
+
+bool plannerAllowsExtraCall(uint16_t apiCalls) {
+  // Requests outside the planned syncs need UTC to be charged, so they wait for NTP.
+  const time_t utcNow = time(nullptr);
+  return TimeService::isClockSet(utcNow) && syncPlanner.allowExtraCall(static_cast<uint32_t>(utcNow), apiCalls);
+}
+
+void chargeExtraCalls() {
+  // Charged as they happen, so recordSync() only sees the planned sync's own calls.
+  const time_t utcNow = time(nullptr);
+  if (!TimeService::isClockSet(utcNow)) {
+    return;
+  }
+  const uint32_t apiCalls = openWeatherService.apiCallCount() - plannerCallsAccounted;
+  plannerCallsAccounted = openWeatherService.apiCallCount();
+  syncPlanner.recordExtraCalls(static_cast<uint32_t>(utcNow), static_cast<uint16_t>(apiCalls));
+}
+
+#if WEATHERCLOCK_SYNC_SOAK > 0
+// Repeats the full weather refresh so the post-sync largest block can be watched
+// for drift. Point OWM_API_BASE_URL at a local stand-in; this spends real API calls otherwise.
+void runSyncSoak() {
+  Serial.print("[SOAK] Running syncs=");
+  Serial.println(WEATHERCLOCK_SYNC_SOAK);
+  uint32_t failures = 0;
+  for (uint32_t i = 0; i < WEATHERCLOCK_SYNC_SOAK; ++i) {
+    if (!openWeatherService.refreshWeather(currentWeather, nullptr)) {
+      ++failures;
+    }
+    heapMonitor.endSync();
+    DeferredLog::drainToSerial(LOG_DRAIN_PER_LOOP);
+    yield();
+  }
+  const HeapMetric& block = heapMonitor.syncLargestBlock();
+  Serial.print("[SOAK] Done failures=");
+  Serial.print(failures);
+  Serial.print(" block min=");
+  Serial.print(block.min);
+  Serial.print(" max=");
+  Serial.print(block.max);
+  Serial.print(" last=");
+  Serial.println(block.last);
+}
+#endif
+
 bool performHourlySync() {
-  // Sync NTP first, then weather. Keep one combined status for the UI.
-  Serial.println("[SYNC] Starting hourly sync");
+  // Sync NTP and weather together. Keep one combined status for the UI.
+  TRACE_CAPTURE_SCOPE("sync");
+  LOG_INFO(SyncStarting);
+  // Count what this sync found in the cache, once per sync rather than per display refresh.
+  updateWeatherFreshness();
+  weatherCache.recordSync();
   networkBusy = true;
-  const bool ntpSynced = timeService.syncFromNtp();
+  // NTP completes in the background while the weather request is in flight.
+  timeService.beginNtpSync();
+  const bool relayed = relayCoversWeather(millis());
+  const bool weatherUpdated = !relayed && openWeatherService.refreshWeather(currentWeather, nullptr);
+  if (!relayed) {
+    metrics.recordSync(weatherUpdated);
+    heapMonitor.endSync();
+  }
+  const bool ntpSynced = timeService.finishNtpSync();
   const bool clockRefreshed = ntpSynced && timeService.refreshClockData(clockData);
   if (!clockRefreshed) {
     clockData.valid = false;
-    Serial.println("[SYNC] Clock refresh failed");
+    LOG_WARN(SyncClockFailed);
   }
 
-  const bool weatherUpdated = openWeatherService.refreshWeather(currentWeather, nullptr);
-  if (!weatherUpdated) {
-    currentWeather.valid = false;
-    Serial.println("[SYNC] Weather refresh failed");
+  if (relayed) {
+    LOG_INFO(SyncRelayCovers);
+  } else if (!weatherUpdated) {
+    // Keep serving cached data; the freshness policy decides when it becomes an error.
+    updateWeatherFreshness();
+    LOG_WARN(SyncWeatherFailed);
   } else {
     // Weather API also provides timezone offset for the selected location.
     const int32_t offset = openWeatherService.detectedUtcOffsetSeconds();
-    Serial.print("[SYNC] Applying API timezone offset: ");
-    Serial.println(offset);
+    LOG_INFO(SyncApplyOffset, offset);
     timeService.setUtcOffsetSeconds(offset);
+    displayService.setUtcOffsetSeconds(offset);
     timeService.refreshClockData(clockData);
+    onWeatherRefreshed();
   }
 
   networkBusy = false;
-  Serial.print("[SYNC] Completed. time=");
-  Serial.print(clockRefreshed ? "ok" : "error");
-  Serial.print(" weather=");
-  Serial.println(weatherUpdated ? "ok" : "error");
-  return clockRefreshed && weatherUpdated;
+  planNextSync();
+  LOG_INFO(SyncCompleted, clockRefreshed ? "ok" : "error", relayed ? "relay" : (weatherUpdated ? "ok" : "error"));
+  LOG_INFO(CacheCounts, weatherCache.hitCount(), weatherCache.staleCount(), weatherCache.expiredCount());
+  return clockRefreshed && (relayed || weatherUpdated);
 }
 
-void showSyncStatus(const char* title, const String& line1, const String& line2, const String& line3) {
-  // Thin wrapper to match the callback signature expected by weather service.
-  displayService.drawStatusScreen(title, line1, line2, line3);
+void refreshAlertsIfDue(unsigned long now) {
+  // Alerts refresh independently of the core sync; failures retry sooner, gated by backoff.
+  static unsigned long lastAlertsAttemptMs = 0;
+  static unsigned long alertsIntervalMs = 0;
+  if (!clockData.valid || WiFi.status() != WL_CONNECTED || now - lastAlertsAttemptMs < alertsIntervalMs ||
+      relayCoversWeather(now)) {
+    return;
+  }
+  lastAlertsAttemptMs = now;
+  if (!plannerAllowsExtraCall(1)) {
+    // No spare calls today: keep the alerts we have and look again next slot.
+    alertsIntervalMs = ALERTS_REFRESH_INTERVAL_MS;
+    LOG_INFO(AlertRefreshSkipped);
+    return;
+  }
+  networkBusy = true;
+  const bool updated = openWeatherService.refreshAlerts(currentWeather);
+  networkBusy = false;
+  chargeExtraCalls();
+  alertsIntervalMs = updated ? ALERTS_REFRESH_INTERVAL_MS : RETRY_SYNC_MIN_SPACING_MS;
+  if (updated) {
+    ++weatherGeneration;
+    weatherSnapshotStore.save(currentWeather, openWeatherService.detectedUtcOffsetSeconds());
+  }
 }
 
-bool handlePageButtonClick(unsigned long now, uint8_t& pageIndex, unsigned long& lastPageInteractionMs) {
-  // Debounced button click: LOW edge advances page.
-  static int lastRawState = HIGH;
-  static int stableState = HIGH;
-  static unsigned long lastDebounceMs = 0;
-
-  const int rawState = digitalRead(RESET_BUTTON_PIN);
-  if (rawState != lastRawState) {
-    // Raw level changed, restart debounce timer.
-    lastDebounceMs = now;
-    lastRawState = rawState;
+uint8_t nextHourPopPct() {
+  // Highest precipitation chance for this hour and the next, from the stored hourly series.
+  const ForecastStore& forecast = currentWeather.forecast;
+  const time_t utcNow = time(nullptr);
+  if (forecast.hourlyCount == 0 || utcNow < static_cast<time_t>(forecast.hourlyStartEpoch)) {
+    return currentWeather.rainChancePct;
   }
+  const uint32_t idx = static_cast<uint32_t>(utcNow - static_cast<time_t>(forecast.hourlyStartEpoch)) / 3600UL;
+  uint8_t pop = 0;
+  for (uint32_t i = idx; i < idx + 2 && i < forecast.hourlyCount; ++i) {
+    if (forecast.hourlyPopPct[i] > pop) {
+      pop = forecast.hourlyPopPct[i];
+    }
+  }
+  return pop;
+}
 
-  if (now - lastDebounceMs < PAGE_BUTTON_DEBOUNCE_MS) {
-    return false;
+void refreshNowcastIfDue(unsigned long now) {
+  // Minutely data costs an extra call, so only pull it while the hourly pop says rain is plausible.
+  static unsigned long lastNowcastAttemptMs = 0;
+  static bool attempted = false;
+  if (!clockData.valid || !currentWeather.valid || WiFi.status() != WL_CONNECTED || relayCoversWeather(now)) {
+    return;
   }
+  if (attempted && now - lastNowcastAttemptMs < NOWCAST_REFRESH_INTERVAL_MS) {
+    return;
+  }
+  const uint8_t pop = nextHourPopPct();
+  if (pop < NOWCAST_POP_THRESHOLD_PCT) {
+    return;
+  }
+  attempted = true;
+  lastNowcastAttemptMs = now;
+  if (!plannerAllowsExtraCall(1)) {
+    LOG_INFO(SyncNowcastSkipped);
+    return;
+  }
+  LOG_INFO(SyncNowcastDue, pop);
+  networkBusy = true;
+  openWeatherService.refreshNowcast(nowcast);
+  networkBusy = false;
+  chargeExtraCalls();
+}
 
-  if (stableState != rawState) {
-    stableState = rawState;
-    if (stableState == LOW) {
-      // Advance through available pages and remember user interaction time.
-      pageIndex = static_cast<uint8_t>((pageIndex + 1) % TOTAL_PAGES);
-      lastPageInteractionMs = now;
-      Serial.print("[UI] Button click -> page ");
-      Serial.println(pageIndex + 1);
-      return true;
+void showSyncStatus(const char* title, const String& line1, const String& line2, const String& line3) {
+  // Thin wrapper to match the callback signature expected by weather service.
+  displayService.drawStatusScreen(title, line1, line2, line3);
+}
+
+bool handleButtonGestures(unsigned long now, uint8_t& pageIndex, uint8_t& scrollPage,
+                          unsigned long& lastPageInteractionMs, uint32_t& pendingFrameEdgeUs) {
+  // Consume every queued gesture; presses made during blocking work arrive here late but in order.
+  bool pageChanged = false;
+  ButtonEvent event{};
+  while (buttonService.poll(event)) {
+    const uint8_t scrollPages = displayService.forecastScrollPages(pageIndex, currentWeather);
+    switch (event.gesture) {
+      case ButtonGesture::Click:
+        // Advance through available pages.
+        pageIndex = static_cast<uint8_t>((pageIndex + 1) % TOTAL_PAGES);
+        scrollPage = 0;
+        break;
+      case ButtonGesture::DoubleClick:
+        // Jump straight back to home.
+        pageIndex = 0;
+        scrollPage = 0;
+        break;
+      case ButtonGesture::LongPress:
+        if (scrollPages > 1) {
+          // Scrollable forecast page: step through the stored series, no network needed.
+          scrollPage = static_cast<uint8_t>((scrollPage + 1) % scrollPages);
+        } else {
+          // Step back one page.
+          pageIndex = static_cast<uint8_t>((pageIndex + TOTAL_PAGES - 1) % TOTAL_PAGES);
+          scrollPage = 0;
+        }
+        break;
+      default:
+        continue;
     }
+    // Remember user interaction time and the edge that the next frame answers.
+    lastPageInteractionMs = now;
+    pendingFrameEdgeUs = event.edgeUs;
+    pageChanged = true;
+    Serial.print("[UI] Button gesture ");
+    Serial.print(static_cast<int>(event.gesture));
+    Serial.print(" -> page ");
+    Serial.print(pageIndex + 1);
+    Serial.print(" scroll ");
+    Serial.println(scrollPage);
   }
-
-  return false;
+  return pageChanged;
 }
 
 void onConfigPortalStart(WiFiManager* wm) {
@@ -205,34 +562,173 @@ void onConfigPortalStart(WiFiManager* wm) {
         "192.168.4.1");
   }
 }
+void writePortalChunk(void* context, const char* data, size_t length) {
+  (void)context;
+  wifiManager.server->sendContent(data, length);
+}
+
+void handleMetrics() {
+  // Chunked response: Metrics formats into a fixed stack buffer, never a String body.
+  const HeapSample heap = HeapMonitor::sample();
+  MetricsGauges gauges{};
+  gauges.freeHeapBytes = heap.freeBytes;
+  gauges.largestBlockBytes = heap.largestBlock;
+  gauges.framesDrawn = displayService.framesDrawn();
+  gauges.framesSkipped = displayService.framesSkipped();
+  gauges.apiCalls = openWeatherService.apiCallCount();
+  gauges.logRecords = DeferredLog::recordsWritten();
+  gauges.logOverwritten = DeferredLog::recordsOverwritten();
+  gauges.logWriteCycles = DeferredLog::writeCycles();
+  gauges.configWrites = openWeatherConfigService.writeCount();
+  gauges.configLoadUs = openWeatherConfigService.loadMicros();
+  gauges.relaySent = weatherRelay.packetsSent();
+  gauges.relayAccepted = weatherRelay.packetsAccepted();
+  gauges.relayRejected = weatherRelay.packetsRejected();
+  gauges.jsonSerializations = weatherJson.serializations();
+  gauges.jsonNotModified = weatherJsonNotModified;
+  gauges.jsonSerializeUs = weatherJson.lastSerializeMicros();
+  gauges.screenViewers = screenMirror.viewerCount();
+  gauges.screenPagesSent = screenMirror.pagesSent();
+  gauges.screenPassUs = screenMirror.lastPassMicros();
+  gauges.screenPassMaxUs = screenMirror.maxPassMicros();
+  wifiManager.server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  wifiManager.server->send(200, "text/plain; version=0.0.4", "");
+  const size_t bytes = metrics.render(gauges, writePortalChunk, nullptr);
+  wifiManager.server->sendContent("", 0);
+  Serial.print("[METRICS] Scrape served bytes=");
+  Serial.println(static_cast<unsigned long>(bytes));
+}
+
+void handleLogDump() {
+  // Binary records; decode with tools/decode_log.py.
+  wifiManager.server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  wifiManager.server->send(200, "application/octet-stream", "");
+  DeferredLog::dump(writePortalChunk, nullptr);
+  wifiManager.server->sendContent("", 0);
+}
+
+void handleWeatherJson() {
+  // Dashboards poll this; unchanged data costs a header compare and a 304, never a rebuild.
+  auto& server = *wifiManager.server;
+  if (!currentWeather.valid) {
+    server.send(503, "application/json", "{\"error\":\"no weather yet\"}");
+    return;
+  }
+  weatherJson.update(currentWeather, weatherGeneration, timeService.utcOffsetSeconds());
+  server.sendHeader("ETag", weatherJson.etag());
+  server.sendHeader("Cache-Control", "no-cache");
+  if (server.hasHeader("If-None-Match") && weatherJson.matches(server.header("If-None-Match").c_str())) {
+    ++weatherJsonNotModified;
+    server.send(304);
+    return;
+  }
+  server.setContentLength(weatherJson.length());
+  server.send(200, "application/json", "");
+  server.sendContent(weatherJson.body(), weatherJson.length());
+}
+
+void handleScreenPage() {
+  wifiManager.server->send_P(200, "text/html", ScreenMirror::pageHtml());
+}
+
+void handleScreenEvents() {
+  // The mirror writes its own SSE response headers and keeps the connection.
+  WiFiClient client = wifiManager.server->client();
+  if (!screenMirror.addViewer(client)) {
+    wifiManager.server->send(503, "text/plain", "Too many screen viewers");
+  }
+}
+
+#if WEATHERCLOCK_TRACE
+void handleTrace() {
+  // Load in chrome://tracing or ui.perfetto.dev; the dump also releases a held capture.
+  wifiManager.server->setContentLength(CONTENT_LENGTH_UNKNOWN);
+  wifiManager.server->send(200, "application/json", "");
+  const size_t bytes = TraceRing::renderChromeJson(writePortalChunk, nullptr);
+  wifiManager.server->sendContent("", 0);
+  Serial.print("[TRACE] Dump served bytes=");
+  Serial.println(static_cast<unsigned long>(bytes));
+}
+#endif
+
+void registerPortalRoutes() {
+  // WiFiManager recreates its server per portal start; re-add app routes each time.
+  wifiManager.server->on("/metrics", HTTP_GET, handleMetrics);
+  wifiManager.server->on("/log.bin", HTTP_GET, handleLogDump);
+  // The server drops request headers it was not told to keep.
+  const char* collected[] = {"If-None-Match"};
+  wifiManager.server->collectHeaders(collected, 1);
+  wifiManager.server->on("/weather.json", HTTP_GET, handleWeatherJson);
+  wifiManager.server->on("/screen", HTTP_GET, handleScreenPage);
+  wifiManager.server->on("/screen/events", HTTP_GET, handleScreenEvents);
+#if WEATHERCLOCK_TRACE
+  wifiManager.server->on("/trace.json", HTTP_GET, handleTrace);
+#endif
+}
 }  // namespace
 
 void setup() {
   // Serial logging for boot diagnostics.
   Serial.begin(115200);
-  delay(50);
   Serial.println();
   Serial.println("[BOOT] WeatherClock starting");
 
-  // Initialize OLED early so boot/setup status can be shown to the user.
-  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR)) {
-    for (;;) {
-      delay(1000);
-    }
-  }
+  // Heap sampling brackets every sync phase; the Diag page reads the same stats.
+  openWeatherService.setHeapMonitor(&heapMonitor);
+  displayService.setHeapMonitor(heapMonitor);
+  displayService.setScreenMirror(screenMirror);
+  openWeatherService.setMetrics(&metrics);
 
-  displayService.drawBootScreen();
-  delay(500);
+  // Sample the button first so a normal boot never pays for the reset window.
+  const bool resetHeld = isButtonHeldAtPowerOn();
 
+  // Start associating with saved WiFi right away; display + LittleFS init overlap with it.
+  const int8_t wifiPhase = bootProfiler.start("wifi-connect");
   WiFi.mode(WIFI_STA);
   deviceName = buildDeviceName();
   portalSsid = deviceName;
   Serial.print("[BOOT] Device name: ");
   Serial.println(deviceName);
   WiFi.hostname(deviceName);
+  syncPlanner.setDeviceSeed(deviceMacSuffix());
+  if (!resetHeld && wifiManager.getWiFiIsSaved()) {
+    WiFi.begin();
+  }
+
+  // Initialize OLED early so boot/setup status can be shown to the user.
+  const int8_t displayPhase = bootProfiler.start("display-init");
+  if (!display.begin(SSD1306_SWITCHCAPVCC, OLED_ADDR)) {
+    for (;;) {
+      delay(1000);
+    }
+  }
+  displayService.drawBootScreen();
+  displayService.setNowcast(nowcast);
+  bootProfiler.finish(displayPhase);
+
+  const int8_t configPhase = bootProfiler.start("config-load");
   configPortalDisplay = &displayService;
   openWeatherConfigService.load();
   openWeatherConfigService.configurePortal(wifiManager);
+  bootProfiler.finish(configPhase);
+
+  // Instant-on: render the persisted snapshot while the network comes up behind it.
+  const int8_t snapshotPhase = bootProfiler.start("snapshot");
+  const bool snapshotShown = loadWeatherSnapshot();
+  bootProfiler.finish(snapshotPhase);
+  updateWeatherFreshness();
+  if (snapshotShown) {
+    displayService.setNetworkActivity(true, networkAnimFrame);
+    networkBusy = true;
+    displayService.drawLayoutFrame(clockData, currentWeather, true);
+    bootProfiler.markFirstFrame();
+  }
+
+  // History replay is not needed for the first frame, so it runs after it.
+  const int8_t historyPhase = bootProfiler.start("history");
+  observationHistory.load();
+  displayService.setObservationHistory(observationHistory);
+  bootProfiler.finish(historyPhase);
 
   // Configure WiFiManager for station auto-connect plus non-blocking web portal.
   wifiManager.setAPCallback(onConfigPortalStart);
@@ -245,18 +741,29 @@ void setup() {
   wifiManager.setConfigPortalTimeout(180);
 
   bool connected = false;
-  if (shouldEnterFactoryResetFromButton()) {
+  if (resetHeld && shouldEnterFactoryResetFromButton()) {
     // Factory-reset path: clear saved settings and open config portal.
-    Serial.println("[BOOT] Reset button pressed, entering config portal");
+    Serial.println("[BOOT] Reset button held, entering config portal");
     displayService.drawStatusScreen("Reset", "Clearing WiFi + app cfg", "Starting config", portalSsid);
     clearSavedAppSettings();
     connected = wifiManager.startConfigPortal(portalSsid.c_str());
+  } else if (WiFi.status() == WL_CONNECTED) {
+    // Early association already finished while the display and config were initializing.
+    Serial.println("[BOOT] Saved network connected during init");
+    connected = true;
   } else {
     // Normal boot path: try saved credentials and show first-time setup guidance.
     Serial.println("[BOOT] Attempting autoConnect");
-    displayService.drawStatusScreen("WiFi", "Trying saved network...", String("If needed: ") + portalSsid, "Open 192.168.4.1");
+    if (!snapshotShown) {
+      displayService.drawStatusScreen(
+          "WiFi", "Trying saved network...", String("If needed: ") + portalSsid, "Open 192.168.4.1");
+    }
     connected = wifiManager.autoConnect(portalSsid.c_str());
   }
+  bootProfiler.finish(wifiPhase);
+
+  // Reset window is over: from here on the button is edge-interrupt driven.
+  buttonService.begin();
 
   if (!connected) {
     Serial.println("[WIFI] Connection failed, restarting");
@@ -269,63 +776,91 @@ void setup() {
   Serial.print(" IP=");
   Serial.println(WiFi.localIP());
   displayService.setLocalIp(WiFi.localIP().toString());
+  weatherRelay.begin(static_cast<RelayRole>(WEATHERCLOCK_RELAY_ROLE), deviceMacSuffix());
 
   openWeatherConfigService.applyFromConfig();
   timeService.refreshClockData(clockData);
 
-  // Brief post-connect confirmation.
-  displayService.drawStatusScreen(
-      "WiFi Connected",
-      deviceName,
-      WiFi.SSID(),
-      WiFi.localIP().toString());
-  delay(800);
-
-  // Initial full sync: NTP then weather.
-  displayService.drawStatusScreen(
-      "Time",
-      "Syncing NTP...",
-      "Timezone from ZIP/API",
-      "0.us.pool.ntp.org + backups");
+  // Initial full sync: NTP runs in the background while weather is fetched.
+  // With a snapshot on screen, keep showing it instead of status screens.
   displayService.setNetworkActivity(true, networkAnimFrame);
   networkBusy = true;
-  const bool ntpSynced = timeService.syncFromNtp();
+  if (snapshotShown) {
+    displayService.drawLayoutFrame(clockData, currentWeather, true);
+  } else {
+    displayService.drawStatusScreen(
+        "WiFi Connected",
+        deviceName,
+        "Syncing time + weather",
+        WiFi.localIP().toString());
+  }
+  const int8_t ntpPhase = bootProfiler.start("ntp");
+  timeService.beginNtpSync();
+
+  const int8_t weatherPhase = bootProfiler.start("weather");
+  const bool relayed = awaitRelayedWeather();
+  const bool weatherUpdated =
+      !relayed && openWeatherService.refreshWeather(currentWeather, snapshotShown ? nullptr : showSyncStatus);
+  bootProfiler.finish(weatherPhase);
+  if (!relayed) {
+    metrics.recordSync(weatherUpdated);
+    heapMonitor.endSync();
+  }
+
+  const bool ntpSynced = timeService.finishNtpSync();
+  bootProfiler.finish(ntpPhase);
   const bool clockRefreshed = ntpSynced && timeService.refreshClockData(clockData);
   if (!clockRefreshed) {
     clockData.valid = false;
   }
-  const bool weatherUpdated = openWeatherService.refreshWeather(currentWeather, showSyncStatus);
-  if (!weatherUpdated) {
-    currentWeather.valid = false;
-  } else {
+  if (weatherUpdated) {
     // Override timezone with API-provided offset tied to configured location.
     const int32_t offset = openWeatherService.detectedUtcOffsetSeconds();
     Serial.print("[BOOT] Applying API timezone offset: ");
     Serial.println(offset);
     timeService.setUtcOffsetSeconds(offset);
+    displayService.setUtcOffsetSeconds(offset);
     timeService.refreshClockData(clockData);
+    onWeatherRefreshed();
   }
   networkBusy = false;
+  updateWeatherFreshness();
+  planNextSync();
+#if WEATHERCLOCK_SYNC_SOAK > 0
+  runSyncSoak();
+#endif
 
   // Keep WiFiManager web UI reachable at the station IP while normal app runs.
   wifiManager.setConfigPortalBlocking(false);
+  wifiManager.setWebServerCallback(registerPortalRoutes);
   wifiManager.startWebPortal();
   webPortalRunning = true;
 
   // Draw initial frame after setup/sync phase.
   displayService.drawLayoutFrame(clockData, currentWeather, true);
+  bootProfiler.markFirstFrame();
+  bootProfiler.report();
+#if WEATHERCLOCK_BENCH
+  ForecastStore::logFootprint();
+  logFixedPointBenchmark();
+  TimeService::logCalendarBenchmark();
+#endif
 }
 
 void loop() {
-  // Keep UI fresh while pulling NTP/weather at boot and on every hour boundary.
+  // Keep UI fresh while pulling NTP/weather at boot and on the planner's schedule.
   static unsigned long lastClockRefreshMs = 0;
-  static unsigned long lastNoTimeRetryMs = 0;
+  static unsigned long lastRetrySyncMs = 0;
+  static unsigned long lastRevalidateMs = 0;
   static unsigned long lastBlinkToggleMs = 0;
   static unsigned long lastNetworkAnimMs = 0;
-  static long lastHourlySyncKey = -1;
   static bool showColon = true;
   static uint8_t currentPage = 0;
+  static uint8_t forecastScroll = 0;
   static unsigned long lastPageInteractionMs = 0;
+  static uint32_t pendingFrameEdgeUs = 0;
+  static bool framePending = false;
+  const uint32_t loopStartUs = micros();
   const unsigned long now = millis();
 
   // Refresh clock snapshot once per second.
@@ -334,6 +869,21 @@ void loop() {
     if (!timeService.refreshClockData(clockData)) {
       clockData.valid = false;
     }
+    updateWeatherFreshness();
+    if (clockData.valid && temperatureInterpolator.update(static_cast<uint32_t>(time(nullptr)))) {
+      // Recomputed once per minute: forecast curve plus decaying observation bias.
+      displayService.setInterpolatedTemperature(true, temperatureInterpolator.temperatureF());
+    }
+    if (clockData.valid && currentWeather.valid && timeService.updateSunTimes()) {
+      // Local midnight (or a new offset) rolled the day over; no fetch needed.
+      applyLocalSunTimes();
+    }
+    if (clockData.valid && pruneExpiredAlerts(currentWeather, static_cast<uint32_t>(time(nullptr))) > 0) {
+      // Expired alerts drop out locally; no refetch needed.
+      ++weatherGeneration;
+      Serial.print("[ALERT] Expired alert removed, active=");
+      Serial.println(currentWeather.alertCount);
+    }
   }
 
   // Blink colon in clock view.
@@ -342,20 +892,42 @@ void loop() {
     showColon = !showColon;
   }
 
-  if (clockData.valid) {
-    // One-shot trigger at minute 00 for each distinct hour key.
-    const long hourlySyncKey =
-        static_cast<long>(clockData.month) * 100000L + static_cast<long>(clockData.day) * 1000L + clockData.hour;
-    if (clockData.minute == 0 && hourlySyncKey != lastHourlySyncKey) {
-      Serial.println("[SYNC] Top of hour reached, syncing");
+  if (clockData.valid && syncPlanner.isDue(static_cast<uint32_t>(time(nullptr)))) {
+    // Planned sync: staggered per device, cadence follows forecast volatility and quota.
+    LOG_INFO(SyncPlannedDue);
+    performHourlySync();
+  }
+
+  // Retry failed time/weather between planned syncs, paced by backoff + circuit breakers.
+  // Weather retries only follow a recorded failure; plain staleness goes through the planner budget below.
+  const bool timeRetryDue = !clockData.valid && timeService.msUntilNtpRetry(now) == 0;
+  const bool weatherRetryDue = currentFreshness != WeatherFreshness::Fresh &&
+                               openWeatherService.retryPolicy().consecutiveFailures() > 0 &&
+                               openWeatherService.msUntilRetry(now) == 0;
+  if ((timeRetryDue || weatherRetryDue) && now - lastRetrySyncMs >= RETRY_SYNC_MIN_SPACING_MS) {
+    LOG_INFO(SyncRetryDue, timeRetryDue ? "due" : "ok", weatherRetryDue ? "due" : "ok");
+    lastRetrySyncMs = now;
+    lastRevalidateMs = now;
+    performHourlySync();
+  } else if (currentFreshness != WeatherFreshness::Fresh &&
+             now - lastRevalidateMs >= STALE_REVALIDATE_INTERVAL_MS) {
+    // Revalidate stale data in the background while it keeps showing, if the budget has room.
+    lastRevalidateMs = now;
+    if (plannerAllowsExtraCall(static_cast<uint16_t>(syncPlanner.callsPerSync()))) {
+      LOG_INFO(SyncRevalidate);
+      lastRetrySyncMs = now;
       performHourlySync();
-      lastHourlySyncKey = hourlySyncKey;
     }
-  } else if (now - lastNoTimeRetryMs >= 60000) {
-    // If time is invalid, retry once per minute until NTP returns.
-    Serial.println("[SYNC] Time invalid, running retry sync");
-    lastNoTimeRetryMs = now;
-    performHourlySync();
+  }
+
+  refreshAlertsIfDue(now);
+  refreshNowcastIfDue(now);
+
+  if (weatherRelay.role() != RelayRole::Off) {
+    pollRelay(now);
+    const time_t utcNow = time(nullptr);
+    weatherRelay.publish(currentWeather, weatherGeneration, timeService.utcOffsetSeconds(),
+                         TimeService::epochOrZero(utcNow), now);
   }
 
   if (networkBusy && now - lastNetworkAnimMs >= 250) {
@@ -367,12 +939,16 @@ void loop() {
   if (webPortalRunning) {
     // Service WiFiManager HTTP handlers in non-blocking mode.
     wifiManager.process();
+    screenMirror.poll(now);
   }
 
-  // Single button rotates pages; inactive detail page auto-returns to home.
-  handlePageButtonClick(now, currentPage, lastPageInteractionMs);
+  // Button gestures rotate pages; inactive detail page auto-returns to home.
+  if (handleButtonGestures(now, currentPage, forecastScroll, lastPageInteractionMs, pendingFrameEdgeUs)) {
+    framePending = true;
+  }
   if (currentPage != 0 && now - lastPageInteractionMs >= PAGE_AUTO_RETURN_MS) {
     currentPage = 0;
+    forecastScroll = 0;
   }
 
   if (pendingConfigSync && WiFi.status() == WL_CONNECTED) {
@@ -384,5 +960,18 @@ void loop() {
 
   // Render current page with latest data and activity indicator.
   displayService.setNetworkActivity(networkBusy, networkAnimFrame);
+  if (forecastScroll >= displayService.forecastScrollPages(currentPage, currentWeather)) {
+    // A new sync can shorten the series under the current scroll position.
+    forecastScroll = 0;
+  }
+  displayService.setForecastScroll(forecastScroll);
   displayService.drawPage(currentPage, clockData, currentWeather, showColon);
+  if (framePending) {
+    // drawPage() has flushed the new page, so this closes the edge-to-pixel measurement.
+    framePending = false;
+    buttonService.recordFrameLatency(pendingFrameEdgeUs);
+  }
+  // Sync-path logging only queued records; print a few while the UART has room.
+  DeferredLog::drainToSerial(LOG_DRAIN_PER_LOOP);
+  metrics.observeLoop(micros() - loopStartUs);
 }
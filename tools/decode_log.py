@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""Decode a WeatherClock deferred-log dump (GET /log.bin) into text.
+
+Usage:
+  decode_log.py dump.bin
+  decode_log.py http://<device-ip>/log.bin
+
+Format strings come from src/LogMessages.h, so decode with the same tree the
+firmware was built from.
+"""
+
+import os
+import re
+import struct
+import sys
+import urllib.request
+
+HEADER = struct.Struct("<4sBBxxIII")
+LEVELS = ["E", "W", "I", "D"]
+TABLE = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "LogMessages.h")
+SPEC = re.compile(r"%([0-9-]*)([dusx%])")
+
+
+def load_formats(path):
+    with open(path, encoding="utf-8") as f:
+        text = f.read()
+    # X(Id, "format") entries in table order; adjacent literals are not used.
+    return [m.group(2).encode().decode("unicode_escape")
+            for m in re.finditer(r'X\((\w+),\s*"((?:[^"\\]|\\.)*)"\)', text)]
+
+
+def parse_args(body):
+    args = []
+    pos = 0
+    while pos < len(body):
+        tag = chr(body[pos])
+        if tag in "iu":
+            (value,) = struct.unpack_from("<i" if tag == "i" else "<I", body, pos + 1)
+            args.append(value)
+            pos += 5
+        elif tag == "s":
+            length = body[pos + 1]
+            args.append(body[pos + 2:pos + 2 + length].decode("latin-1"))
+            pos += 2 + length
+        else:
+            raise ValueError("bad argument tag %r" % tag)
+    return args
+
+
+def render(fmt, args):
+    it = iter(args)
+
+    def sub(m):
+        flags, conv = m.group(1), m.group(2)
+        if conv == "%":
+            return "%"
+        value = next(it, "?")
+        if isinstance(value, str) or conv == "s":
+            return str(value)
+        if conv == "u":
+            value &= 0xFFFFFFFF
+            conv = "d"
+        return ("%" + flags + conv) % value
+
+    return SPEC.sub(sub, fmt)
+
+
+def decode(data, formats):
+    magic, version, level, written, overwritten, now_ms = HEADER.unpack_from(data, 0)
+    if magic != b"WCLG" or version != 1:
+        raise SystemExit("not a WeatherClock log dump (magic=%r version=%d)" % (magic, version))
+    print("# level<=%s written=%d overwritten=%d dumped_at_ms=%d"
+          % (LEVELS[level] if level < len(LEVELS) else level, written, overwritten, now_ms))
+    pos = HEADER.size
+    while pos < len(data):
+        length = data[pos]
+        if length < 8 or pos + length > len(data):
+            print("# truncated record at offset %d" % pos)
+            break
+        lvl, msg_id, ms = struct.unpack_from("<BHI", data, pos + 1)
+        args = parse_args(data[pos + 8:pos + length])
+        fmt = formats[msg_id] if msg_id < len(formats) else "[LOG] unknown id %d" % msg_id
+        name = LEVELS[lvl] if lvl < len(LEVELS) else "?"
+        print("%10.3f %s %s" % (ms / 1000.0, name, render(fmt, args)))
+        pos += length
+
+
+def main():
+    if len(sys.argv) != 2:
+        raise SystemExit(__doc__)
+    source = sys.argv[1]
+    if source.startswith("http://") or source.startswith("https://"):
+        data = urllib.request.urlopen(source, timeout=10).read()
+    else:
+        with open(source, "rb") as f:
+            data = f.read()
+    decode(data, load_formats(TABLE))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,4 @@
+#pragma once
+
+// Host tools never draw; WeatherIcons.h only needs the type name.
+class Adafruit_GFX {};
@@ -0,0 +1,73 @@
+#pragma once
+
+// Minimal Arduino surface for building pure firmware modules into host tools.
+// Serial goes to stderr so a tool's own report on stdout stays readable;
+// millis()/micros() read hostClockMs, which a simulation may advance.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROGMEM
+#define pgm_read_byte(addr) (*reinterpret_cast<const uint8_t*>(addr))
+#define pgm_read_ptr(addr) (*(addr))
+
+inline unsigned long& hostClockMs() {
+  static unsigned long ms = 0;
+  return ms;
+}
+
+inline unsigned long millis() {
+  return hostClockMs();
+}
+
+inline unsigned long micros() {
+  return hostClockMs() * 1000UL;
+}
+
+inline void yield() {}
+
+struct HostEsp {
+  uint32_t getCycleCount() const {
+    return static_cast<uint32_t>(micros() * 80UL);
+  }
+};
+
+struct HostSerial {
+  int availableForWrite() const {
+    return 256;
+  }
+  void print(const char* text) {
+    fputs(text, stderr);
+  }
+  void print(char c) {
+    fputc(c, stderr);
+  }
+  void print(long long value) {
+    fprintf(stderr, "%lld", value);
+  }
+  void print(int value) {
+    print(static_cast<long long>(value));
+  }
+  void print(long value) {
+    print(static_cast<long long>(value));
+  }
+  void print(unsigned int value) {
+    print(static_cast<long long>(value));
+  }
+  void print(unsigned long value) {
+    print(static_cast<long long>(value));
+  }
+  template <typename T>
+  void println(T value) {
+    print(value);
+    println();
+  }
+  void println() {
+    fputc('\n', stderr);
+  }
+};
+
+static HostEsp ESP __attribute__((unused));
+static HostSerial Serial __attribute__((unused));
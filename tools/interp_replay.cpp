@@ -0,0 +1,226 @@
+// Replay recorded OneCall payloads through src/TemperatureInterpolator.cpp and
+// score what the home page would have shown against simply holding the last
+// observation.
+//
+// Record a sequence by saving the OneCall response (units=imperial, with
+// current and hourly) every few minutes, e.g. every 10 min:
+//   while sleep 600; do curl -s "$ONECALL_URL" > rec/$(date +%s).json; done
+//
+// Build and run from the repository root:
+//   g++ -std=c++11 -O2 -Isrc -Itools/host -o interp_replay tools/interp_replay.cpp
+//       src/TemperatureInterpolator.cpp src/ForecastStore.cpp src/JsonStreamScanner.cpp
+//       src/FixedPoint.cpp src/DeferredLog.cpp
+//   ./interp_replay [--every N] rec/*.json 2>/dev/null
+//
+// Payloads are ordered by current.dt. Every Nth payload (default 1, i.e. each
+// recording is a sync) is fed to observe() exactly as a sync would be; between
+// syncs the interpolator advances minute by minute. At every recorded
+// observation up to 4 h after a sync, the whole-degree value on screen and the
+// held observation are compared with the recorded current.temp, both overall
+// and by time since the sync. Use --every to see what a lower fetch rate would
+// look like with the same data. The interpolator's own [INTERP] records go to
+// stderr.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+#include "DeferredLog.h"
+#include "FixedPoint.h"
+#include "JsonStreamScanner.h"
+#include "Models.h"
+#include "TemperatureInterpolator.h"
+
+namespace {
+const uint32_t kMaxScoredAgeSec = 4 * 3600;
+const uint32_t kAgeBucketEndMin[] = {30, 60, 120, 240};
+const size_t kAgeBuckets = sizeof(kAgeBucketEndMin) / sizeof(kAgeBucketEndMin[0]);
+
+struct Payload {
+  uint32_t dt;
+  int16_t tempF;
+  ForecastStore forecast;
+};
+
+enum class Section : uint8_t { None, Current, Hourly };
+
+struct ParseState {
+  Payload* payload;
+  Section section;
+  bool haveCurrentTemp;
+  uint32_t hourDt;
+  int32_t hourTempF;
+  bool haveHourTemp;
+};
+
+void onToken(void* context, JsonStreamScanner::Event event, const JsonStreamScanner& scanner) {
+  ParseState& state = *static_cast<ParseState*>(context);
+  const uint8_t depth = scanner.depth();
+  if (event == JsonStreamScanner::Event::ObjectStart || event == JsonStreamScanner::Event::ArrayStart) {
+    if (depth == 2) {
+      state.section = strcmp(scanner.key(), "current") == 0  ? Section::Current
+                      : strcmp(scanner.key(), "hourly") == 0 ? Section::Hourly
+                                                             : Section::None;
+    } else if (depth == 3 && state.section == Section::Hourly) {
+      state.hourDt = 0;
+      state.haveHourTemp = false;
+    }
+    return;
+  }
+  if (event == JsonStreamScanner::Event::ObjectEnd || event == JsonStreamScanner::Event::ArrayEnd) {
+    if (depth == 3 && state.section == Section::Hourly && state.hourDt != 0 && state.haveHourTemp) {
+      state.payload->forecast.appendHourly(state.hourDt, static_cast<int16_t>(state.hourTempF), WeatherType::Clear,
+                                           0);
+    } else if (depth == 2) {
+      state.section = Section::None;
+    }
+    return;
+  }
+
+  int32_t value = 0;
+  if (state.section == Section::Current && depth == 2) {
+    if (strcmp(scanner.key(), "dt") == 0 && parseScaledInt(scanner.value(), kFixedWhole, value)) {
+      state.payload->dt = static_cast<uint32_t>(value);
+    } else if (strcmp(scanner.key(), "temp") == 0 && parseScaledInt(scanner.value(), kFixedWhole, value)) {
+      state.payload->tempF = static_cast<int16_t>(value);
+      state.haveCurrentTemp = true;
+    }
+  } else if (state.section == Section::Hourly && depth == 3) {
+    if (strcmp(scanner.key(), "dt") == 0 && parseScaledInt(scanner.value(), kFixedWhole, value)) {
+      state.hourDt = static_cast<uint32_t>(value);
+    } else if (strcmp(scanner.key(), "temp") == 0 && parseScaledInt(scanner.value(), kFixedWhole, state.hourTempF)) {
+      state.haveHourTemp = true;
+    }
+  }
+}
+
+// Parse current.dt/current.temp and the hourly temperatures the way the firmware rounds them.
+bool loadPayload(const char* path, Payload& payload) {
+  FILE* file = fopen(path, "rb");
+  if (file == nullptr) {
+    return false;
+  }
+  memset(&payload, 0, sizeof(payload));
+  ParseState state = {&payload, Section::None, false, 0, 0, false};
+  JsonStreamScanner scanner(onToken, &state);
+  char buffer[1024];
+  size_t read = 0;
+  while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+    scanner.feed(buffer, read);
+  }
+  fclose(file);
+  return !scanner.failed() && payload.dt != 0 && state.haveCurrentTemp;
+}
+
+struct Score {
+  uint32_t samples;
+  uint32_t sumAbs;
+  uint32_t sumSquares;
+  uint32_t maxAbs;
+  uint32_t wins;
+  uint32_t losses;
+
+  void add(int32_t error, int32_t heldError) {
+    const uint32_t absError = static_cast<uint32_t>(abs(error));
+    ++samples;
+    sumAbs += absError;
+    sumSquares += absError * absError;
+    maxAbs = absError > maxAbs ? absError : maxAbs;
+    wins += abs(error) < abs(heldError) ? 1 : 0;
+    losses += abs(error) > abs(heldError) ? 1 : 0;
+  }
+
+  double mean() const {
+    return samples ? static_cast<double>(sumAbs) / samples : 0.0;
+  }
+
+  double rms() const {
+    return samples ? sqrt(static_cast<double>(sumSquares) / samples) : 0.0;
+  }
+};
+
+void printRow(const char* label, const Score& interp, const Score& held) {
+  printf("  %-12s %6u  %5.2f %5.2f %3u   %5.2f %5.2f %3u   %3u/%-3u\n", label, interp.samples, interp.mean(),
+         interp.rms(), interp.maxAbs, held.mean(), held.rms(), held.maxAbs, interp.wins, interp.losses);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  uint32_t every = 1;
+  int first = 1;
+  if (argc > 2 && strcmp(argv[1], "--every") == 0) {
+    every = static_cast<uint32_t>(atoi(argv[2]));
+    first = 3;
+  }
+  if (first >= argc || every == 0) {
+    fprintf(stderr, "usage: %s [--every N] payload.json...\n", argv[0]);
+    return 2;
+  }
+
+  std::vector<Payload> payloads;
+  for (int i = first; i < argc; ++i) {
+    Payload payload;
+    if (loadPayload(argv[i], payload)) {
+      payloads.push_back(payload);
+    } else {
+      fprintf(stderr, "skipped %s: no current.dt/temp\n", argv[i]);
+    }
+  }
+  std::sort(payloads.begin(), payloads.end(),
+            [](const Payload& a, const Payload& b) { return a.dt < b.dt; });
+  if (payloads.size() < 2) {
+    fprintf(stderr, "need at least two payloads\n");
+    return 2;
+  }
+
+  TemperatureInterpolator interpolator;
+  WeatherData synced{};
+  uint32_t syncEpoch = 0;
+  Score interpTotal = {};
+  Score heldTotal = {};
+  Score interpByAge[kAgeBuckets] = {};
+  Score heldByAge[kAgeBuckets] = {};
+  for (size_t i = 0; i < payloads.size(); ++i) {
+    const Payload& p = payloads[i];
+    const uint32_t age = p.dt - syncEpoch;
+    if (i > 0 && age > 0 && age <= kMaxScoredAgeSec) {
+      interpolator.update(p.dt);
+      const int32_t shown = interpolator.active() ? interpolator.temperatureF() : synced.temperatureF;
+      const int32_t error = shown - p.tempF;
+      const int32_t heldError = synced.temperatureF - p.tempF;
+      interpTotal.add(error, heldError);
+      heldTotal.add(heldError, error);
+      size_t bucket = 0;
+      while (bucket + 1 < kAgeBuckets && age > kAgeBucketEndMin[bucket] * 60) {
+        ++bucket;
+      }
+      interpByAge[bucket].add(error, heldError);
+      heldByAge[bucket].add(heldError, error);
+    }
+    if (i % every == 0) {
+      synced.temperatureF = p.tempF;
+      synced.forecast = p.forecast;
+      interpolator.observe(synced, p.dt);
+      syncEpoch = p.dt;
+    }
+    DeferredLog::drainToSerial(255);
+  }
+
+  const uint32_t spanMin = (payloads.back().dt - payloads.front().dt) / 60;
+  printf("%u payloads over %u h %02u min, sync on every %u (errors in whole deg F)\n",
+         static_cast<unsigned>(payloads.size()), spanMin / 60, spanMin % 60, every);
+  printf("  %-12s %6s    %-15s   %s\n", "", "", "interpolated", "held");
+  printf("  %-12s %6s  %5s %5s %3s   %5s %5s %3s   %s\n", "since sync", "n", "mean", "rms", "max", "mean", "rms", "max",
+         "better/worse");
+  uint32_t startMin = 0;
+  for (size_t b = 0; b < kAgeBuckets; ++b) {
+    char label[16];
+    snprintf(label, sizeof(label), "%u-%u min", startMin, kAgeBucketEndMin[b]);
+    printRow(label, interpByAge[b], heldByAge[b]);
+    startMin = kAgeBucketEndMin[b];
+  }
+  printRow("all", interpTotal, heldTotal);
+  return 0;
+}
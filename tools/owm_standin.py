@@ -0,0 +1,172 @@
+#!/usr/bin/env python3
+"""Stand in for the OpenWeather API and inject failures, to watch the clock's retry policy.
+
+Usage:
+  owm_standin.py [port] [script]
+
+Serves the geocode and OneCall endpoints the firmware uses over HTTPS on the
+given port (default 8443) with a generated self-signed certificate; the
+firmware does not verify certificates. Build the clock against it with
+
+  -D OWM_API_BASE_URL=\\"https://<host-ip>:8443\\"
+
+`script` is a comma-separated list of outcomes applied to successive requests
+and repeated once exhausted (default "ok"):
+
+  ok            200 with a synthetic payload
+  <code>[:s]    that HTTP status (e.g. 429, 500, 503), with Retry-After: s if given
+  drop          close the connection without a response
+  stall[:s]     accept, then send nothing for s seconds (default 30) and close
+
+Example: "503:20,503,drop,ok" answers the first request with 503 and
+Retry-After: 20, then a bare 503, then drops one connection, then succeeds.
+Each request is printed with its outcome and the gap since the previous one,
+so backoff, jitter, Retry-After and the circuit breaker cooldown can be read
+straight off the log next to the device's [RETRY] lines.
+"""
+
+import json
+import os
+import socket
+import ssl
+import subprocess
+import sys
+import tempfile
+import time
+import urllib.parse
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+LAT = 40.7128
+LON = -74.0060
+OFFSET = -14400
+
+
+def parse_script(text):
+    steps = []
+    for item in text.split(","):
+        name, _, arg = item.strip().partition(":")
+        if name == "ok" or name == "drop":
+            steps.append((name, None))
+        elif name == "stall":
+            steps.append((name, int(arg) if arg else 30))
+        elif name.isdigit():
+            steps.append((int(name), int(arg) if arg else None))
+        else:
+            raise SystemExit("unknown script step: %s" % item)
+    return steps
+
+
+def weather(code, main):
+    return [{"id": code, "main": main, "description": main.lower(), "icon": "01d"}]
+
+
+def onecall(exclude):
+    now = int(time.time())
+    hour = now - now % 3600
+    day = now - now % 86400 + 43200
+    body = {"lat": LAT, "lon": LON, "timezone": "America/New_York", "timezone_offset": OFFSET}
+    if "current" not in exclude:
+        body["current"] = {
+            "dt": now, "sunrise": day - 21600, "sunset": day + 21600, "temp": 71.6, "feels_like": 70.9,
+            "wind_speed": 8.05, "wind_deg": 230, "wind_gust": 14.97, "weather": weather(500, "Rain")}
+    if "minutely" not in exclude:
+        body["minutely"] = [{"dt": now - now % 60 + 60 * i, "precipitation": 0.25 * (i % 8)} for i in range(61)]
+    if "hourly" not in exclude:
+        body["hourly"] = [{"dt": hour + 3600 * i, "temp": 70.0 + (i % 12) - 6, "feels_like": 69.0,
+                           "wind_speed": 7.0, "wind_gust": 12.0, "pop": 0.35,
+                           "weather": weather(803 if i % 3 else 500, "Clouds" if i % 3 else "Rain")}
+                          for i in range(48)]
+    if "daily" not in exclude:
+        body["daily"] = [{"dt": day + 86400 * i, "sunrise": day + 86400 * i - 21600,
+                          "sunset": day + 86400 * i + 21600,
+                          "temp": {"day": 74.0 + i, "min": 58.3 + i, "max": 77.5 + i, "night": 60.0},
+                          "pop": 0.2, "weather": weather(800, "Clear")} for i in range(8)]
+    if "alerts" not in exclude:
+        body["alerts"] = [{"sender_name": "NWS", "event": "Wind Advisory", "start": now - 3600,
+                           "end": now + 6 * 3600, "description": "Stand-in alert.", "tags": ["Wind"]}]
+    return body
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"
+
+    def do_GET(self):
+        server = self.server
+        step = server.steps[server.count % len(server.steps)]
+        server.count += 1
+        now = time.time()
+        gap = "-" if server.last is None else "%.1fs" % (now - server.last)
+        server.last = now
+        url = urllib.parse.urlparse(self.path)
+        query = urllib.parse.parse_qs(url.query)
+        kind, arg = step
+        label = kind if arg is None else "%s:%s" % (kind, arg)
+        print("%s #%d gap=%s %s exclude=%s -> %s" % (
+            time.strftime("%H:%M:%S"), server.count, gap, url.path,
+            query.get("exclude", [""])[0], label), flush=True)
+
+        if kind == "drop":
+            self.close_connection = True
+            self.connection.shutdown(socket.SHUT_RDWR)
+            return
+        if kind == "stall":
+            time.sleep(arg)
+            self.close_connection = True
+            return
+        if kind != "ok":
+            self.send_response(kind)
+            if arg is not None:
+                self.send_header("Retry-After", str(arg))
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            return
+
+        if url.path == "/geo/1.0/zip":
+            zip_code = query.get("zip", ["10001,US"])[0]
+            body = {"zip": zip_code.split(",")[0], "name": "Stand-in", "lat": LAT, "lon": LON, "country": "US"}
+        elif url.path == "/data/3.0/onecall":
+            body = onecall(query.get("exclude", [""])[0].split(","))
+        else:
+            self.send_response(404)
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            return
+        data = json.dumps(body, separators=(",", ":")).encode()
+        self.send_response(200)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(data)))
+        self.end_headers()
+        self.wfile.write(data)
+
+    def log_message(self, fmt, *args):
+        pass
+
+
+def self_signed_context():
+    folder = tempfile.mkdtemp(prefix="owm_standin_")
+    cert = os.path.join(folder, "cert.pem")
+    key = os.path.join(folder, "key.pem")
+    subprocess.run(["openssl", "req", "-x509", "-newkey", "rsa:2048", "-nodes", "-days", "30",
+                    "-subj", "/CN=owm-standin", "-keyout", key, "-out", cert],
+                   check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+    context = ssl.SSLContext(ssl.PROTOCOL_TLS_SERVER)
+    context.load_cert_chain(cert, key)
+    return context
+
+
+def main():
+    if len(sys.argv) > 3 or (len(sys.argv) > 1 and sys.argv[1] in ("-h", "--help")):
+        raise SystemExit(__doc__)
+    port = int(sys.argv[1]) if len(sys.argv) > 1 else 8443
+    server = ThreadingHTTPServer(("", port), Handler)
+    server.steps = parse_script(sys.argv[2] if len(sys.argv) > 2 else "ok")
+    server.count = 0
+    server.last = None
+    server.socket = self_signed_context().wrap_socket(server.socket, server_side=True)
+    print("serving https://0.0.0.0:%d script=%s" % (port, ",".join(
+        str(k) if a is None else "%s:%s" % (k, a) for k, a in server.steps)), flush=True)
+    server.serve_forever()
+
+
+if __name__ == "__main__":
+    main()
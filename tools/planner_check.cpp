@@ -0,0 +1,235 @@
+// Drive src/SyncPlanner.cpp in simulated time and check its schedule: the
+// per-device offset grid, the cadence chosen for volatile/normal/stable
+// weather, interval stretching under a tight quota, quota exhaustion with a
+// wait for the UTC day reset, and spare-budget checks for extra requests.
+//
+// Build and run from the repository root:
+//   g++ -std=c++11 -O2 -Isrc -Itools/host -o planner_check tools/planner_check.cpp
+//       src/SyncPlanner.cpp src/DeferredLog.cpp
+//   ./planner_check 2>/dev/null
+//
+// The planner's own [PLAN] records are drained to stderr; drop the redirect to see them.
+// Exits non-zero if any check fails.
+
+#include <stdio.h>
+#include <string.h>
+#include "DeferredLog.h"
+#include "SyncPlanner.h"
+
+namespace {
+const uint32_t kDay = 86400UL;
+const uint32_t kStartEpoch = 20454UL * kDay;  // 2026-01-01 00:00 UTC
+const SyncPlanner::Config kConfig = {200, 3600, 1800, 7200};
+
+int failures = 0;
+
+void check(bool ok, const char* what) {
+  DeferredLog::drainToSerial(255);
+  printf("  %-4s %s\n", ok ? "ok" : "FAIL", what);
+  if (!ok) {
+    ++failures;
+  }
+}
+
+WeatherData makeWeather(WeatherType type, uint8_t rainPct, const char* advisory) {
+  WeatherData weather{};
+  weather.valid = true;
+  weather.type = type;
+  weather.rainChancePct = rainPct;
+  for (int i = 0; i < 4; ++i) {
+    weather.hourlyType[i] = type;
+  }
+  strncpy(weather.advisory, advisory, sizeof(weather.advisory) - 1);
+  return weather;
+}
+
+WeatherData stable() {
+  return makeWeather(WeatherType::Clear, 0, "NO ADVISORIES");
+}
+
+WeatherData normal() {
+  WeatherData weather = makeWeather(WeatherType::Clear, 20, "NO ADVISORIES");
+  weather.hourlyType[2] = WeatherType::Cloudy;
+  return weather;
+}
+
+WeatherData rainy() {
+  return makeWeather(WeatherType::Rain, 80, "NO ADVISORIES");
+}
+
+WeatherData advisory() {
+  return makeWeather(WeatherType::Clear, 0, "WIND ADVISORY");
+}
+
+struct DayRun {
+  uint32_t syncs;
+  uint32_t calls;
+  uint32_t lastSyncSecondOfDay;
+  bool onGrid;
+};
+
+// Follow the planner for one UTC day from the first planned slot, spending callsPerSync each time.
+DayRun runDay(SyncPlanner& planner, const WeatherData& weather, uint16_t callsPerSync, uint32_t day) {
+  DayRun run = {0, 0, 0, true};
+  planner.recordSync(day * kDay, callsPerSync, weather);
+  run.calls += callsPerSync;
+  ++run.syncs;
+  while (planner.nextSyncEpoch() < (day + 1) * kDay) {
+    const uint32_t now = planner.nextSyncEpoch();
+    if (!planner.isDue(now) || planner.isDue(now - 1)) {
+      run.onGrid = false;
+    }
+    planner.recordSync(now, callsPerSync, weather);
+    DeferredLog::drainToSerial(255);
+    run.calls += callsPerSync;
+    ++run.syncs;
+    run.lastSyncSecondOfDay = now % kDay;
+  }
+  return run;
+}
+
+void checkCadence() {
+  printf("cadence by forecast volatility\n");
+  SyncPlanner planner(kConfig);
+  planner.setDeviceSeed(0x1234);
+  planner.recordSync(kStartEpoch, 2, stable());
+  check(planner.currentIntervalSec() == kConfig.stableIntervalSec, "stable weather uses the stable interval");
+  planner.recordSync(kStartEpoch, 2, normal());
+  check(planner.currentIntervalSec() == kConfig.baseIntervalSec, "mixed weather uses the base interval");
+  planner.recordSync(kStartEpoch, 2, rainy());
+  check(planner.currentIntervalSec() == kConfig.volatileIntervalSec, "rain ahead uses the volatile interval");
+  planner.recordSync(kStartEpoch, 2, advisory());
+  check(planner.currentIntervalSec() == kConfig.volatileIntervalSec, "an advisory uses the volatile interval");
+  WeatherData invalid{};
+  planner.recordSync(kStartEpoch, 2, invalid);
+  check(planner.currentIntervalSec() == kConfig.baseIntervalSec, "no data yet uses the base interval");
+}
+
+void checkOffsetGrid() {
+  printf("MAC-derived offset grid\n");
+  // A fleet of 64 adjacent suffixes on the hourly interval: every slot should be distinct and spread out.
+  const uint32_t kFleet = 64;
+  uint32_t offsets[kFleet];
+  bool allOnGrid = true;
+  for (uint32_t i = 0; i < kFleet; ++i) {
+    SyncPlanner planner(kConfig);
+    planner.setDeviceSeed(static_cast<uint16_t>(0xA000 + i));
+    planner.recordSync(kStartEpoch + 600, 2, normal());
+    offsets[i] = planner.nextSyncEpoch() % kConfig.baseIntervalSec;
+    const DayRun run = runDay(planner, normal(), 2, 20455);
+    allOnGrid = allOnGrid && run.onGrid;
+    // Every later slot keeps the same offset within the hour.
+    allOnGrid = allOnGrid && planner.nextSyncEpoch() % kConfig.baseIntervalSec == offsets[i];
+  }
+  uint32_t buckets[6] = {0, 0, 0, 0, 0, 0};
+  uint32_t duplicates = 0;
+  for (uint32_t i = 0; i < kFleet; ++i) {
+    ++buckets[offsets[i] / 600];
+    for (uint32_t j = i + 1; j < kFleet; ++j) {
+      duplicates += offsets[i] == offsets[j] ? 1 : 0;
+    }
+  }
+  uint32_t fullest = 0;
+  for (uint32_t b = 0; b < 6; ++b) {
+    fullest = buckets[b] > fullest ? buckets[b] : fullest;
+  }
+  printf("  64 devices per 10 min of the hour: %u %u %u %u %u %u\n", buckets[0], buckets[1], buckets[2],
+         buckets[3], buckets[4], buckets[5]);
+  check(allOnGrid, "each device stays on its own {k * interval + offset} grid all day");
+  check(duplicates == 0, "no two adjacent suffixes share a slot");
+  check(fullest <= kFleet / 6 * 2, "no 10 min window gets more than twice its share");
+}
+
+void checkDayWithinQuota() {
+  printf("simulated days against the 200-call quota\n");
+  const struct {
+    const char* name;
+    WeatherData weather;
+    uint32_t expectedSyncs;
+  } kCases[] = {{"stable", stable(), 12}, {"normal", normal(), 24}, {"volatile", rainy(), 48}};
+  for (const auto& c : kCases) {
+    SyncPlanner planner(kConfig);
+    planner.setDeviceSeed(0xBEEF);
+    const DayRun run = runDay(planner, c.weather, 2, 20455);
+    char what[96];
+    snprintf(what, sizeof(what), "%s day: %u syncs, %u calls (expect ~%u syncs, <= 200 calls)", c.name, run.syncs,
+             run.calls, c.expectedSyncs);
+    check(run.calls <= kConfig.dailyCallQuota && run.syncs + 1 >= c.expectedSyncs &&
+              run.syncs <= c.expectedSyncs + 1,
+          what);
+  }
+}
+
+void checkStretching() {
+  printf("interval stretching under a tight quota\n");
+  // Volatile weather wants 48 syncs; 3 calls each against a 60-call quota allows only 20.
+  SyncPlanner::Config tight = kConfig;
+  tight.dailyCallQuota = 60;
+  SyncPlanner planner(tight);
+  planner.setDeviceSeed(0x0042);
+  const DayRun run = runDay(planner, rainy(), 3, 20455);
+  char what[96];
+  snprintf(what, sizeof(what), "%u syncs, %u calls, last sync at %02u:%02u UTC", run.syncs, run.calls,
+           run.lastSyncSecondOfDay / 3600, run.lastSyncSecondOfDay % 3600 / 60);
+  check(run.calls <= tight.dailyCallQuota, what);
+  check(run.lastSyncSecondOfDay >= 18UL * 3600UL, "the stretched schedule still reaches the evening");
+  check(planner.currentIntervalSec() > tight.volatileIntervalSec, "the interval grew past the volatile cadence");
+}
+
+void checkExhaustion() {
+  printf("quota exhaustion and the UTC day reset\n");
+  SyncPlanner::Config tiny = kConfig;
+  tiny.dailyCallQuota = 10;
+  SyncPlanner planner(tiny);
+  planner.setDeviceSeed(0x0007);
+  // Retries and a config save burn the budget by 10:00.
+  const uint32_t morning = 20455UL * kDay + 10UL * 3600UL;
+  planner.recordSync(morning, 10, rainy());
+  const uint32_t next = planner.nextSyncEpoch();
+  check(planner.callsToday() == 10, "all 10 calls are charged to the day");
+  check(next >= 20456UL * kDay && next < 20456UL * kDay + tiny.baseIntervalSec,
+        "the next sync waits for the quota reset, within the first interval of the new day");
+  check(!planner.isDue(20456UL * kDay - 1), "nothing is due before midnight UTC");
+  planner.recordSync(next, 2, rainy());
+  check(planner.callsToday() == 2, "the new day starts a fresh count");
+}
+
+void checkExtraCalls() {
+  printf("spare budget for requests outside planned syncs\n");
+  SyncPlanner planner(kConfig);
+  planner.setDeviceSeed(0x5150);
+  const uint32_t noon = 20455UL * kDay + 12UL * 3600UL;
+  planner.recordSync(noon - 3600, 2, rainy());
+  // 12 h left at a 30 min cadence reserves 24 syncs * 2 calls; 2 calls spent, so 150 are spare.
+  uint32_t extras = 0;
+  while (planner.allowExtraCall(noon, 1) && extras < 500) {
+    planner.recordExtraCalls(noon, 1);
+    ++extras;
+  }
+  char what[96];
+  snprintf(what, sizeof(what), "%u extra calls allowed at noon, %u charged today", extras, planner.callsToday());
+  check(extras > 100 && planner.callsToday() + 24 * 2 <= kConfig.dailyCallQuota, what);
+  check(planner.callsPerSync() == 2, "extra calls leave the calls-per-sync estimate alone");
+  planner.recordSync(noon + 600, 2, rainy());
+  check(planner.currentIntervalSec() >= kConfig.volatileIntervalSec,
+        "the planned syncs keep their reserved share after the extras");
+  check(planner.allowExtraCall(noon + kDay, 1), "a new UTC day frees the spare budget again");
+
+  SyncPlanner::Config tight = kConfig;
+  tight.dailyCallQuota = 60;
+  SyncPlanner stretched(tight);
+  stretched.recordSync(noon, 3, rainy());
+  check(!stretched.allowExtraCall(noon + 60, 1), "a stretched schedule has no spare calls");
+}
+}  // namespace
+
+int main() {
+  checkCadence();
+  checkOffsetGrid();
+  checkDayWithinQuota();
+  checkStretching();
+  checkExhaustion();
+  checkExtraCalls();
+  printf("%s: %d failed\n", failures == 0 ? "PASS" : "FAIL", failures);
+  return failures == 0 ? 0 : 1;
+}
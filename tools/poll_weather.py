@@ -0,0 +1,83 @@
+#!/usr/bin/env python3
+"""Poll a WeatherClock's /weather.json like a dashboard and report the cost to its loop.
+
+Usage:
+  poll_weather.py http://<device-ip> [rate_per_s] [seconds]
+
+Sends conditional GETs (If-None-Match with the last ETag) at the given rate
+(default 10/s for 60 s). Before and after, it reads the loop-duration
+histogram from /metrics and prints the per-bucket delta next to an idle
+window of the same length, so any render-timing shift under load is visible.
+"""
+
+import re
+import sys
+import time
+import urllib.error
+import urllib.request
+
+BUCKET = re.compile(r'^weatherclock_loop_duration_us_bucket\{le="([^"]+)"\} (\d+)$', re.M)
+
+
+def loop_buckets(base):
+    text = urllib.request.urlopen(base + "/metrics", timeout=10).read().decode()
+    return [(le, int(count)) for le, count in BUCKET.findall(text)]
+
+
+def delta(before, after):
+    # Histogram buckets are cumulative; convert to per-bucket counts.
+    counts = [a[1] - b[1] for a, b in zip(after, before)]
+    return [(after[i][0], counts[i] - (counts[i - 1] if i else 0)) for i in range(len(counts))]
+
+
+def show(title, rows):
+    total = sum(count for _, count in rows) or 1
+    print(title)
+    for le, count in rows:
+        print("  le=%-8s %8d  %5.1f%%" % (le, count, 100.0 * count / total))
+
+
+def poll(base, rate, seconds):
+    etag = None
+    stats = {200: 0, 304: 0, "error": 0}
+    interval = 1.0 / rate
+    deadline = time.time() + seconds
+    next_at = time.time()
+    while time.time() < deadline:
+        request = urllib.request.Request(base + "/weather.json")
+        if etag:
+            request.add_header("If-None-Match", etag)
+        try:
+            with urllib.request.urlopen(request, timeout=5) as response:
+                response.read()
+                etag = response.headers.get("ETag", etag)
+                stats[200] += 1
+        except urllib.error.HTTPError as e:
+            stats[304 if e.code == 304 else "error"] += 1
+        except OSError:
+            stats["error"] += 1
+        next_at += interval
+        time.sleep(max(0.0, next_at - time.time()))
+    return stats
+
+
+def main():
+    if len(sys.argv) < 2:
+        raise SystemExit(__doc__)
+    base = sys.argv[1].rstrip("/")
+    rate = float(sys.argv[2]) if len(sys.argv) > 2 else 10.0
+    seconds = float(sys.argv[3]) if len(sys.argv) > 3 else 60.0
+
+    start = loop_buckets(base)
+    time.sleep(seconds)
+    idle = loop_buckets(base)
+    stats = poll(base, rate, seconds)
+    loaded = loop_buckets(base)
+
+    print("requests: 200=%d 304=%d errors=%d" % (stats[200], stats[304], stats["error"]))
+    show("loop duration, idle %.0f s:" % seconds, delta(start, idle))
+    show("loop duration, %.0f req/s for %.0f s:" % (rate, seconds), delta(idle, loaded))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,127 @@
+#!/usr/bin/env python3
+"""Listen to, probe, or stand in for the WeatherClock LAN relay (UDP multicast).
+
+Usage:
+  relay_tool.py listen                      print every relay packet seen
+  relay_tool.py request [seconds]           send a follower request, print replies
+  relay_tool.py lead SNAPSHOT [interval_s]  act as leader, relaying a /weather.bin snapshot
+
+`lead` answers follower requests at once and repeats its packet every interval
+(default 300 s, the firmware heartbeat); each run uses a new session id. Both
+ends enable multicast loopback, so two instances on one Linux host (for
+example `lead` in one shell and `request` in another) exercise the protocol
+without any hardware.
+"""
+
+import os
+import select
+import socket
+import struct
+import sys
+import time
+import zlib
+
+GROUP = "239.255.77.67"
+PORT = 47767
+DATA_MAGIC = b"WCR1"
+REQUEST_MAGIC = b"WCRQ"
+PACKET_VERSION = 1
+# magic, packet version, codec version, payload length, session, generation, sent-at, utc offset
+HEADER = struct.Struct("<4sBBHIIIi")
+CRC = struct.Struct("<I")
+HEADER_SIZE = HEADER.size + CRC.size
+# /weather.bin: magic, format, codec, payload length, crc, then utc offset and payload.
+SNAPSHOT = struct.Struct("<4sBBHIi")
+
+
+def open_socket():
+    sock = socket.socket(socket.AF_INET, socket.SOCK_DGRAM, socket.IPPROTO_UDP)
+    sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+    if hasattr(socket, "SO_REUSEPORT"):
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEPORT, 1)
+    sock.bind(("", PORT))
+    membership = struct.pack("4s4s", socket.inet_aton(GROUP), socket.inet_aton("0.0.0.0"))
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP, membership)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_LOOP, 1)
+    sock.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 1)
+    return sock
+
+
+def build_packet(session, generation, offset, codec, payload):
+    header = HEADER.pack(DATA_MAGIC, PACKET_VERSION, codec, len(payload), session, generation,
+                         int(time.time()), offset)
+    crc = zlib.crc32(payload, zlib.crc32(header)) & 0xFFFFFFFF
+    return header + CRC.pack(crc) + payload
+
+
+def describe(data, sender):
+    if len(data) == 8 and data[:4] == REQUEST_MAGIC:
+        (session,) = struct.unpack_from("<I", data, 4)
+        return "request from %s session=%08X" % (sender, session)
+    if len(data) < HEADER_SIZE or data[:4] != DATA_MAGIC:
+        return "unknown %d-byte packet from %s" % (len(data), sender)
+    magic, version, codec, length, session, generation, sent_at, offset = HEADER.unpack_from(data, 0)
+    (stored_crc,) = CRC.unpack_from(data, HEADER.size)
+    payload = data[HEADER_SIZE:]
+    crc = zlib.crc32(payload, zlib.crc32(data[:HEADER.size])) & 0xFFFFFFFF
+    status = "ok" if crc == stored_crc and length == len(payload) else "BAD"
+    age = int(time.time()) - sent_at if sent_at else None
+    return ("data from %s session=%08X generation=%d codec=v%d payload=%d offset=%d age=%s crc=%s"
+            % (sender, session, generation, codec, length, offset,
+               "?" if age is None else "%ds" % age, status))
+
+
+def listen(sock, seconds=None):
+    deadline = None if seconds is None else time.time() + seconds
+    while deadline is None or time.time() < deadline:
+        timeout = None if deadline is None else max(0.0, deadline - time.time())
+        ready, _, _ = select.select([sock], [], [], timeout)
+        if ready:
+            data, (host, port) = sock.recvfrom(2048)
+            print("%.3f %s" % (time.time(), describe(data, "%s:%d" % (host, port))), flush=True)
+
+
+def request(sock, seconds):
+    session = struct.unpack("<I", os.urandom(4))[0]
+    sock.sendto(REQUEST_MAGIC + struct.pack("<I", session), (GROUP, PORT))
+    listen(sock, seconds)
+
+
+def lead(sock, snapshot_path, interval):
+    with open(snapshot_path, "rb") as f:
+        record = f.read()
+    magic, _fmt, codec, length, _crc, offset = SNAPSHOT.unpack_from(record, 0)
+    if magic != b"WCS1" or len(record) != SNAPSHOT.size + length:
+        raise SystemExit("not a WeatherClock snapshot: %s" % snapshot_path)
+    payload = record[SNAPSHOT.size:]
+    session = struct.unpack("<I", os.urandom(4))[0]
+    packet = build_packet(session, 1, offset, codec, payload)
+    print("leading session=%08X codec=v%d payload=%d" % (session, codec, len(payload)), flush=True)
+    next_send = 0.0
+    while True:
+        if time.time() >= next_send:
+            sock.sendto(packet, (GROUP, PORT))
+            next_send = time.time() + interval
+        ready, _, _ = select.select([sock], [], [], max(0.0, next_send - time.time()))
+        if ready:
+            data, _ = sock.recvfrom(2048)
+            if len(data) == 8 and data[:4] == REQUEST_MAGIC:
+                next_send = 0.0
+
+
+def main():
+    if len(sys.argv) < 2 or sys.argv[1] not in ("listen", "request", "lead"):
+        raise SystemExit(__doc__)
+    sock = open_socket()
+    if sys.argv[1] == "listen":
+        listen(sock)
+    elif sys.argv[1] == "request":
+        request(sock, float(sys.argv[2]) if len(sys.argv) > 2 else 3.0)
+    else:
+        if len(sys.argv) < 3:
+            raise SystemExit(__doc__)
+        lead(sock, sys.argv[2], float(sys.argv[3]) if len(sys.argv) > 3 else 300.0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,224 @@
+// Check the fixed-point sunrise/sunset in src/SunCalc.cpp against independent
+// references.
+//
+// 1. Every day of 2026-2029 at several latitudes against the NOAA Solar Calculator
+//    algorithm (Meeus-based solar coordinates from the Julian century,
+//    re-evaluated at the event time). This is the method behind NOAA's
+//    published sunrise/sunset tables and shares no approximation with the
+//    fractional-year series the firmware uses, so a wrong coefficient, sign,
+//    day-of-year or offset in SunCalc shows up as a large error.
+// 2. Optionally, rows of published or recorded times from a CSV file:
+//      lat,lon,utc_offset_seconds,YYYY-MM-DD,HH:MM,HH:MM
+//    with local standard-time sunrise and sunset (for example transcribed
+//    from a USNO one-year table, or the sunrise/sunset epochs OpenWeather
+//    returned for that date converted to local time). '#' starts a comment.
+//
+// Build and run from the repository root:
+//   g++ -std=c++11 -O2 -Isrc tools/sun_check.cpp src/SunCalc.cpp -o sun_check
+//   ./sun_check [reference.csv]
+//
+// Exits non-zero if an error exceeds the limit for its latitude band, if the
+// two disagree on whether the sun rises on more than a few days around the
+// polar-day boundaries, or if a CSV row is off by more than kMaxTableErrorMinutes.
+
+#include <math.h>
+#include <stdio.h>
+#include "CivilCalendar.h"
+#include "SunCalc.h"
+
+namespace {
+const double kPi = 3.14159265358979323846;
+const int32_t kFirstDay = 20454;  // 2026-01-01
+const int32_t kDays = 4 * 365 + 1;  // 2026-2029, a whole leap cycle
+// Published tables round to the minute, so allow that on top of the algorithm error.
+const double kMaxTableErrorMinutes = 3.0;
+// Days next to a polar-day/night boundary where the two may disagree on a rise at all.
+const int kMaxPolarMismatches = 4;
+
+struct Location {
+  const char* name;
+  double lat;
+  double lon;
+  int32_t utcOffsetSeconds;
+  double maxErrorMinutes;
+};
+
+const Location kLocations[] = {
+    {"Quito", -0.18, -78.47, -18000, 1.5},
+    {"Singapore", 1.35, 103.82, 28800, 1.5},
+    {"Honolulu", 21.31, -157.86, -36000, 1.5},
+    {"Sydney", -33.87, 151.21, 36000, 1.5},
+    {"New York", 40.71, -74.01, -18000, 1.5},
+    {"London", 51.51, -0.13, 0, 2.0},
+    {"Ushuaia", -54.80, -68.30, -10800, 2.0},
+    {"Reykjavik", 64.15, -21.94, 0, 3.0},
+    {"Fairbanks", 64.84, -147.72, -32400, 3.0},
+    // Near the polar-day boundary the hour angle is steep, so minutes of error come from tiny declination errors.
+    {"Tromso", 69.65, 18.96, 3600, 20.0},
+};
+
+double rad(double deg) {
+  return deg * kPi / 180.0;
+}
+
+double deg(double rad) {
+  return rad * 180.0 / kPi;
+}
+
+// Solar declination (deg) and equation of time (min) at a Julian day, per the NOAA Solar Calculator.
+void solarCoordinates(double julianDay, double& declination, double& equationOfTime) {
+  const double t = (julianDay - 2451545.0) / 36525.0;
+  const double meanLong = fmod(280.46646 + t * (36000.76983 + 0.0003032 * t), 360.0);
+  const double meanAnomaly = 357.52911 + t * (35999.05029 - 0.0001537 * t);
+  const double eccentricity = 0.016708634 - t * (0.000042037 + 0.0000001267 * t);
+  const double m = rad(meanAnomaly);
+  const double center = sin(m) * (1.914602 - t * (0.004817 + 0.000014 * t)) + sin(2 * m) * (0.019993 - 0.000101 * t) +
+                        sin(3 * m) * 0.000289;
+  const double omega = 125.04 - 1934.136 * t;
+  const double apparentLong = meanLong + center - 0.00569 - 0.00478 * sin(rad(omega));
+  const double meanObliquity = 23.0 + (26.0 + (21.448 - t * (46.815 + t * (0.00059 - t * 0.001813))) / 60.0) / 60.0;
+  const double obliquity = meanObliquity + 0.00256 * cos(rad(omega));
+  declination = deg(asin(sin(rad(obliquity)) * sin(rad(apparentLong))));
+
+  const double y = tan(rad(obliquity) / 2) * tan(rad(obliquity) / 2);
+  const double l0 = rad(meanLong);
+  const double e = y * sin(2 * l0) - 2 * eccentricity * sin(m) + 4 * eccentricity * y * sin(m) * cos(2 * l0) -
+                   0.5 * y * y * sin(4 * l0) - 1.25 * eccentricity * eccentricity * sin(2 * m);
+  equationOfTime = 4.0 * deg(e);
+}
+
+// UTC minutes from 00:00 of dayNumber for sunrise (rising) or sunset; false if there is none.
+bool referenceEventUtc(double lat, double lon, int32_t dayNumber, bool rising, double& utcMinutes) {
+  const double midnight = 2440587.5 + dayNumber;
+  utcMinutes = 720.0 - 4.0 * lon;
+  // Re-evaluate the solar coordinates at the previous estimate until it settles.
+  for (int i = 0; i < 3; ++i) {
+    double declination = 0.0;
+    double equationOfTime = 0.0;
+    solarCoordinates(midnight + utcMinutes / 1440.0, declination, equationOfTime);
+    const double cosHa =
+        cos(rad(90.833)) / (cos(rad(lat)) * cos(rad(declination))) - tan(rad(lat)) * tan(rad(declination));
+    if (fabs(cosHa) > 1.0) {
+      return false;
+    }
+    const double ha = deg(acos(cosHa));
+    utcMinutes = 720.0 - 4.0 * (lon + (rising ? ha : -ha)) - equationOfTime;
+  }
+  return true;
+}
+
+double toLocalMinute(double utcMinutes, int32_t utcOffsetSeconds) {
+  const double local = fmod(utcMinutes + utcOffsetSeconds / 60.0, 1440.0);
+  return local < 0 ? local + 1440.0 : local;
+}
+
+// Distance between two minute-of-day values, wrapping at midnight.
+double minuteError(double a, double b) {
+  const double diff = fabs(a - b);
+  return diff > 720.0 ? 1440.0 - diff : diff;
+}
+
+bool fixedSunTimes(double lat, double lon, int32_t day, int32_t utcOffsetSeconds, SunTimes& out) {
+  return computeSunTimes(static_cast<int32_t>(lround(lat * 1e6)), static_cast<int32_t>(lround(lon * 1e6)), day,
+                         utcOffsetSeconds, out);
+}
+
+bool checkYear() {
+  bool ok = true;
+  printf("%d-%d against the NOAA Solar Calculator algorithm\n", static_cast<int>(civilFromDays(kFirstDay).year),
+         static_cast<int>(civilFromDays(kFirstDay + kDays - 1).year));
+  for (const Location& loc : kLocations) {
+    double worst = 0.0;
+    double sum = 0.0;
+    int scored = 0;
+    int polarDays = 0;
+    int mismatches = 0;
+    for (int32_t day = kFirstDay; day < kFirstDay + kDays; ++day) {
+      SunTimes fixed{};
+      const bool fixedValid = fixedSunTimes(loc.lat, loc.lon, day, loc.utcOffsetSeconds, fixed);
+      double sunriseUtc = 0.0;
+      double sunsetUtc = 0.0;
+      const bool refValid = referenceEventUtc(loc.lat, loc.lon, day, true, sunriseUtc) &&
+                            referenceEventUtc(loc.lat, loc.lon, day, false, sunsetUtc);
+      if (fixedValid != refValid) {
+        ++mismatches;
+        continue;
+      }
+      if (!refValid) {
+        ++polarDays;
+        continue;
+      }
+      const double riseErr = minuteError(fixed.sunriseMinute, toLocalMinute(sunriseUtc, loc.utcOffsetSeconds));
+      const double setErr = minuteError(fixed.sunsetMinute, toLocalMinute(sunsetUtc, loc.utcOffsetSeconds));
+      worst = fmax(worst, fmax(riseErr, setErr));
+      sum += riseErr + setErr;
+      scored += 2;
+    }
+    const bool locOk = worst <= loc.maxErrorMinutes && mismatches <= kMaxPolarMismatches;
+    ok = ok && locOk;
+    printf("  %-4s %-10s %6.2f lat  mean %.2f  max %5.2f min (limit %4.1f)  polar days %3d  mismatched %d\n",
+           locOk ? "ok" : "FAIL", loc.name, loc.lat, scored ? sum / scored : 0.0, worst, loc.maxErrorMinutes,
+           polarDays, mismatches);
+  }
+  return ok;
+}
+
+bool checkTable(const char* path) {
+  FILE* file = fopen(path, "r");
+  if (file == nullptr) {
+    printf("cannot open %s\n", path);
+    return false;
+  }
+  printf("reference table %s\n", path);
+  bool ok = true;
+  int rows = 0;
+  double worst = 0.0;
+  char line[160];
+  while (fgets(line, sizeof(line), file) != nullptr) {
+    double lat = 0.0;
+    double lon = 0.0;
+    int offset = 0;
+    int year = 0;
+    int month = 0;
+    int dayOfMonth = 0;
+    int riseH = 0;
+    int riseM = 0;
+    int setH = 0;
+    int setM = 0;
+    if (line[0] == '#' || sscanf(line, "%lf,%lf,%d,%d-%d-%d,%d:%d,%d:%d", &lat, &lon, &offset, &year, &month,
+                                 &dayOfMonth, &riseH, &riseM, &setH, &setM) != 10) {
+      continue;
+    }
+    const int32_t day = daysFromCivil(year, static_cast<uint8_t>(month), static_cast<uint8_t>(dayOfMonth));
+    SunTimes fixed{};
+    ++rows;
+    if (!fixedSunTimes(lat, lon, day, offset, fixed)) {
+      printf("  FAIL %04d-%02d-%02d %.2f,%.2f: no rise/set computed\n", year, month, dayOfMonth, lat, lon);
+      ok = false;
+      continue;
+    }
+    const double err = fmax(minuteError(fixed.sunriseMinute, riseH * 60 + riseM),
+                            minuteError(fixed.sunsetMinute, setH * 60 + setM));
+    worst = fmax(worst, err);
+    if (err > kMaxTableErrorMinutes) {
+      printf("  FAIL %04d-%02d-%02d %.2f,%.2f: table %02d:%02d/%02d:%02d computed %02u:%02u/%02u:%02u\n", year, month,
+             dayOfMonth, lat, lon, riseH, riseM, setH, setM, fixed.sunriseMinute / 60, fixed.sunriseMinute % 60,
+             fixed.sunsetMinute / 60, fixed.sunsetMinute % 60);
+      ok = false;
+    }
+  }
+  fclose(file);
+  printf("  %-4s %d rows, max %.0f min (limit %.0f)\n", ok && rows > 0 ? "ok" : "FAIL", rows, worst,
+         kMaxTableErrorMinutes);
+  return ok && rows > 0;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+  bool ok = checkYear();
+  if (argc > 1) {
+    ok = checkTable(argv[1]) && ok;
+  }
+  printf("%s\n", ok ? "PASS" : "FAIL");
+  return ok ? 0 : 1;
+}